@@ -14,11 +14,18 @@ int main(int argc, char* args[]) {
 	//e.g. appCore->attachElement("Render");
 	// ---
 	// ---
-	//Initialize any Element(s) by calling the Element's initialize function and passing any required parameters
-	//e.g. appCore->getRenderElement()->initialize(...)
+	//Optionally load any plugin(s), which register (and usually attach) custom Element(s)
+	//e.g. appCore->loadPlugin("MyPlugin.dll");
 	// ---
-	// MAKE SURE ELEMENTS ATTACHED FIRST THEN INITIALIZED, ONE BY ONE
-	// ESPECIALLY IMPORTANT IF LOG ELEMENT NOT INITIALIZED BEFORE ATTACHING OTHER ELEMENTS!
+	// ---
+	//Configure any Element(s) that shouldn't be initialized with default parameters, passing the Element's initialize parameters
+	//e.g. appCore->configureElement<CoreRenderElement::RenderElement>(std::string("My Game"), 1280.0f, 720.0f, windowFlags, 1);
+	// ---
+	// ---
+	//Initialize every attached Element, the Core initializes them in dependency order (e.g. Log first, Render before GUI)
+	//if (!appCore->initialize()) { appCore->terminate(); return 1; }
+	// ---
+	// MAKE SURE ELEMENTS ATTACHED AND CONFIGURED FIRST THEN INITIALIZED
 
 	// ---
 	//Elements can be manually detached since detachElement will call the Element's respective terminate function
@@ -1,5 +1,5 @@
 //MODIFY: Replace 'Template' with desired name for Element including in file name
-//Remember to modify Core.h and Core.cpp accordingly
+//Register the Element with Core's registerElement (e.g. from a plugin, see TemplatePlugin.cpp), no changes to Core.h or Core.cpp are required
  
 //Include the TemplateElement header file e.g. #include "render/RenderElement.h"
 #include "template/TemplateElement.h"
@@ -19,7 +19,7 @@ namespace CoreTemplateElement
 	{
 	}
 
-	//Call after Core's attachElement(elementName) has been called
+	//Called by Core's initialize, via the initializer passed to registerElement
 	//Pass any required parameters for initialization, e.g. RenderElement's initialize function requires window height and width
 	bool TemplateElement::initialize()
 	{
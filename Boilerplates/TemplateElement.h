@@ -1,5 +1,5 @@
 //MODIFY: Replace 'Template' with desired name for Element including in file name
-//Remember to modify Core.h and Core.cpp accordingly
+//Register the Element with Core's registerElement (e.g. from a plugin, see TemplatePlugin.cpp), no changes to Core.h or Core.cpp are required
  
 // ------- Necessary in every Element header -------
 //Prevent header file from being included multiple times
@@ -8,6 +8,8 @@
 //Include EngineAPI.h and declare function/class with ENGINE_API macro
 //WARNING: Use carefully to ensure valid encapsulation
 #include "EngineAPI.h"
+//Include Element.h so that the Element derives from Sol::Element, allowing the Core to store, initialize, update, and terminate it
+#include "Element.h"
 //Include <memory> to manage the link between Core and this Element
 //string also frequently used
 #include <memory>
@@ -30,7 +32,7 @@ namespace Sol {
 namespace CoreTemplateElement
 {
 	//State functionality of Element in a comment here
-	class TemplateElement
+	class TemplateElement : public Sol::Element
 	{
 	public:
 		//Construct TemplateElement and pass shared_ptr to Core
@@ -40,7 +42,7 @@ namespace CoreTemplateElement
 		~TemplateElement();
 
 		//Initialize TemplateElement
-		//Call this after calling TemplateElement's attachElement
+		//Called by Core's initialize, via the initializer passed to registerElement, once the Element's dependencies are initialized
 		ENGINE_API bool initialize();
 
 		//Any custom functionality
@@ -48,8 +50,12 @@ namespace CoreTemplateElement
 
 		//Terminate TemplateElement
 		//Call this to deallocate any of TemplateElement's resources
-		//Call this when amending Core's detachElement function and inside Core's terminate function
-		void terminate();
+		//Called by Core's detachElement and Core's terminate
+		void terminate() override;
+
+		//Optionally override update and/or fixedUpdate, called by the Core every frame and every fixed timestep tick
+		//void update(double deltaTime) override;
+		//void fixedUpdate(double fixedTimestep) override;
 
 		//If required, ensure object(s) managed by TemplateElement (e.g. RenderElement manages SDL Window)
 		//Have get function(s) for (pointer(s) to) object(s) managed by TemplateElement
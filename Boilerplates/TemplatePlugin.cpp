@@ -0,0 +1,22 @@
+//MODIFY: Replace 'Template' with desired name for Element including in file name
+//Build as a shared library (.dll) linking against the Engine, then load it with appCore->loadPlugin("TemplatePlugin.dll") or the Editor's --plugin argument
+
+//Include the TemplateElement header file
+#include "template/TemplateElement.h"
+
+//#Include Core.h
+//Core.h's full definition required
+#include "Core.h"
+
+//Called by Core's loadPlugin, register (and optionally attach) the plugin's Element(s) here
+SOL_PLUGIN_EXPORT void solRegisterPlugin(Sol::Core* core)
+{
+	core->registerElement(
+		"Template", //Name used to attach, detach, configure, and get the Element
+		{ "Log" }, //Names of the Elements that must be initialized before this one, e.g. { "Log", "Render" }
+		[](std::shared_ptr<Sol::Core> core) { return std::make_shared<CoreTemplateElement::TemplateElement>(core); },
+		[](Sol::Element& element) { return static_cast<CoreTemplateElement::TemplateElement&>(element).initialize(); });
+
+	//Attach the Element, or leave it to the application to attach by name
+	core->attachElement("Template");
+}
@@ -4,20 +4,67 @@
 //--------------------------
 
 #include "Core.h"
+#include "util/BinaryLog.h"
+#include "util/RenderBenchmark.h"
 
 int main(int argc, char* args[]) {
+	//Optional command line arguments for input recording and replay, and for plugins
+	//--record <file> records the session's input, --replay <file> replays a recorded session, --headless replays without rendering or the GUI
+	//--plugin <file> loads a plugin shared library providing custom Elements (may be given more than once)
+	//--binary-log writes a structured binary log (Sol-Editor.sollog) rather than a text log, --decode-log <binary log> <text log> decodes one and exits
+	//--render-benchmark times the Render System at 10k, 100k, and 1M sprites without a window or a GPU and exits, --dump-commands <file> also writes its command lists to file
+	std::string recordPath;
+	std::string replayPath;
+	std::vector<std::string> pluginPaths;
+	bool headless = false;
+	bool binaryLog = false;
+	bool renderBenchmark = false;
+	std::string dumpCommandsPath;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = args[i];
+		if (arg == "--record" && i + 1 < argc) { recordPath = args[++i]; }
+		else if (arg == "--replay" && i + 1 < argc) { replayPath = args[++i]; }
+		else if (arg == "--plugin" && i + 1 < argc) { pluginPaths.push_back(args[++i]); }
+		else if (arg == "--headless") { headless = true; }
+		else if (arg == "--binary-log") { binaryLog = true; }
+		else if (arg == "--render-benchmark") { renderBenchmark = true; }
+		else if (arg == "--dump-commands" && i + 1 < argc) { dumpCommandsPath = args[++i]; }
+		else if (arg == "--decode-log" && i + 2 < argc)
+		{
+			std::string binaryPath = args[i + 1];
+			std::string textPath = args[i + 2];
+			if (!EngineLog::decodeBinaryLog(binaryPath, textPath))
+			{
+				SOL_LOG_ERROR("[Editor] Failed To Decode Binary Log: %s", binaryPath.c_str());
+				return 1;
+			}
+			SOL_LOG_INFO("[Editor] Decoded Binary Log To: %s", textPath.c_str());
+			return 0;
+		}
+	}
+	if (renderBenchmark)
+	{
+		//The benchmark runs its own headless Core, so the Editor's Elements are never initialized
+		std::vector<EngineBenchmark::SpriteBenchmarkResult> results;
+		if (!EngineBenchmark::runSpriteBenchmark({ 10000, 100000, 1000000 }, 30, dumpCommandsPath, results))
+		{
+			SOL_LOG_ERROR("[Editor] Render Benchmark Failed");
+			return 1;
+		}
+		return 0;
+	}
+	headless = headless && !replayPath.empty(); //Headless only makes sense for a replay, otherwise there would be no way to interact with the Editor
+
 	//Core instance (make_shared allows Elements to have a weak_ptr to Core, important for Elements to access each other if desired)
 	auto appCore = std::make_shared<Sol::Core>();
 
-	//Attach and initialize any Element(s) by name
-	//Setup render before GUI since the GUI requires the OpenGL context and the SDL window
-	//Setup physics/render/event before ECS so that the ECS can register the systems using these
-	//Attach elements before calling initialize functions
-	//Initialize log element (if using) before attaching and initializing other elements to ensure can log from them to the specified txt file
+	//Attach any Element(s) by name, then configure any Element(s) that shouldn't use their default initialize parameters
+	//The Core initializes every attached Element in dependency order, e.g. Render before GUI since the GUI requires the OpenGL context and the SDL window,
+	//and physics/render/event before ECS so that the ECS can register the systems using these
+	//The Log Element is always initialized first so that every other Element can log to the specified txt file
 
 	appCore->attachElement("Log");
-	appCore->getLogElement()->initialize("Sol-Editor.txt");
-
 	appCore->attachElement("Shader");
 	appCore->attachElement("Resource");
 	appCore->attachElement("Render");
@@ -27,17 +74,54 @@ int main(int argc, char* args[]) {
 	appCore->attachElement("Ecs");
 	appCore->attachElement("Scene");
 
-	appCore->getShaderElement()->initialize();
-	appCore->getResourceElement()->initialize();
+	//Plugins register (and attach) their own Elements, which are initialized alongside the built-in Elements
+	for (const auto& pluginPath : pluginPaths)
+	{
+		appCore->loadPlugin(pluginPath);
+	}
+
+	if (binaryLog)
+	{
+		appCore->configureElement<CoreLogElement::LogElement>(std::string("Sol-Editor.sollog"), true);
+	}
+	else
+	{
+		appCore->configureElement<CoreLogElement::LogElement>(std::string("Sol-Editor.txt"));
+	}
 	//Setting the window name to "Sol Editor", default window size to 800x600, and
 	//window flags to (SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI), and vsync to 0 (disabled)
-	appCore->getRenderElement()->initialize("Sol Engine", 800, 600, (SDL_WindowFlags)(SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI), 0);
-	appCore->getGuiElement()->initialize(true); //Gui element depends upon render element, render element must be attached and initialized first
-	appCore->getPhysicsElement()->initialize();
-	appCore->getEventElement()->initialize();
+	//A headless replay still requires the OpenGL context, so the window is created but hidden
+	SDL_WindowFlags windowFlags = (SDL_WindowFlags)(SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI | (headless ? SDL_WINDOW_HIDDEN : 0));
+	appCore->configureElement<CoreRenderElement::RenderElement>(std::string("Sol Engine"), 800.0f, 600.0f, windowFlags, 0);
+	appCore->configureElement<CoreGuiElement::GuiElement>(true);
 	//Setting each system to true or false depending on whether or not they need to be used (for full ECS functionality, true for each required)
-	appCore->getEcsElement()->initialize(true, true, true); //Order for parameters is render, physics, events
-	appCore->getSceneElement()->initialize();	
+	appCore->configureElement<CoreEcsElement::EcsElement>(true, true, true); //Order for parameters is render, physics, events
+
+	if (!appCore->initialize())
+	{
+		appCore->terminate();
+		return 1;
+	}
+
+	//The Editor starts with the scene stopped (matching the Toolbar's Start button), and idles whilst nothing changes
+	//Idle mode stops the Editor spinning a core at 100% with vsync disabled, it only redraws on input, window events, or ECS changes
+	appCore->get<CoreEcsElement::EcsElement>()->setSceneRunning(false);
+	appCore->setIdleEnabled(true);
+
+	//Start recording or replaying input if requested on the command line
+	if (!replayPath.empty())
+	{
+		//A failed headless replay would otherwise leave a hidden window running with nothing to do
+		if (!appCore->startReplay(replayPath, headless) && headless)
+		{
+			appCore->terminate();
+			return 1;
+		}
+	}
+	else if (!recordPath.empty())
+	{
+		appCore->startRecording(recordPath);
+	}
 
 	//Runtime loop, controlled by the Core
 	bool appRunning = true;
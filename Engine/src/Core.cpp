@@ -7,134 +7,314 @@
 //Responsible for allowing any Sol Applications such as the Sol Editor to interact with the Engine (Core, Elements, ECS)
 
 #include "Core.h"
+#include "systems/NullRenderDevice.h"
+
+//C++ libraries
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <future>
+#include <mutex>
 
 namespace Sol
 {
-	//Create an instance of LogElement with a unique pointer to it, other elements use nullptr until attached via attachElement
+	namespace
+	{
+		//Describe a built-in Element to the Core from its compile-time ElementTraits
+		template<typename T>
+		ElementRegistration makeBuiltInRegistration()
+		{
+			ElementRegistration registration;
+			registration.name = ElementTraits<T>::name();
+			registration.dependencies = ElementTraits<T>::dependencies();
+			registration.mainThread = ElementTraits<T>::mainThread;
+			registration.memoryTag = ElementTraits<T>::memoryTag;
+			registration.create = [](std::shared_ptr<Core> core) { return std::static_pointer_cast<Element>(std::make_shared<T>(core)); };
+			registration.initialize = [](Element& element) { return ElementTraits<T>::initialize(static_cast<T&>(element)); };
+			return registration;
+		}
+
+		//How long after the last input, window event, ECS modification, or redraw request idle mode keeps drawing frames
+		//Gives Dear ImGui time to settle, e.g. hover highlights, window resizes, and docking previews
+		const double IDLE_REDRAW_SECONDS = 0.25;
+		//Whilst idle, how often to stop waiting for events to check whether the ECS has been modified
+		const int IDLE_WAKE_INTERVAL_MS = 100;
+
+		//The frame limiter sleeps until this long before a frame's deadline, then spins
+		//SDL_Delay can oversleep by up to a timer period (1 ms once SDL raises the timer resolution), so spin for longer than that
+		const double FRAME_PACING_SPIN_MS = 2.0;
+
+		template<typename T>
+		void registerBuiltInElement(std::vector<ElementRegistration>& registrations)
+		{
+			registrations[ElementTraits<T>::index] = makeBuiltInRegistration<T>();
+		}
+	}
+
+	//Register every built-in Element at its compile-time index, nothing is attached until attachElement is called
 	Core::Core()
 	{
+		m_registrations.resize(BUILT_IN_ELEMENT_COUNT);
+		registerBuiltInElement<CoreLogElement::LogElement>(m_registrations);
+		registerBuiltInElement<CoreShaderElement::ShaderElement>(m_registrations);
+		registerBuiltInElement<CoreResourceElement::ResourceElement>(m_registrations);
+		registerBuiltInElement<CoreRenderElement::RenderElement>(m_registrations);
+		registerBuiltInElement<CoreGuiElement::GuiElement>(m_registrations);
+		registerBuiltInElement<CorePhysicsElement::PhysicsElement>(m_registrations);
+		registerBuiltInElement<CoreEventElement::EventElement>(m_registrations);
+		registerBuiltInElement<CoreEcsElement::EcsElement>(m_registrations);
+		registerBuiltInElement<CoreSceneElement::SceneElement>(m_registrations);
+
+		m_elements.resize(m_registrations.size());
+		for (size_t i = 0; i < m_registrations.size(); i++)
+		{
+			m_elementIndices[m_registrations[i].name] = i;
+		}
+		m_renderDevice.reset(new EcsRenderSystem::NullRenderDevice());
 	}
 	Core::~Core()
 	{
+		//Release every Element and registration before unloading plugins, since their code may be inside a plugin
+		m_elements.clear();
+		m_registrations.clear();
+		for (void* pluginHandle : m_pluginHandles)
+		{
+			SDL_UnloadObject(pluginHandle);
+		}
 	}
 
+	//Initialize every attached Element that is not yet initialized, in dependency order
+	//The dependency graph is walked as a DAG: every Element's prepare is started on a worker thread straight away,
+	//then each Element is initialized once it is prepared and its dependencies are initialized,
+	//on a worker thread if it allows, otherwise on this (the main) thread
 	bool Core::initialize()
 	{
-		//Any initial checks for Core initialization
-		return true;
-	}
+		std::vector<size_t> order;
+		if (!resolveInitializationOrder(order))
+		{
+			SOL_LOG_ERROR("[Core] Failed To Initialize: Element Dependencies Are Circular");
+			return false;
+		}
+		//Only Elements not already initialized take part, already initialized dependencies are treated as complete
+		order.erase(std::remove_if(order.begin(), order.end(), [this](size_t index) { return m_registrations[index].initialized; }), order.end());
+		if (order.empty())
+		{
+			return true;
+		}
 
-	bool Core::attachElement(const std::string& elementName)
-	{
-		//Elements can be attached via the following mechanism:
-		//Check elementName and check if Core's respective Element unique_ptr is a nullptr
-		//(elementName should only be in Capitalization case e.g. 'Render', and should not include 'Element')
-		//If Core's respective Element unique_ptr is a nullptr
-		// Call make_unique to instantiate the Element class, giving shared_from_this to the Element's constructor
-		// Log success and return true
+		const u64 startNs = EngineProfiler::Profiler::now();
 
-		if (elementName == "Log" && !m_logElement)
+		//Shared state between the main thread and the worker threads, guarded by mutex
+		//Only the main thread starts work, so it is the only thread that reads the graph to decide what is ready
+		std::mutex mutex;
+		std::condition_variable stateChanged;
+		std::vector<size_t> remainingDependencies(m_elements.size(), 0);
+		std::vector<std::vector<size_t>> dependents(m_elements.size());
+		std::vector<bool> prepared(m_elements.size(), false);
+		std::vector<bool> started(m_elements.size(), false);
+		std::vector<ElementStartupTiming> timings(m_elements.size());
+		size_t completedCount = 0;
+		size_t runningCount = 0;
+		bool failed = false;
+		std::string failureMessage; //Logged once every task has finished, since the Log Element may still be initializing
+
+		std::vector<bool> pending(m_elements.size(), false);
+		for (size_t index : order)
 		{
-			m_logElement = std::make_unique<CoreLogElement::LogElement>(shared_from_this());
-			std::cout << "[Core] Successfully Attached " << elementName << " Element" << std::endl;
-			return true;
+			pending[index] = true;
 		}
-		if (elementName == "Shader" && !m_shaderElement)
+		for (size_t index : order)
 		{
-			m_shaderElement = std::make_unique<CoreShaderElement::ShaderElement>(shared_from_this());
-			if (m_logElement)
+			for (const auto& dependencyName : m_registrations[index].dependencies)
 			{
-				m_logElement->logInfo(std::string("[Core] Successfully Attached ") + elementName + " Element");
-				return true;
+				auto it = m_elementIndices.find(dependencyName);
+				if (it != m_elementIndices.end() && it->second != index && pending[it->second])
+				{
+					remainingDependencies[index]++;
+					dependents[it->second].push_back(index);
+				}
 			}
-			std::cout << "[Core] Successfully Attached " << elementName << " Element" << std::endl;
-			return true;
+			timings[index].index = index;
 		}
-		if (elementName == "Render" && !m_renderElement)
+
+		//Every task reports back through finishTask, so the main thread wakes up to start whatever became ready
+		auto finishTask = [&](size_t index, bool succeeded, bool initializePhase)
 		{
-			m_renderElement = std::make_unique<CoreRenderElement::RenderElement>(shared_from_this());
-			if (m_logElement)
+			std::lock_guard<std::mutex> lock(mutex);
+			runningCount--;
+			if (!succeeded)
 			{
-				m_logElement->logInfo(std::string("[Core] Successfully Attached ") + elementName + " Element");
-				return true;
+				if (!failed)
+				{
+					failureMessage = std::string(initializePhase ? "[Core] Failed To Initialize " : "[Core] Failed To Prepare ") + m_registrations[index].name + " Element";
+				}
+				failed = true;
 			}
-			std::cout << "[Core] Successfully Attached " << elementName << " Element" << std::endl;
-			return true;
-		}
-		if (elementName == "Gui" && !m_guiElement)
-		{
-			m_guiElement = std::make_unique<CoreGuiElement::GuiElement>(shared_from_this());
-			if (m_logElement)
+			else if (!initializePhase)
 			{
-				m_logElement->logInfo(std::string("[Core] Successfully Attached ") + elementName + " Element");
-				return true;
+				prepared[index] = true;
 			}
-			std::cout << "[Core] Successfully Attached " << elementName << " Element" << std::endl;
-			return true;
-		}
-		if (elementName == "Event" && !m_eventElement)
-		{
-			m_eventElement = std::make_unique<CoreEventElement::EventElement>(shared_from_this());
-			if (m_logElement)
+			else
 			{
-				m_logElement->logInfo(std::string("[Core] Successfully Attached ") + elementName + " Element");
-				return true;
+				m_registrations[index].initialized = true;
+				completedCount++;
+				for (size_t dependent : dependents[index])
+				{
+					remainingDependencies[dependent]--;
+				}
 			}
-			std::cout << "[Core] Successfully Attached " << elementName << " Element" << std::endl;
-			return true;
-		}
-		if (elementName == "Physics" && !m_physicsElement)
+			stateChanged.notify_all();
+		};
+
+		auto prepareElement = [&](size_t index)
+		{
+			SOL_MEMORY_TAG(m_registrations[index].memoryTag);
+			timings[index].prepareStartNs = EngineProfiler::Profiler::now();
+			bool succeeded = m_elements[index]->prepare();
+			timings[index].prepareEndNs = EngineProfiler::Profiler::now();
+			SOL_PROFILE_RECORD_ZONE("Element::prepare", timings[index].prepareStartNs, timings[index].prepareEndNs);
+			finishTask(index, succeeded, false);
+		};
+
+		auto initializeElement = [&](size_t index)
+		{
+			ElementRegistration& registration = m_registrations[index];
+			SOL_MEMORY_TAG(registration.memoryTag);
+			timings[index].initializeStartNs = EngineProfiler::Profiler::now();
+			//An Element failing to initialize stops initialization, since any Elements depending on it would fail too
+			bool succeeded = registration.initialize && registration.initialize(*m_elements[index]);
+			timings[index].initializeEndNs = EngineProfiler::Profiler::now();
+			//Interned, as the registration's name may move if an Element is registered later, whilst the zone is still buffered
+			SOL_PROFILE_RECORD_ZONE(EngineProfiler::Profiler::internName(registration.name), timings[index].initializeStartNs, timings[index].initializeEndNs);
+			finishTask(index, succeeded, true);
+		};
+
+		//Worker tasks, destroying a std::async future waits for its task so no task can outlive this function
+		std::vector<std::future<void>> workerTasks;
+		auto startWorkerTask = [&](std::function<void()> task)
 		{
-			m_physicsElement = std::make_unique<CorePhysicsElement::PhysicsElement>(shared_from_this());
-			if (m_logElement)
+			workerTasks.push_back(std::async(std::launch::async, [task]()
 			{
-				m_logElement->logInfo(std::string("[Core] Successfully Attached ") + elementName + " Element");
-				return true;
-			}
-			std::cout << "[Core] Successfully Attached " << elementName << " Element" << std::endl;
-			return true;
+				EngineProfiler::Profiler::setThreadName("Startup Worker");
+				task();
+			}));
+		};
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			runningCount += order.size();
 		}
-		if (elementName == "Resource" && !m_resourceElement)
+		for (size_t index : order)
 		{
-			m_resourceElement = std::make_unique<CoreResourceElement::ResourceElement>(shared_from_this());
-			if (m_logElement)
-			{
-				m_logElement->logInfo(std::string("[Core] Successfully Attached ") + elementName + " Element");
-				return true;
-			}
-			std::cout << "[Core] Successfully Attached " << elementName << " Element" << std::endl;
-			return true;
+			startWorkerTask([&prepareElement, index]() { prepareElement(index); });
 		}
-		if (elementName == "Ecs" && !m_ecsElement)
+
+		std::unique_lock<std::mutex> lock(mutex);
+		while (!failed && completedCount < order.size())
 		{
-			m_ecsElement = std::make_shared<CoreEcsElement::EcsElement>(shared_from_this());
-			if (m_logElement)
+			//Start every Element that is now ready, worker Elements are started first so they overlap with any main thread Element
+			size_t mainThreadIndex = m_elements.size();
+			for (size_t index : order)
 			{
-				m_logElement->logInfo(std::string("[Core] Successfully Attached ") + elementName + " Element");
-				return true;
+				if (started[index] || !prepared[index] || remainingDependencies[index] != 0)
+				{
+					continue;
+				}
+				if (m_registrations[index].mainThread)
+				{
+					if (mainThreadIndex == m_elements.size())
+					{
+						mainThreadIndex = index;
+					}
+					continue;
+				}
+				started[index] = true;
+				runningCount++;
+				timings[index].initializedOnMainThread = false;
+				startWorkerTask([&initializeElement, index]() { initializeElement(index); });
 			}
-			std::cout << "[Core] Successfully Attached " << elementName << " Element" << std::endl;
-			return true;
-		}
-		if (elementName == "Scene" && !m_sceneElement)
-		{
-			m_sceneElement = std::make_unique<CoreSceneElement::SceneElement>(shared_from_this());
-			if (m_logElement)
+			if (mainThreadIndex != m_elements.size())
 			{
-				m_logElement->logInfo(std::string("[Core] Successfully Attached ") + elementName + " Element");
-				return true;
+				started[mainThreadIndex] = true;
+				runningCount++;
+				lock.unlock();
+				initializeElement(mainThreadIndex);
+				lock.lock();
+				continue;
 			}
-			std::cout << "[Core] Successfully Attached " << elementName << " Element" << std::endl;
-			return true;
+			if (runningCount == 0)
+			{
+				//Nothing is running and nothing can start, which only happens if a dependency is not initialized and cannot be
+				failureMessage = "[Core] Failed To Initialize: Element Dependencies Cannot Be Initialized";
+				failed = true;
+				break;
+			}
+			stateChanged.wait(lock);
 		}
-		
-		//If Element can't be attached then
-		if (m_logElement)
+		//Let any running tasks finish before their state goes out of scope
+		stateChanged.wait(lock, [&runningCount]() { return runningCount == 0; });
+		lock.unlock();
+		workerTasks.clear();
+
+		if (failed)
 		{
-			m_logElement->logError(std::string("[Core] Failed To Attach ") + elementName + " Element"); //Due to left-to-right associativity and operator precedence, only implicit conversion of first literal necessary
+			SOL_LOG_ERROR("%s", failureMessage.c_str());
 			return false;
 		}
-		std::cerr << "[Core] Failed To Attach " << elementName << " Element" << std::endl;
+
+		std::vector<ElementStartupTiming> orderedTimings;
+		for (size_t index : order)
+		{
+			orderedTimings.push_back(timings[index]);
+		}
+		logStartupReport(orderedTimings, startNs, EngineProfiler::Profiler::now());
+		return true;
+	}
+
+	void Core::logStartupReport(const std::vector<ElementStartupTiming>& timings, u64 startNs, u64 endNs) const
+	{
+		std::vector<ElementStartupTiming> sortedTimings = timings;
+		std::sort(sortedTimings.begin(), sortedTimings.end(), [](const ElementStartupTiming& a, const ElementStartupTiming& b)
+		{
+			return a.initializeStartNs < b.initializeStartNs;
+		});
+
+		auto toMs = [](u64 fromNs, u64 toNs) { return toNs > fromNs ? static_cast<double>(toNs - fromNs) / 1000000.0 : 0.0; };
+		double serialMs = 0.0;
+		SOL_LOG_INFO("[Core] Startup Report (times in ms, starts relative to initialize)");
+		for (const auto& timing : sortedTimings)
+		{
+			double prepareMs = toMs(timing.prepareStartNs, timing.prepareEndNs);
+			double initializeMs = toMs(timing.initializeStartNs, timing.initializeEndNs);
+			serialMs += prepareMs + initializeMs;
+			SOL_LOG_INFO("[Core]   %-10s prepare %8.2f  initialize %8.2f  started at %8.2f on %s",
+				m_registrations[timing.index].name.c_str(), prepareMs, initializeMs, toMs(startNs, timing.initializeStartNs),
+				timing.initializedOnMainThread ? "main thread" : "worker thread");
+		}
+		SOL_LOG_INFO("[Core] Startup Took %.2f ms (%.2f ms if run serially)", toMs(startNs, endNs), serialMs);
+	}
+
+	bool Core::attachElement(const std::string& elementName)
+	{
+		//Elements can be attached via the following mechanism:
+		//Look up the Element's registration by elementName, and check the Element is not already attached
+		//(elementName should only be in Capitalization case e.g. 'Render', and should not include 'Element')
+		//If the Element is not attached
+		// Create the Element using its registered factory, giving shared_from_this to the Element's constructor
+		// Log success and return true
+
+		auto it = m_elementIndices.find(elementName);
+		if (it != m_elementIndices.end() && !m_elements[it->second])
+		{
+			m_elements[it->second] = m_registrations[it->second].create(shared_from_this());
+			m_registrations[it->second].initialized = false;
+			SOL_LOG_INFO("[Core] Successfully Attached %s Element", elementName.c_str());
+			return true;
+		}
+
+		//If Element can't be attached then
+		SOL_LOG_ERROR("[Core] Failed To Attach %s Element", elementName.c_str());
 		return false;
 	}	
 
@@ -142,80 +322,137 @@ namespace Sol
 	bool Core::detachElement(const std::string& elementName)
 	{
 		//Elements can be detached via the following mechanism:
-		//Check elementName and check if Core's respective Element unique_ptr is not a nullptr
+		//Look up the Element's registration by elementName, and check the Element is attached
 		//(elementName should only be in Capitalization case e.g. 'Render', and should not include 'Element')
-		//If Core's respective Element unique_ptr is not a nullptr
-		//Set Core's respective Element unique_ptr to a nullptr
+		//If the Element is attached
+		//Call the Element's terminate function and release the Core's smart pointer to it
 		//Log success
 
-		if (elementName == "Log" && m_logElement)
-		{
-			m_logElement->terminate();
-			m_logElement = nullptr;
-			std::cout << "[Core] Successfully Detached " << elementName << " Element" << std::endl;
-			return true;
-		}
-		if (elementName == "Render" && m_renderElement)
-		{
-			m_renderElement->terminate();
-			m_renderElement = nullptr;
-			std::cout << "[Core] Successfully Detached " << elementName << " Element" << std::endl;
-			return true;
-		}
-		if (elementName == "Gui" && m_guiElement)
+		auto it = m_elementIndices.find(elementName);
+		if (it != m_elementIndices.end() && m_elements[it->second])
 		{
-			m_guiElement->terminate();
-			m_guiElement = nullptr;
-			std::cout  << "[Core] Successfully Detached " << elementName << " Element" << std::endl;
+			m_elements[it->second]->terminate();
+			m_elements[it->second] = nullptr;
+			m_registrations[it->second].initialized = false;
+			SOL_LOG_INFO("[Core] Successfully Detached %s Element", elementName.c_str());
 			return true;
 		}
-		if (elementName == "Event" && m_eventElement)
+
+		//If Element can't be detached then
+		SOL_LOG_ERROR("[Core] Failed To Detach %s Element", elementName.c_str());
+		return false;
+	}
+
+	bool Core::configureElement(const std::string& elementName, ElementInitializer initializer)
+	{
+		auto it = m_elementIndices.find(elementName);
+		if (it == m_elementIndices.end())
 		{
-			m_eventElement->terminate();
-			m_eventElement = nullptr;
-			std::cout << "[Core] Successfully Detached " << elementName << " Element" << std::endl;
-			return true;
+			SOL_LOG_ERROR("[Core] Failed To Configure %s Element: Not Registered", elementName.c_str());
+			return false;
 		}
-		if (elementName == "Physics" && m_physicsElement)
+		setElementInitializer(it->second, std::move(initializer));
+		return true;
+	}
+
+	void Core::setElementInitializer(size_t index, ElementInitializer initializer)
+	{
+		m_registrations[index].initialize = std::move(initializer);
+	}
+
+	//Kahn's algorithm over the attached Elements, always picking the lowest index that is ready so the order is deterministic
+	//Dependencies that are not attached are ignored, an Element that cannot work without one reports so when initialized
+	bool Core::resolveInitializationOrder(std::vector<size_t>& order) const
+	{
+		std::vector<size_t> remainingDependencies(m_elements.size(), 0);
+		std::vector<std::vector<size_t>> dependents(m_elements.size());
+		size_t attachedCount = 0;
+		for (size_t i = 0; i < m_elements.size(); i++)
 		{
-			m_physicsElement->terminate();
-			m_physicsElement = nullptr;
-			std::cout << "[Core] Successfully Detached " << elementName << " Element" << std::endl;
-			return true;
+			if (!m_elements[i])
+			{
+				continue;
+			}
+			attachedCount++;
+			for (const auto& dependencyName : m_registrations[i].dependencies)
+			{
+				auto it = m_elementIndices.find(dependencyName);
+				if (it != m_elementIndices.end() && it->second != i && m_elements[it->second])
+				{
+					remainingDependencies[i]++;
+					dependents[it->second].push_back(i);
+				}
+			}
 		}
-		if (elementName == "Resource" && m_resourceElement)
+
+		order.clear();
+		std::vector<bool> placed(m_elements.size(), false);
+		while (order.size() < attachedCount)
 		{
-			m_resourceElement->terminate();
-			m_resourceElement = nullptr;
-			std::cout << "[Core] Successfully Detached " << elementName << " Element" << std::endl;
-			return true;
+			size_t next = m_elements.size();
+			for (size_t i = 0; i < m_elements.size(); i++)
+			{
+				if (m_elements[i] && !placed[i] && remainingDependencies[i] == 0)
+				{
+					next = i;
+					break;
+				}
+			}
+			if (next == m_elements.size())
+			{
+				return false; //Every remaining Element is waiting on another, so the dependencies are circular
+			}
+			placed[next] = true;
+			order.push_back(next);
+			for (size_t dependent : dependents[next])
+			{
+				remainingDependencies[dependent]--;
+			}
 		}
-		if (elementName == "Shader" && m_shaderElement)
+		return true;
+	}
+
+	bool Core::registerElement(const std::string& elementName, const std::vector<std::string>& dependencies, ElementFactory create, ElementInitializer initialize, bool mainThread)
+	{
+		if (m_elementIndices.count(elementName) || !create)
 		{
-			m_shaderElement = nullptr;
-			std::cout << "[Core] Successfully Detached " << elementName << " Element" << std::endl;
-			return true;
+			SOL_LOG_ERROR("[Core] Failed To Register %s Element", elementName.c_str());
+			return false;
 		}
-		if (elementName == "Ecs" && m_ecsElement)
+		ElementRegistration registration;
+		registration.name = elementName;
+		registration.dependencies = dependencies;
+		registration.dependencies.push_back("Log");
+		registration.create = std::move(create);
+		registration.initialize = std::move(initialize);
+		registration.mainThread = mainThread;
+		m_elementIndices[elementName] = m_registrations.size();
+		m_registrations.push_back(std::move(registration));
+		m_elements.push_back(nullptr);
+		SOL_LOG_INFO("[Core] Successfully Registered %s Element", elementName.c_str());
+		return true;
+	}
+
+	//Plugins are loaded with SDL's shared object loading, which wraps LoadLibrary/dlopen for the current platform
+	bool Core::loadPlugin(const std::string& filePath)
+	{
+		void* pluginHandle = SDL_LoadObject(filePath.c_str());
+		if (!pluginHandle)
 		{
-			m_ecsElement->terminate();
-			m_ecsElement = nullptr;
-			std::cout << "[Core] Successfully Detached " << elementName << " Element" << std::endl;
-			return true;
+			SOL_LOG_ERROR("[Core] Failed To Load Plugin %s: %s", filePath.c_str(), SDL_GetError());
+			return false;
 		}
-		if (elementName == "Sene" && m_sceneElement)
+		auto registerPlugin = reinterpret_cast<SolRegisterPluginFunction>(SDL_LoadFunction(pluginHandle, SOL_PLUGIN_ENTRY_POINT));
+		if (!registerPlugin)
 		{
-			m_sceneElement->terminate();
-			m_sceneElement = nullptr;
-			std::cout << "[Core] Successfully Detached " << elementName << " Element" << std::endl;
-			return true;
+			SDL_UnloadObject(pluginHandle);
+			SOL_LOG_ERROR("[Core] Failed To Load Plugin %s: No " SOL_PLUGIN_ENTRY_POINT " Function Exported", filePath.c_str());
+			return false;
 		}
-
-		//... ///
-
-		//If Element can't be detached then
-		m_logElement->logError(std::string("[Core] Failed To Detach ") + elementName + " Element"); //Due to left-to-right associativity and operator precedence, only implicit conversion of first literal necessary
-		return false;
+		m_pluginHandles.push_back(pluginHandle);
+		registerPlugin(this);
+		SOL_LOG_INFO("[Core] Successfully Loaded Plugin %s", filePath.c_str());
+		return true;
 	}
 
 	void Core::run()
@@ -224,197 +461,591 @@ namespace Sol
 		Uint64 currentTime = SDL_GetPerformanceCounter();
 		Uint64 lastTime = 0;
 		double deltaTime = 0.0;
-		double fixedTimestep = 1.0 / 60.0; //60 updates per second
+		double fixedTimestep = m_fixedTimestep;
 		double accumulatedTime = 0.0;
 
+		EngineProfiler::Profiler::setThreadName("Main");
+		//Allocations the main loop makes outside of any Element are the Core's own
+		SOL_MEMORY_TAG(EngineMemory::MemoryTag::Core);
+
+		m_lastActivityTime = currentTime;
+
 		while (true)
 		{
+			//Get the built-in Elements the main loop drives, each an O(1) lookup
+			auto renderElement = get<CoreRenderElement::RenderElement>();
+			auto guiElement = get<CoreGuiElement::GuiElement>();
+			auto eventElement = get<CoreEventElement::EventElement>();
+			auto ecsElement = get<CoreEcsElement::EcsElement>();
+
+			//Whilst idle, block until an event arrives (checking periodically whether the ECS has been modified) rather than drawing identical frames
+			if (canIdle(ecsElement, guiElement))
+			{
+				{
+					SOL_PROFILE_ZONE("Core::IdleWait");
+					while (!SDL_WaitEventTimeout(nullptr, IDLE_WAKE_INTERVAL_MS) && !m_redrawRequested && !(ecsElement && ecsElement->consumeDirty())) {}
+				}
+				//The time spent waiting is neither simulated nor counted as frame time, and a fixed tick runs straight away to handle the waking event
+				currentTime = SDL_GetPerformanceCounter();
+				accumulatedTime = fixedTimestep;
+				m_lastActivityTime = currentTime;
+			}
+
+			SOL_PROFILE_ZONE("Core::Frame");
+			m_metrics.beginFrame();
+
 			//Update timing variables
 			lastTime = currentTime;
 			currentTime = SDL_GetPerformanceCounter();
 			deltaTime = static_cast<double>(currentTime - lastTime) / SDL_GetPerformanceFrequency();
+			double frameTimeMs = deltaTime * 1000.0; //Recorded before the safeguard below so the Performance viewport shows the real frame time
 			deltaTime = std::min(deltaTime, 0.25); //Prevent deltaTime from being too large, essentially the 'spiral of death' safeguard
 			accumulatedTime += deltaTime;
+			//Whilst replaying, run exactly one tick per frame as fast as possible rather than following the wall clock
+			if (m_inputReplayer.isOpen())
+			{
+				deltaTime = fixedTimestep;
+				accumulatedTime = fixedTimestep;
+			}
+			bool skipRendering = m_inputReplayer.isOpen() && m_replayHeadless;
 
 			//Handle events at a fixed timestep
 			//This includes handling the ECS's fixed update timestep based Systems via the ECS Element
 			while (accumulatedTime >= fixedTimestep)
 			{
-				std::vector<SDL_Event> events;
+				SOL_PROFILE_ZONE("Core::FixedTick");
+				Uint64 tickStart = SDL_GetPerformanceCounter();
+				std::vector<SDL_Event>& events = m_polledEvents;
+				events.clear();
 				SDL_Event event;
-				while (SDL_PollEvent(&event))
 				{
-					events.push_back(event);
+					SOL_PROFILE_ZONE("Core::PollEvents");
+					SOL_MEMORY_TAG(EngineMemory::MemoryTag::Event);
+					while (SDL_PollEvent(&event))
+					{
+						//Whilst replaying, real keyboard input is discarded so only the recorded input reaches the simulation
+						if (m_inputReplayer.isOpen() && (event.type == SDL_KEYDOWN || event.type == SDL_KEYUP))
+						{
+							continue;
+						}
+						events.push_back(event);
+					}
+					if (eventElement) { eventElement->handleEvents(events); }
+					if (!events.empty()) { m_lastActivityTime = SDL_GetPerformanceCounter(); }
+				}
+				bool simulateTick = true;
+				if (m_inputReplayer.isOpen()) { simulateTick = replayTick(); }
+				else if (m_inputRecorder.isOpen()) { recordTick(); }
+				if (ecsElement && simulateTick)
+				{
+					SOL_MEMORY_TAG(EngineMemory::MemoryTag::Ecs);
+					ecsElement->fixedUpdate(fixedTimestep);
 				}
-				if (m_eventElement) { m_eventElement->handleEvents(events); }
-				if (m_ecsElement) { m_ecsElement->fixedUpdate(fixedTimestep); }
-				if (!m_eventElement->isRunning()) { break; } //If the Event Element detects a quit event, the application will quit as this is the main loop of an application using the Core
-				m_eventElement->resetInputEvents();
+				//Registered (e.g. plugin) Elements are updated after the built-in Elements
+				for (size_t i = BUILT_IN_ELEMENT_COUNT; i < m_elements.size(); i++)
+				{
+					SOL_MEMORY_TAG(m_registrations[i].memoryTag);
+					if (m_elements[i] && simulateTick) { m_elements[i]->fixedUpdate(fixedTimestep); }
+				}
+				if (!eventElement->isRunning()) { break; } //If the Event Element detects a quit event, the application will quit as this is the main loop of an application using the Core
+				eventElement->resetInputEvents();
+				//Nothing allocated from the tick arena outlives the tick
+				EngineMetrics::FrameCounters& counters = m_metrics.currentFrame();
+				counters.tickArenaBytes = std::max(counters.tickArenaBytes, static_cast<u32>(m_tickArena.getUsed()));
+				m_tickArena.reset();
 				accumulatedTime -= fixedTimestep;
+				m_metrics.recordFixedTick(static_cast<double>(SDL_GetPerformanceCounter() - tickStart) * 1000.0 / SDL_GetPerformanceFrequency());
 			}
 
 			//Render using delta timestep, and render the GUI
 			//This includes handling the ECS's variable delta timestep based Systems via the ECS Element
-			if (m_renderElement) { m_renderElement->clearScreen(); } //Clear screen to ensure frames aren't drawn on top of one another
-			if (m_ecsElement) { m_ecsElement->update(deltaTime); }
-			if (m_guiElement) { m_guiElement->update(deltaTime); }
-			if (m_renderElement) { m_renderElement->swapBuffers(); } //Swap buffers since OpenGL renders two frames, one in the background to be calculated and then presented after swap, and one in the foreground to be currently presented
-			if (!m_eventElement->isRunning()) { break; } //If the Event Element detects a quit event, the application will quit as this is the main loop of an application using the Core
+			//A headless replay skips all of this, only the simulation is run
+			if (!skipRendering)
+			{
+				{
+					SOL_PROFILE_ZONE("Core::ClearScreen");
+					if (renderElement) { renderElement->beginGameView(); } //Bind and clear the game view to ensure frames aren't drawn on top of one another
+				}
+				{
+					SOL_PROFILE_ZONE("Core::EcsUpdate");
+					SOL_MEMORY_TAG(EngineMemory::MemoryTag::Ecs);
+					if (ecsElement) { ecsElement->update(deltaTime); }
+				}
+				for (size_t i = BUILT_IN_ELEMENT_COUNT; i < m_elements.size(); i++)
+				{
+					SOL_MEMORY_TAG(m_registrations[i].memoryTag);
+					if (m_elements[i]) { m_elements[i]->update(deltaTime); }
+				}
+				{
+					SOL_PROFILE_ZONE("Core::PresentGameView");
+					if (renderElement) { renderElement->endGameView(); } //Upscale the game view to the window (unless the Editor shows it), the GUI is drawn over it at the window's resolution
+				}
+				{
+					SOL_PROFILE_ZONE("Core::GuiUpdate");
+					SOL_MEMORY_TAG(EngineMemory::MemoryTag::Gui);
+					if (guiElement) { guiElement->update(deltaTime); }
+				}
+				{
+					SOL_PROFILE_ZONE("Core::SwapBuffers");
+					if (renderElement) { renderElement->swapBuffers(); } //Swap buffers since OpenGL renders two frames, one in the background to be calculated and then presented after swap, and one in the foreground to be currently presented
+				}
+			}
+			//Replays run as fast as possible, so are never capped
+			if (m_frameRateCap > 0.0 && !m_inputReplayer.isOpen())
+			{
+				paceFrame();
+			}
+			m_metrics.currentFrame().frameArenaBytes = static_cast<u32>(m_frameArena.getUsed());
+			//GPU timings are read back frames after they were rendered, so these are the latest read back rather than this frame's
+			if (renderElement)
+			{
+				EngineMetrics::FrameCounters& counters = m_metrics.currentFrame();
+				for (std::size_t pass = 0; pass < EngineMetrics::GPU_PASS_COUNT; pass++)
+				{
+					counters.gpuPassMs[pass] = renderElement->getGpuTimer().getLatestMs(static_cast<EngineMetrics::GpuPass>(pass));
+				}
+			}
+			m_metrics.endFrame(frameTimeMs);
+			//Nothing allocated from the frame arena outlives the frame
+			m_frameArena.reset();
+			m_debugDraw.clear();
+			if (!eventElement->isRunning()) { break; } //If the Event Element detects a quit event, the application will quit as this is the main loop of an application using the Core
 		}
 	}
 
-	void Core::terminate()
+	void Core::setIdleEnabled(bool enabled)
 	{
-		//Call terminate function(s) for attached Element(s)
-		if (m_guiElement) { detachElement("Gui"); }
-		if (m_renderElement) { detachElement("Render"); }
-		if (m_eventElement) { detachElement("Event"); }
-		if (m_physicsElement) { detachElement("Physics"); }
-		if (m_resourceElement) { detachElement("Resource"); }
-		if (m_shaderElement) { detachElement("Shader"); }
-		if (m_ecsElement) { detachElement("Ecs"); }
-		if (m_sceneElement) { detachElement("Scene"); }
-		if (m_logElement) { detachElement("Log"); }
-		std::cout << "[Core] Successfully Terminated" << std::endl;
+		m_idleEnabled = enabled;
 	}
 
-	//---
+	void Core::requestRedraw()
+	{
+		m_redrawRequested = true;
+		//Wake run() if it is waiting for events, SDL_PushEvent is thread-safe
+		SDL_Event event;
+		SDL_zero(event);
+		event.type = SDL_USEREVENT;
+		SDL_PushEvent(&event);
+	}
 
-	//Get functions for Elements
+	void Core::setFrameRateCap(double framesPerSecond)
+	{
+		m_frameRateCap = std::max(framesPerSecond, 0.0);
+		m_nextFrameDeadline = 0;
+	}
 
-    //Elements can be gotten via the following mechanism:
-	//Check if Core's respective Element unique_ptr is a nullptr
-	//If not, return a temporary raw pointer to the Core's unique_ptr (using .get())
-	//Otherwise, log error and return nullptr
+	double Core::getFrameRateCap() const
+	{
+		return m_frameRateCap;
+	}
 
-	CoreLogElement::LogElement* Core::getLogElement() const
+	//Deadlines advance by exactly one frame period, rather than from when each frame ended, so sleep overshoot doesn't accumulate as drift
+	void Core::paceFrame()
 	{
-		if (m_logElement)
+		SOL_PROFILE_ZONE("Core::FramePacing");
+		const Uint64 frequency = SDL_GetPerformanceFrequency();
+		const Uint64 period = static_cast<Uint64>(static_cast<double>(frequency) / m_frameRateCap);
+		Uint64 now = SDL_GetPerformanceCounter();
+		//On the first capped frame, or having fallen more than a frame behind (e.g. a hitch or idling), start pacing afresh rather than rushing to catch up
+		bool restarted = m_nextFrameDeadline == 0 || now > m_nextFrameDeadline + period;
+		if (restarted)
 		{
-			return m_logElement.get();
+			m_nextFrameDeadline = now + period;
 		}
-		std::cerr << "[Core] Failed To Get Log Element: nullptr found" << std::endl;
-		return nullptr;
-	}
 
-	CoreRenderElement::RenderElement* Core::getRenderElement() const
-	{
-		if (m_renderElement)
+		//Coarse sleep, leaving FRAME_PACING_SPIN_MS to spin
+		while (now < m_nextFrameDeadline)
+		{
+			double remainingMs = static_cast<double>(m_nextFrameDeadline - now) * 1000.0 / frequency;
+			if (remainingMs <= FRAME_PACING_SPIN_MS)
+			{
+				break;
+			}
+			SDL_Delay(static_cast<Uint32>(remainingMs - FRAME_PACING_SPIN_MS));
+			now = SDL_GetPerformanceCounter();
+		}
+		//Spin for the remainder, for sub-millisecond precision
+		while (now < m_nextFrameDeadline)
 		{
-			return m_renderElement.get();
+			now = SDL_GetPerformanceCounter();
 		}
-		if (m_logElement)
+
+		//Pacing error is how far the measured frame time (end to end) was from the target frame time
+		if (!restarted && m_lastPacedFrameEnd != 0)
 		{
-			m_logElement->logError("[Core] Failed To Get Render Element: nullptr found");
-			return nullptr;
+			double frameMs = static_cast<double>(now - m_lastPacedFrameEnd) * 1000.0 / frequency;
+			m_metrics.recordPacingError(std::abs(frameMs - 1000.0 / m_frameRateCap));
 		}
-		std::cerr << "[Core] Failed To Get Render Element: nullptr found" << std::endl;
-		return nullptr;
+		m_lastPacedFrameEnd = now;
+		m_nextFrameDeadline += period;
 	}
 
-	CoreGuiElement::GuiElement* Core::getGuiElement() const
+	bool Core::canIdle(CoreEcsElement::EcsElement* ecsElement, CoreGuiElement::GuiElement* guiElement)
 	{
-		if (m_guiElement)
+		if (!m_idleEnabled || m_inputRecorder.isOpen() || m_inputReplayer.isOpen())
 		{
-			return m_guiElement.get();
+			return false;
 		}
-		if (m_logElement)
+		//Any modification or redraw request counts as activity, so the frames showing it are drawn
+		if (m_redrawRequested.exchange(false) || (ecsElement && ecsElement->consumeDirty()))
 		{
-			m_logElement->logError("[Core] Failed To Get Gui Element: nullptr found");
-			return nullptr;
+			m_lastActivityTime = SDL_GetPerformanceCounter();
+			return false;
 		}
-		std::cerr << "[Core] Failed To Get Gui Element: nullptr found" << std::endl;
-		return nullptr;
+		if ((ecsElement && ecsElement->isSceneRunning()) || (guiElement && guiElement->isInteracting()))
+		{
+			return false;
+		}
+		double secondsSinceActivity = static_cast<double>(SDL_GetPerformanceCounter() - m_lastActivityTime) / SDL_GetPerformanceFrequency();
+		return secondsSinceActivity >= IDLE_REDRAW_SECONDS;
 	}
 
-	CoreEventElement::EventElement* Core::getEventElement() const
+	void Core::terminate()
 	{
-		if (m_eventElement)
+		//Finish any recording so the log is complete, and stop any replay
+		if (m_inputRecorder.isOpen()) { stopRecording(); }
+		if (m_inputReplayer.isOpen()) { stopReplay(); }
+		//Elements delete their OpenGL objects as they are terminated, so the context must be on this thread
+		acquireGLContext();
+		//Call terminate function(s) for attached Element(s), in the reverse of their dependency order so every Element is terminated before the Elements it depends upon
+		std::vector<size_t> order;
+		if (!resolveInitializationOrder(order))
 		{
-			return m_eventElement.get();
+			//Circular dependencies can't be ordered, so fall back to the reverse of registration order
+			order.clear();
+			for (size_t i = 0; i < m_elements.size(); i++)
+			{
+				if (m_elements[i]) { order.push_back(i); }
+			}
 		}
-		if (m_logElement)
+		for (auto it = order.rbegin(); it != order.rend(); ++it)
 		{
-			m_logElement->logError("[Core] Failed To Get Event Element: nullptr found");
-			return nullptr;
+			detachElement(m_registrations[*it].name);
 		}
-		std::cerr << "[Core] Failed To Get Event Element: nullptr found" << std::endl;
-		return nullptr;
+		SOL_LOG_INFO("[Core] Successfully Terminated");
 	}
 
-	CorePhysicsElement::PhysicsElement* Core::getPhysicsElement() const
+	//---
+
+	//Get functions for Elements
+
+    //Elements can be gotten via the following mechanism:
+	//Check if the Element at the Element's compile-time index is attached
+	//If so, return a temporary raw pointer to it (using .get())
+	//Otherwise, log error and return nullptr
+
+	Element* Core::getAttachedElement(size_t index) const
 	{
-		if (m_eventElement)
+		if (m_elements[index])
 		{
-			return m_physicsElement.get();
+			return m_elements[index].get();
 		}
-		if (m_logElement)
+		SOL_LOG_ERROR("[Core] Failed To Get %s Element: nullptr found", m_registrations[index].name.c_str());
+		return nullptr;
+	}
+
+	Element* Core::getElement(const std::string& elementName) const
+	{
+		auto it = m_elementIndices.find(elementName);
+		if (it != m_elementIndices.end())
 		{
-			m_logElement->logError("[Core] Failed To Get Event Element: nullptr found");
-			return nullptr;
+			return getAttachedElement(it->second);
 		}
-		std::cerr << "[Core] Failed To Get Event Element: nullptr found" << std::endl;
+		SOL_LOG_ERROR("[Core] Failed To Get %s Element: Not Registered", elementName.c_str());
 		return nullptr;
 	}
 
+	CoreLogElement::LogElement* Core::getLogElement() const
+	{
+		//Not logged if missing, since the Log Element is optional and Elements check for it to decide where to log
+		return get<CoreLogElement::LogElement>();
+	}
+
+	CoreRenderElement::RenderElement* Core::getRenderElement() const
+	{
+		return static_cast<CoreRenderElement::RenderElement*>(getAttachedElement(RENDER_ELEMENT_INDEX));
+	}
+
+	CoreGuiElement::GuiElement* Core::getGuiElement() const
+	{
+		return static_cast<CoreGuiElement::GuiElement*>(getAttachedElement(GUI_ELEMENT_INDEX));
+	}
+
+	CoreEventElement::EventElement* Core::getEventElement() const
+	{
+		return static_cast<CoreEventElement::EventElement*>(getAttachedElement(EVENT_ELEMENT_INDEX));
+	}
+
+	CorePhysicsElement::PhysicsElement* Core::getPhysicsElement() const
+	{
+		return static_cast<CorePhysicsElement::PhysicsElement*>(getAttachedElement(PHYSICS_ELEMENT_INDEX));
+	}
+
 	CoreResourceElement::ResourceElement* Core::getResourceElement() const
 	{
-		if (m_resourceElement)
+		return static_cast<CoreResourceElement::ResourceElement*>(getAttachedElement(RESOURCE_ELEMENT_INDEX));
+	}
+
+	CoreShaderElement::ShaderElement* Core::getShaderElement() const
+	{
+		return static_cast<CoreShaderElement::ShaderElement*>(getAttachedElement(SHADER_ELEMENT_INDEX));
+	}
+
+	std::shared_ptr<CoreEcsElement::EcsElement> Core::getEcsElement() const
+	{
+		//Shared rather than raw, so the Systems can share ownership of the ECS Element
+		getAttachedElement(ECS_ELEMENT_INDEX);
+		return std::static_pointer_cast<CoreEcsElement::EcsElement>(m_elements[ECS_ELEMENT_INDEX]);
+	}
+
+	CoreSceneElement::SceneElement* Core::getSceneElement() const
+	{
+		return static_cast<CoreSceneElement::SceneElement*>(getAttachedElement(SCENE_ELEMENT_INDEX));
+	}
+
+	//---
+
+	//Return the performance metrics, always available since they are owned by the Core rather than an Element
+	EngineMetrics::Metrics* Core::getMetrics()
+	{
+		return &m_metrics;
+	}
+
+	EngineMemory::LinearArena& Core::getFrameArena()
+	{
+		return m_frameArena;
+	}
+
+	EngineMemory::LinearArena& Core::getTickArena()
+	{
+		return m_tickArena;
+	}
+
+	EngineDebugDraw::DebugDraw& Core::getDebugDraw()
+	{
+		return m_debugDraw;
+	}
+
+	void Core::acquireGLContext()
+	{
+		auto renderElement = get<CoreRenderElement::RenderElement>();
+		if (renderElement) { renderElement->acquireContext(); }
+	}
+
+	EcsRenderSystem::RenderDevice& Core::getRenderDevice()
+	{
+		return *m_renderDevice;
+	}
+
+	void Core::setRenderDevice(std::unique_ptr<EcsRenderSystem::RenderDevice> device)
+	{
+		//The old device is destroyed first, so an OpenGL device releases its objects whilst its context still exists
+		m_renderDevice.reset();
+		m_renderDevice = device ? std::move(device) : std::unique_ptr<EcsRenderSystem::RenderDevice>(new EcsRenderSystem::NullRenderDevice());
+		SOL_LOG_INFO("[Core] Render Device: %s", m_renderDevice->getName());
+	}
+
+	//---
+
+	//Input recording and replay
+
+	//Start recording the input of every fixed timestep tick into the log at filePath
+	//Requires the Event and ECS Elements, since these are what the input is fed to
+	bool Core::startRecording(const std::string& filePath)
+	{
+		auto eventElement = get<CoreEventElement::EventElement>();
+		auto ecsElement = get<CoreEcsElement::EcsElement>();
+		auto sceneElement = get<CoreSceneElement::SceneElement>();
+		if (!eventElement || !ecsElement)
+		{
+			SOL_LOG_ERROR("[Core] Failed To Start Recording: Event And Ecs Elements Are Required");
+			return false;
+		}
+		if (m_inputReplayer.isOpen())
 		{
-			return m_resourceElement.get();
+			SOL_LOG_ERROR("[Core] Failed To Start Recording: Cannot Record Whilst Replaying");
+			return false;
 		}
-		if (m_logElement)
+
+		//Save and reload the current scene (as the Editor's Save does), so the recording starts from exactly the state on disk
+		std::string initialScene = sceneElement ? sceneElement->getCurrentScenePath() : "";
+		if (!initialScene.empty())
 		{
-			m_logElement->logError("[Core] Failed To Get Resource Element: nullptr found");
-			return nullptr;
+			try
+			{
+				ecsElement->setSceneRunning(false);
+				sceneElement->unloadScene(initialScene);
+				sceneElement->loadScene(initialScene);
+			}
+			catch (const std::exception& e)
+			{
+				SOL_LOG_ERROR("[Core] Failed To Start Recording: %s", e.what());
+				return false;
+			}
 		}
-		std::cerr << "[Core] Failed To Get Resource Element: nullptr found" << std::endl;
-		return nullptr;
+
+		if (!m_inputRecorder.open(filePath, initialScene, m_fixedTimestep))
+		{
+			SOL_LOG_ERROR("[Core] Failed To Start Recording: Cannot Open %s", filePath.c_str());
+			return false;
+		}
+		m_lastSceneLoadCount = sceneElement ? sceneElement->getLoadCount() : 0;
+		m_inputTick = 0;
+		SOL_LOG_INFO("[Core] Started Recording Input: %s", filePath.c_str());
+		return true;
 	}
 
-	CoreShaderElement::ShaderElement* Core::getShaderElement() const
+	void Core::stopRecording()
 	{
-		if (m_shaderElement)
+		if (!m_inputRecorder.isOpen())
 		{
-			return m_shaderElement.get();
+			return;
 		}
-		if (m_logElement)
+		m_inputRecorder.close(m_inputTick);
+		SOL_LOG_INFO("[Core] Stopped Recording Input After %llu Ticks", static_cast<unsigned long long>(m_inputTick));
+	}
+
+	bool Core::isRecording() const
+	{
+		return m_inputRecorder.isOpen();
+	}
+
+	//Start replaying the log at filePath from its initial scene
+	bool Core::startReplay(const std::string& filePath, bool headless)
+	{
+		auto eventElement = get<CoreEventElement::EventElement>();
+		auto ecsElement = get<CoreEcsElement::EcsElement>();
+		auto sceneElement = get<CoreSceneElement::SceneElement>();
+		if (!eventElement || !ecsElement)
 		{
-			m_logElement->logError("[Core] Failed To Get Shader Element: nullptr found");
-			return nullptr;
+			SOL_LOG_ERROR("[Core] Failed To Start Replay: Event And Ecs Elements Are Required");
+			return false;
 		}
-		std::cerr << "[Core] Failed To Get Shader Element: nullptr found" << std::endl;
-		return nullptr;
+		if (m_inputRecorder.isOpen())
+		{
+			stopRecording();
+		}
+		if (!m_inputReplayer.open(filePath))
+		{
+			SOL_LOG_ERROR("[Core] Failed To Start Replay: Cannot Read %s", filePath.c_str());
+			return false;
+		}
+		if (m_inputReplayer.getFixedTimestep() != m_fixedTimestep)
+		{
+			SOL_LOG_WARN("[Core] Replay Was Recorded With A Different Fixed Timestep, Results May Differ: %s", filePath.c_str());
+		}
+
+		//Start from the recorded initial scene, or an empty scene if none was loaded when recording started
+		try
+		{
+			ecsElement->setSceneRunning(false);
+			if (sceneElement && !m_inputReplayer.getInitialScene().empty())
+			{
+				sceneElement->loadScene(m_inputReplayer.getInitialScene());
+			}
+			else if (sceneElement)
+			{
+				sceneElement->newScene();
+			}
+		}
+		catch (const std::exception& e)
+		{
+			m_inputReplayer.close();
+			SOL_LOG_ERROR("[Core] Failed To Start Replay: %s", e.what());
+			return false;
+		}
+
+		if (!m_inputReplayer.readRecord(m_nextReplayRecord))
+		{
+			m_inputReplayer.close();
+			SOL_LOG_ERROR("[Core] Failed To Start Replay: Log Is Empty Or Corrupt: %s", filePath.c_str());
+			return false;
+		}
+		m_inputTick = 0;
+		m_replayHeadless = headless;
+		m_replaySceneRunning = false;
+		m_replayStartTime = SDL_GetPerformanceCounter();
+		SOL_LOG_INFO("[Core] Started Replaying Input%s%s", headless ? " (Headless): " : ": ", filePath.c_str());
+		return true;
 	}
 
-	std::shared_ptr<CoreEcsElement::EcsElement> Core::getEcsElement() const
+	void Core::stopReplay()
 	{
-		if (m_ecsElement)
+		auto eventElement = get<CoreEventElement::EventElement>();
+		if (!m_inputReplayer.isOpen())
 		{
-			return m_ecsElement;
+			return;
 		}
-		if (m_logElement)
+		m_inputReplayer.close();
+		double seconds = static_cast<double>(SDL_GetPerformanceCounter() - m_replayStartTime) / SDL_GetPerformanceFrequency();
+		SOL_LOG_INFO("[Core] Replay Finished: %llu Ticks In %.3f Seconds (%.1f Ticks Per Second)",
+			static_cast<unsigned long long>(m_inputTick), seconds, seconds > 0.0 ? m_inputTick / seconds : 0.0);
+
+		//A headless replay has nothing left to show, so quit as if the window had been closed
+		if (m_replayHeadless && eventElement)
 		{
-			m_logElement->logError("[Core] Failed To Get ECS Element: nullptr found");
-			return nullptr;
+			eventElement->requestQuit();
 		}
-		std::cerr << "[Core] Failed To Get ECS Element: nullptr found" << std::endl;
-		return nullptr;
 	}
 
-	CoreSceneElement::SceneElement* Core::getSceneElement() const
+	bool Core::isReplaying() const
+	{
+		return m_inputReplayer.isOpen();
+	}
+
+	void Core::recordTick()
 	{
-		if (m_sceneElement)
+		auto eventElement = get<CoreEventElement::EventElement>();
+		auto ecsElement = get<CoreEcsElement::EcsElement>();
+		auto sceneElement = get<CoreSceneElement::SceneElement>();
+		//A scene loaded since the last tick (e.g. via the Editor's Reload Scene) is recorded so the replay loads it at the same tick
+		std::string loadedScene;
+		if (sceneElement && sceneElement->getLoadCount() != m_lastSceneLoadCount)
 		{
-			return m_sceneElement.get();
+			m_lastSceneLoadCount = sceneElement->getLoadCount();
+			loadedScene = sceneElement->getCurrentScenePath();
 		}
-		if (m_logElement)
+		m_inputRecorder.writeTick(m_inputTick, ecsElement->isSceneRunning(), loadedScene, eventElement->getInputEvents());
+		m_inputTick++;
+	}
+
+	bool Core::replayTick()
+	{
+		auto eventElement = get<CoreEventElement::EventElement>();
+		auto ecsElement = get<CoreEcsElement::EcsElement>();
+		auto sceneElement = get<CoreSceneElement::SceneElement>();
+		if (m_nextReplayRecord.tick == m_inputTick)
 		{
-			m_logElement->logError("[Core] Failed To Get Scene Element: nullptr found");
-			return nullptr;
+			if (m_nextReplayRecord.flags & EngineReplay::INPUT_RECORD_END)
+			{
+				stopReplay();
+				return false;
+			}
+			if ((m_nextReplayRecord.flags & EngineReplay::INPUT_RECORD_SCENE_LOADED) && sceneElement)
+			{
+				try
+				{
+					sceneElement->loadScene(m_nextReplayRecord.loadedScene);
+				}
+				catch (const std::exception& e)
+				{
+					SOL_LOG_ERROR("[Core] Replay Failed To Load Scene: %s", e.what());
+				}
+			}
+			m_replaySceneRunning = (m_nextReplayRecord.flags & EngineReplay::INPUT_RECORD_SCENE_RUNNING) != 0;
+			eventElement->injectInputEvents(m_nextReplayRecord.events);
+
+			if (!m_inputReplayer.readRecord(m_nextReplayRecord))
+			{
+				SOL_LOG_ERROR("[Core] Replay Log Ended Unexpectedly, Stopping Replay");
+				stopReplay();
+				return false;
+			}
 		}
-		std::cerr << "[Core] Failed To Get Scene Element: nullptr found" << std::endl;
-		return nullptr;
+		//Scene running state is only recorded when it changes, so hold the last replayed state every tick
+		ecsElement->setSceneRunning(m_replaySceneRunning);
+		m_inputTick++;
+		return true;
 	}
 
 	//---
@@ -71,14 +71,14 @@ namespace CoreEcsElement
     void EcsElement::terminate() {
         //Clear the ECS's data structures
         clear();
-        //Clear the System maps
+        //Clear the registered Systems
         m_systems.clear();
-        m_fixedUpdateSystems.clear();
     }
 
     //Create a new Entity by returning the last Entity incremented by 1
     Entity EcsElement::createEntity() {
         //Get a new entity ID
+        m_dirty = true;
         return m_entityID++;
     }
 
@@ -92,6 +92,8 @@ namespace CoreEcsElement
         }
         //Erase the entity from the entity-component map
         m_entityComponentMap.erase(entity);
+        m_dirty = true;
+        m_structureVersion++;
         //Could also reduce m_entityID by 1
         //Leaving as is because one may want the ID of the deleted Entity to remain
         //No harm in this since creating an entity only returns the result of m_entityID++, which is always a std::uint32_t
@@ -107,6 +109,7 @@ namespace CoreEcsElement
     void EcsElement::setSceneRunning(bool runningState)
     {
         m_isSceneRunning = runningState;
+        m_dirty = true;
     }
 
     //Clear the ECS's data structures
@@ -116,19 +119,56 @@ namespace CoreEcsElement
         m_componentEntityMap.clear();
         //Also reset Entity ID to 0
         m_entityID = 0;
+        m_dirty = true;
+        m_structureVersion++;
     }
 
-    //Update all Systems that use a variable delta timestep
+    //Add a System, a System of a type that is already registered replaces the existing one (keeping its place in the update order)
+    void EcsElement::addSystem(RegisteredSystem system)
+    {
+        for (auto& registered : m_systems) {
+            if (registered.type == system.type) {
+                system.metricsIndex = registered.metricsIndex;
+                registered = std::move(system);
+                return;
+            }
+        }
+        auto corePtr = m_core.lock();
+        if (corePtr) {
+            system.metricsIndex = corePtr->getMetrics()->registerSystem(system.name);
+        }
+        m_systems.push_back(std::move(system));
+    }
+
+    //Update all Systems that use a variable delta timestep, timing each one for the Performance viewport
     void EcsElement::updateSystems(double deltaTime) {
+        auto corePtr = m_core.lock();
+        if (!corePtr) {
+            return;
+        }
+        EngineMetrics::Metrics* metrics = corePtr->getMetrics();
+        const double msPerCount = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
         for (const auto& system : m_systems) {
-            system.second(deltaTime);
+            SOL_PROFILE_ZONE(system.name);
+            Uint64 start = SDL_GetPerformanceCounter();
+            system.update(deltaTime);
+            metrics->recordSystemUpdate(system.metricsIndex, (SDL_GetPerformanceCounter() - start) * msPerCount);
         }
     }
 
-    //Update all Systems that use a fixed timestep
+    //Update all Systems that use a fixed timestep, timing each one for the Performance viewport
     void EcsElement::fixedUpdateSystems(double fixedTimestep) {
-        for (const auto& system : m_fixedUpdateSystems) {
-            system.second(fixedTimestep);
+        auto corePtr = m_core.lock();
+        if (!corePtr) {
+            return;
+        }
+        EngineMetrics::Metrics* metrics = corePtr->getMetrics();
+        const double msPerCount = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+        for (const auto& system : m_systems) {
+            SOL_PROFILE_ZONE(system.name);
+            Uint64 start = SDL_GetPerformanceCounter();
+            system.fixedUpdate(fixedTimestep);
+            metrics->recordSystemFixedUpdate(system.metricsIndex, (SDL_GetPerformanceCounter() - start) * msPerCount);
         }
     }
-} 
\ No newline at end of file
+}
\ No newline at end of file
@@ -22,37 +22,17 @@ namespace CoreEventElement
 	{
 		auto corePtr = m_core.lock();
 		if (corePtr)
-		{
-			if (corePtr->getLogElement())
-			{
-				m_logElementAttached = true;
-			}
-		}
-		if (corePtr)
 		{
 			if (!corePtr->getRenderElement())
 			{
 				//The Event Element requires the Render Element for processing events through SDL
 				//If not present, then log/output the appropriate error
-				if (m_logElementAttached)
-				{
-					corePtr->getLogElement()->logError("[Event] Failed to initialize EventElement: RenderElement is a nullptr");
-					return false;
-				}
-				std::cerr << "Failed to initialize EventElement: RenderElement is a nullptr" << std::endl;
+				SOL_LOG_ERROR("[Event] Failed to initialize EventElement: RenderElement is a nullptr");
 				return false;
 			}
 		}
 
-		if (m_logElementAttached)
-		{
-			if (corePtr)
-			{
-				corePtr->getLogElement()->logInfo("[Event] Successfully Initialized");
-			}
-			return true;
-		}
-		std::cout << "[Event] Successfully Initialized" << std::endl;
+		SOL_LOG_INFO("[Event] Successfully Initialized");
 		return true;
 	}
 
@@ -102,10 +82,28 @@ namespace CoreEventElement
 		}
 	}
 
+	//Add replayed input events, only keyboard events are passed on as these are the only input events the simulation uses
+	void EventElement::injectInputEvents(const std::vector<SDL_Event>& events)
+	{
+		for (const auto& event : events)
+		{
+			if (event.type == SDL_KEYDOWN)
+			{
+				m_inputEvents.push_back(event);
+			}
+		}
+	}
+
+	//Set the running state to false so the Core and the application cleanly quit
+	void EventElement::requestQuit()
+	{
+		m_running = false;
+	}
+
 	//The following functions are to be used by the Event System and the Physics System
 	//Their usage is to compare any current input events to existing Input Component Actions
 	//And then for Physics to apply forces/impulses/torques by input
-	std::vector<SDL_Event> EventElement::getInputEvents()
+	const std::vector<SDL_Event>& EventElement::getInputEvents() const
 	{
 		return m_inputEvents;
 	}
@@ -113,13 +111,14 @@ namespace CoreEventElement
 	void EventElement::resetInputEvents()
 	{
 		m_inputEvents.clear();
+		m_actionsForPhysics = nullptr;
 	}
 
-	void EventElement::setActionsForPhysics(const std::unordered_map<Entity, std::vector<ActionData>>& actionsPerEntity) {
+	void EventElement::setActionsForPhysics(const ActionsPerEntity* actionsPerEntity) {
 		m_actionsForPhysics = actionsPerEntity;
 	}
 
-	const std::unordered_map<Entity, std::vector<ActionData>>& EventElement::getActionsForPhysics() const {
+	const ActionsPerEntity* EventElement::getActionsForPhysics() const {
 		return m_actionsForPhysics;
 	}
 
@@ -127,6 +126,5 @@ namespace CoreEventElement
 	void EventElement::terminate()
 	{
 		resetInputEvents();
-		m_actionsForPhysics.clear();
 	}
 }
\ No newline at end of file
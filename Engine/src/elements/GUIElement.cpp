@@ -7,9 +7,24 @@
 #include "Config.h"
 
 #include "Core.h"
+#include "util/MemoryTracker.h"
 
 namespace CoreGuiElement
 {
+	namespace
+	{
+		//Dear ImGui's allocator, routed through the Memory Tracker so the GUI's allocations are tagged as such
+		void* imguiAllocate(size_t size, void*)
+		{
+			return EngineMemory::MemoryTracker::allocate(size, EngineMemory::MemoryTag::Gui);
+		}
+
+		void imguiFree(void* ptr, void*)
+		{
+			EngineMemory::MemoryTracker::free(ptr);
+		}
+	}
+
 	GuiElement::GuiElement(std::shared_ptr<Sol::Core> core) : m_core(core), m_debugMode(true)
 	{
 	}
@@ -17,30 +32,29 @@ namespace CoreGuiElement
 	{
 	}
 
+	//Rasterizing the fonts into the atlas is the slowest part of setting up Dear ImGui, and is CPU-only
+	//Building it here lets Core's initialize overlap it with the initialization of other Elements, rather than on the first frame
+	bool GuiElement::prepare()
+	{
+		//Set before anything allocates through Dear ImGui, so every allocation is freed by the same allocator
+		ImGui::SetAllocatorFunctions(imguiAllocate, imguiFree);
+		m_fontAtlas = std::make_unique<ImFontAtlas>();
+		m_fontAtlas->AddFontDefault();
+		return m_fontAtlas->Build();
+	}
+
 	//Call after Core's attachElement(elementName) has been called
 	//Pass any required parameters for initialization, the debug mode
 	bool GuiElement::initialize(bool debug)
 	{
 		auto corePtr = m_core.lock();
 		if (corePtr)
-		{
-			if (corePtr->getLogElement())
-			{
-				m_logElementAttached = true;
-			}
-		}
-		if (corePtr)
 		{
 			if (!corePtr->getRenderElement())
 			{
 				//The GUI Element requires the Render Element for an OpenGL context to render GUI to
 				//If not present, then log/output the appropriate error
-				if (m_logElementAttached)
-				{
-					std::cerr << "Failed to initialize GuiElement: RenderElement is a nullptr" << std::endl;
-					return false;
-				}
-				std::cerr << "Failed to initialize GuiElement: RenderElement is a nullptr" << std::endl;
+				SOL_LOG_ERROR("[Gui] Failed To Initialize: RenderElement is a nullptr");
 				return false;
 			}
 		}
@@ -48,9 +62,10 @@ namespace CoreGuiElement
 		//Check if the Editor should be viewed at all, if debug is false then no, otherwise yes (defaults to yes anyways)
 		m_debugMode = debug;
 
-		//Setup Dear ImGui context
+		//Setup Dear ImGui context, with the font atlas built by prepare (if it was prepared)
 		IMGUI_CHECKVERSION();
-		ImGui::CreateContext();
+		ImGui::SetAllocatorFunctions(imguiAllocate, imguiFree); //Already set if prepared, but the Element may be initialized without preparing
+		ImGui::CreateContext(m_fontAtlas.get());
 		ImGuiIO& io = ImGui::GetIO();
 		io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;     //Enable Keyboard Controls
 		io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;      //Enable Gamepad Controls
@@ -76,17 +91,14 @@ namespace CoreGuiElement
 			//If Render Element is not attached to Core, then GUI Element cannot be initialized, hence error check earlier
 			ImGui_ImplSDL2_InitForOpenGL(corePtr->getRenderElement()->getWindow(), corePtr->getRenderElement()->getGLContext());
 			ImGui_ImplOpenGL3_Init("#version 330");
-		}
-
-		if (m_logElementAttached)
-		{
-			if (corePtr)
+			//The Editor shows the game view in its Game window rather than behind its viewports
+			if (m_debugMode)
 			{
-				corePtr->getLogElement()->logInfo("[Gui] Successfully Initialized");
+				corePtr->getRenderElement()->setPresentGameView(false);
 			}
-			return true;
 		}
-		std::cout << "[Gui] Successfully Initialized" << std::endl;
+
+		SOL_LOG_INFO("[Gui] Successfully Initialized");
 		return true;
 	}
 
@@ -104,21 +116,31 @@ namespace CoreGuiElement
 		//Use the provided deltaTime value to set the value for ImGui
 		io.DeltaTime = static_cast<float>(deltaTime);
 
-		//Start the ImGui frame
-		ImGui_ImplOpenGL3_NewFrame();
-		ImGui_ImplSDL2_NewFrame();
-		ImGui::NewFrame();
-
-		//If Editor should be present, call a function that handles all viewports
-		if (m_debugMode)
 		{
-			editorViewports();
-		}
+			SOL_PROFILE_ZONE("GuiElement::buildFrame");
+			//Start the ImGui frame
+			ImGui_ImplOpenGL3_NewFrame();
+			ImGui_ImplSDL2_NewFrame();
+			ImGui::NewFrame();
+
+			//If Editor should be present, call a function that handles all viewports
+			if (m_debugMode)
+			{
+				editorViewports();
+			}
 
-		ImGui::Render();
+			ImGui::Render();
+		}
 
+		SOL_PROFILE_ZONE("GuiElement::renderDrawData");
+		//The GUI pass is timed on the GPU along with the game view's passes, for the main viewport only
+		//Platform windows are rendered in their own contexts, which the GPU timer's queries aren't issued on, so they aren't included
+		auto corePtr = m_core.lock();
+		CoreRenderElement::RenderElement* renderElement = corePtr ? corePtr->getRenderElement() : nullptr;
+		if (renderElement) { renderElement->getGpuTimer().beginPass(EngineMetrics::GpuPass::Gui); }
 		glViewport(0, 0, (int)io.DisplaySize.x, (int)io.DisplaySize.y);
 		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+		if (renderElement) { renderElement->getGpuTimer().endPass(EngineMetrics::GpuPass::Gui); }
 		//Update and Render additional Platform Windows
 		if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
 		{
@@ -127,7 +149,7 @@ namespace CoreGuiElement
 			ImGui::UpdatePlatformWindows();
 			ImGui::RenderPlatformWindowsDefault();
 			SDL_GL_MakeCurrent(backup_current_window, backup_current_context);
-		}		
+		}
 	}
 
 	//The popup to show upon first starting the Editor
@@ -218,6 +240,8 @@ namespace CoreGuiElement
 		sceneHierarchyViewport();
 		inspectorViewport();
 		resourceBrowserViewport();
+		performanceViewport();
+		gameViewport();
 	}
 
 	//Auxilliary function to be clean a Component type name to allow this to be written cleanly where required in the Editor
@@ -284,6 +308,69 @@ namespace CoreGuiElement
 				}
 				ImGui::EndMenu();
 			}
+			if (ImGui::BeginMenu("Profiler")) {
+				//Toggle zone recording, and save the recorded zones as a Chrome/Perfetto trace in the project directory
+				bool profilerEnabled = EngineProfiler::Profiler::isEnabled();
+				if (ImGui::MenuItem("Record Zones", NULL, &profilerEnabled)) {
+					EngineProfiler::Profiler::setEnabled(profilerEnabled);
+				}
+				if (ImGui::MenuItem("Save Trace")) {
+					saveProfilerTrace(0.0);
+				}
+				if (ImGui::MenuItem("Save Last 5 Seconds")) {
+					saveProfilerTrace(5.0);
+				}
+				if (ImGui::MenuItem("Clear Recorded Zones")) {
+					EngineProfiler::Profiler::clear();
+				}
+				ImGui::EndMenu();
+			}
+			if (ImGui::BeginMenu("Input")) {
+				//Record the scene's input into Sol-Input.solinput in the project directory, and replay it deterministically
+				auto corePtr = m_core.lock();
+				if (corePtr)
+				{
+					std::string recordingPath = "Sol-Input.solinput";
+					if (!ApplicationConfig::Config::projectPath.empty())
+					{
+						recordingPath = ApplicationConfig::Config::projectPath + "/" + recordingPath;
+					}
+					if (ImGui::MenuItem("Start Recording", NULL, false, !corePtr->isRecording() && !corePtr->isReplaying())) {
+						//Starting a recording saves and reloads the scene, which stops it
+						if (corePtr->startRecording(recordingPath)) {
+							m_isSceneRunning = false;
+						}
+					}
+					if (ImGui::MenuItem("Stop Recording", NULL, false, corePtr->isRecording())) {
+						corePtr->stopRecording();
+					}
+					if (ImGui::MenuItem("Replay Recording", NULL, false, !corePtr->isRecording() && !corePtr->isReplaying())) {
+						corePtr->startReplay(recordingPath, false);
+					}
+					if (ImGui::MenuItem("Stop Replay", NULL, false, corePtr->isReplaying())) {
+						corePtr->stopReplay();
+					}
+				}
+				ImGui::EndMenu();
+			}
+			if (ImGui::BeginMenu("Debug Draw")) {
+				//Toggle what the Render System and the Physics Element draw into the debug draw
+				auto corePtr = m_core.lock();
+				if (corePtr)
+				{
+					EngineDebugDraw::DebugDraw& debugDraw = corePtr->getDebugDraw();
+					u32 flags = debugDraw.getFlags();
+					ImGui::CheckboxFlags("Visible Colliders", &flags, EngineDebugDraw::DRAW_COLLIDERS);
+					ImGui::Separator();
+					ImGui::CheckboxFlags("Physics Shapes", &flags, EngineDebugDraw::DRAW_PHYSICS_SHAPES);
+					ImGui::CheckboxFlags("Physics Joints", &flags, EngineDebugDraw::DRAW_PHYSICS_JOINTS);
+					ImGui::CheckboxFlags("Physics AABBs", &flags, EngineDebugDraw::DRAW_PHYSICS_AABBS);
+					ImGui::CheckboxFlags("Centres Of Mass", &flags, EngineDebugDraw::DRAW_PHYSICS_CENTRES_OF_MASS);
+					ImGui::CheckboxFlags("Contacts", &flags, EngineDebugDraw::DRAW_PHYSICS_CONTACTS);
+					debugDraw.setFlags(flags);
+				}
+				ImGui::EndMenu();
+			}
 			ImGui::Separator();
 			if (ImGui::Button("Start"))
 			{
@@ -373,6 +460,94 @@ namespace CoreGuiElement
 		ImGui::End();
 	}
 
+	//Show the Render Element's game view, upscaled to fit the window at the screen's aspect ratio, with its resolution settings in the menu bar
+	void GuiElement::gameViewport()
+	{
+		ImGui::Begin("Game", NULL, ImGuiWindowFlags_MenuBar | ImGuiWindowFlags_NoScrollbar);
+
+		auto corePtr = m_core.lock();
+		CoreRenderElement::RenderElement* renderElement = corePtr ? corePtr->getRenderElement() : nullptr;
+		if (!renderElement)
+		{
+			ImGui::End();
+			return;
+		}
+		const CoreRenderElement::GameViewInfo& gameView = renderElement->getGameView();
+
+		if (ImGui::BeginMenuBar())
+		{
+			if (ImGui::BeginMenu("Resolution"))
+			{
+				//The render scale sets the internal resolution, dynamic resolution lowers it further whilst the GPU is over its target time
+				float renderScale = renderElement->getRenderScale();
+				if (ImGui::SliderFloat("Render Scale", &renderScale, CoreRenderElement::RenderElement::MIN_RENDER_SCALE, 1.0f, "%.2f")) {
+					renderElement->setRenderScale(renderScale);
+				}
+				bool dynamicResolution = renderElement->isDynamicResolutionEnabled();
+				if (ImGui::Checkbox("Dynamic Resolution", &dynamicResolution)) {
+					renderElement->setDynamicResolution(dynamicResolution);
+				}
+				float targetGpuFrameMs = renderElement->getTargetGpuFrameMs();
+				if (ImGui::DragFloat("Target GPU Time (ms)", &targetGpuFrameMs, 0.1f, 1.0f, 100.0f, "%.1f")) {
+					renderElement->setTargetGpuFrameMs(targetGpuFrameMs);
+				}
+				ImGui::Separator();
+				//The game view is rendered on its own thread whilst the next frame is simulated and recorded, so is shown a frame later
+				bool renderThread = renderElement->isRenderThreadEnabled();
+				if (ImGui::Checkbox("Render Thread", &renderThread)) {
+					renderElement->setRenderThreadEnabled(renderThread);
+				}
+				ImGui::EndMenu();
+			}
+			ImGui::Text("%dx%d (%.0f%%), Sprites GPU %.2f ms", gameView.width, gameView.height, gameView.resolutionScale * 100.0f, gameView.gpuFrameMs);
+			ImGui::EndMenuBar();
+		}
+
+		if (gameView.texture)
+		{
+			//Fit the screen's aspect ratio inside the window, centred
+			ImVec2 available = ImGui::GetContentRegionAvail();
+			float aspect = ApplicationConfig::Config::screenWidth / ApplicationConfig::Config::screenHeight;
+			ImVec2 size(available.x, available.x / aspect);
+			if (size.y > available.y)
+			{
+				size = ImVec2(available.y * aspect, available.y);
+			}
+			if (size.x > 0.0f && size.y > 0.0f)
+			{
+				ImVec2 cursor = ImGui::GetCursorPos();
+				ImGui::SetCursorPos(ImVec2(cursor.x + (available.x - size.x) * 0.5f, cursor.y + (available.y - size.y) * 0.5f));
+				//Only the region rendered this frame is shown, flipped as OpenGL textures start from the bottom
+				ImGui::Image((ImTextureID)(intptr_t)gameView.texture, size, ImVec2(0.0f, gameView.v), ImVec2(gameView.u, 0.0f));
+			}
+		}
+		else
+		{
+			ImGui::TextDisabled("No game view, the scene is rendered behind the Editor");
+		}
+
+		ImGui::End();
+	}
+
+	//Write the Profiler's recorded zones to Sol-Trace.json in the project directory (or the working directory if no project is loaded)
+	//A lastSeconds of 0 writes everything still held in the Profiler's buffers
+	void GuiElement::saveProfilerTrace(double lastSeconds)
+	{
+		std::string tracePath = "Sol-Trace.json";
+		if (!ApplicationConfig::Config::projectPath.empty())
+		{
+			tracePath = ApplicationConfig::Config::projectPath + "/" + tracePath;
+		}
+		bool saved = EngineProfiler::Profiler::dumpChromeTrace(tracePath, lastSeconds);
+
+		if (saved)
+		{
+			SOL_LOG_INFO("[Gui] Saved Profiler Trace: %s", tracePath.c_str());
+			return;
+		}
+		SOL_LOG_ERROR("[Gui] Failed To Save Profiler Trace: %s", tracePath.c_str());
+	}
+
 	//Upon new scene being selected in the toolbar, the user will be presented with a popup
 	//In this popup the user can set a name for the new scene and save, or cancel their actions
 	void GuiElement::handleNewScenePopup()
@@ -757,6 +932,20 @@ namespace CoreGuiElement
 								ecsPtr->removeInput(entity);
 							}
 						}
+						if (components.find(std::type_index(typeid(CameraComponent))) == components.end())
+						{
+							if (ImGui::MenuItem("Add Camera Component"))
+							{
+								ecsPtr->addCamera(entity);
+							}
+						}
+						else
+						{
+							if (ImGui::MenuItem("Delete Camera Component"))
+							{
+								ecsPtr->removeCamera(entity);
+							}
+						}
 						ImGui::Separator();
 						if (ImGui::Button("Delete Entity"))
 						{
@@ -861,6 +1050,21 @@ namespace CoreGuiElement
 
 								//Input float to manipulate the size of a sprite
 								ImGui::InputFloat2("Size", &spriteComponent->size.x);
+
+								//Sorting layer and order in layer, sprites with higher values are drawn in front
+								if (ImGui::InputInt("Sorting Layer", &spriteComponent->sortingLayer)) {
+									spriteComponent->sortingLayer = std::max(0, std::min(spriteComponent->sortingLayer, 31));
+								}
+								if (ImGui::InputInt("Order In Layer", &spriteComponent->orderInLayer)) {
+									spriteComponent->orderInLayer = std::max(-32768, std::min(spriteComponent->orderInLayer, 32767));
+								}
+
+								//Blend mode selector, opaque and alpha tested sprites are cheaper to draw than translucent sprites
+								const char* blendModes[] = { "Translucent", "Opaque", "Alpha Tested" };
+								int currentBlendMode = static_cast<int>(spriteComponent->blendMode);
+								if (ImGui::Combo("Blend Mode", &currentBlendMode, blendModes, IM_ARRAYSIZE(blendModes))) {
+									spriteComponent->blendMode = static_cast<SpriteBlendMode>(currentBlendMode);
+								}
 								ImGui::Separator();
 							}
 							if (m_selectedComponentType == typeid(PhysicsBodyComponent)) {
@@ -918,6 +1122,26 @@ namespace CoreGuiElement
 								ImGui::InputFloat("Restitution", &colliderComponent->restitution);
 								ImGui::Separator();
 							}
+							if (m_selectedComponentType == typeid(CameraComponent)) {
+								auto cameraComponent = std::static_pointer_cast<CameraComponent>(component);
+
+								ImGui::Text("Camera Component");
+								ImGui::Separator();
+
+								//The camera is panned by its Transform Component's position, zoom scales the view about it
+								ImGui::Checkbox("Primary Camera", &cameraComponent->isPrimary);
+								ImGui::InputFloat("Zoom", &cameraComponent->zoom);
+								ImGui::Separator();
+
+								//Follow an Entity's Transform Component whilst the scene is running
+								ImGui::Checkbox("Follow Target", &cameraComponent->follow);
+								int targetEntity = static_cast<int>(cameraComponent->targetEntity);
+								if (ImGui::InputInt("Target Entity", &targetEntity) && targetEntity >= 0) {
+									cameraComponent->targetEntity = static_cast<std::uint32_t>(targetEntity);
+								}
+								ImGui::InputFloat("Follow Speed", &cameraComponent->followSpeed);
+								ImGui::Separator();
+							}
 							if (m_selectedComponentType == typeid(InputComponent)) {
 								auto inputComponent = std::static_pointer_cast<InputComponent>(component);
 
@@ -1043,6 +1267,168 @@ namespace CoreGuiElement
 		ImGui::End();
 	}
 
+	//Presents the Core's performance metrics
+	//Every history is read straight out of a fixed-size ring buffer, so displaying them costs only the ImGui draw
+	void GuiElement::performanceViewport()
+	{
+		ImGui::Begin("Performance");
+
+		auto corePtr = m_core.lock();
+		if (!corePtr)
+		{
+			ImGui::End();
+			return;
+		}
+		const EngineMetrics::Metrics* metrics = corePtr->getMetrics();
+
+		//Frame time, and fixed timestep tick time
+		const EngineMetrics::History& frameTimes = metrics->frameTimeMs();
+		float averageFrameTime = frameTimes.average();
+		ImGui::Text("Frame: %.2f ms avg, %.2f ms max (%.0f FPS)", averageFrameTime, frameTimes.max(), averageFrameTime > 0.0f ? 1000.0f / averageFrameTime : 0.0f);
+		ImGui::PlotHistogram("##FrameTimes", frameTimes.data(), static_cast<int>(frameTimes.size()), static_cast<int>(frameTimes.offset()),
+			NULL, 0.0f, 33.3f, ImVec2(-1.0f, 60.0f));
+
+		const EngineMetrics::History& tickTimes = metrics->fixedTickMs();
+		ImGui::Text("Fixed Tick: %.3f ms avg, %.3f ms max", tickTimes.average(), tickTimes.max());
+		ImGui::PlotHistogram("##FixedTickTimes", tickTimes.data(), static_cast<int>(tickTimes.size()), static_cast<int>(tickTimes.offset()),
+			NULL, 0.0f, 16.7f, ImVec2(-1.0f, 60.0f));
+
+		//Frame rate cap and how precisely it is being held
+		if (ImGui::CollapsingHeader("Frame Pacing", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			int frameRateCap = static_cast<int>(corePtr->getFrameRateCap());
+			if (ImGui::InputInt("Frame Rate Cap (0 = Uncapped)", &frameRateCap, 10, 30))
+			{
+				corePtr->setFrameRateCap(static_cast<double>(std::max(frameRateCap, 0)));
+			}
+			if (frameRateCap > 0)
+			{
+				const EngineMetrics::History& pacingErrors = metrics->pacingErrorMs();
+				ImGui::Text("Pacing Error: %.3f ms avg, %.3f ms max", pacingErrors.average(), pacingErrors.max());
+				ImGui::PlotLines("##PacingErrors", pacingErrors.data(), static_cast<int>(pacingErrors.size()), static_cast<int>(pacingErrors.offset()),
+					NULL, 0.0f, 2.0f, ImVec2(-1.0f, 40.0f));
+			}
+		}
+
+		//Per-System cost, averaged over the history
+		if (ImGui::CollapsingHeader("Systems", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			ImGui::Columns(3, "SystemCosts");
+			ImGui::Text("System"); ImGui::NextColumn();
+			ImGui::Text("Update (ms)"); ImGui::NextColumn();
+			ImGui::Text("Fixed Update (ms)"); ImGui::NextColumn();
+			ImGui::Separator();
+			for (const auto& system : metrics->systems())
+			{
+				ImGui::Text("%s", cleanTypeName(system.name).c_str()); ImGui::NextColumn();
+				ImGui::Text("%.3f", system.updateMs.average()); ImGui::NextColumn();
+				ImGui::Text("%.3f", system.fixedUpdateMs.average()); ImGui::NextColumn();
+			}
+			ImGui::Columns(1);
+		}
+
+		//Rendering, counters are from the last completed frame
+		if (ImGui::CollapsingHeader("Rendering", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			const EngineMetrics::FrameCounters& lastFrame = metrics->lastFrame();
+			ImGui::Text("Draw Calls: %u (%u instanced, %u single)", lastFrame.drawCalls, lastFrame.instancedDrawCalls, lastFrame.singleDrawCalls);
+			ImGui::Text("Sprites: %u (%u culled)", lastFrame.spritesSubmitted, lastFrame.spritesCulled);
+			ImGui::Text("Static Chunks: %u drawn, %u rebuilt", lastFrame.staticChunksDrawn, lastFrame.staticChunksRebuilt);
+			ImGui::Text("Debug Lines: %u", lastFrame.debugLines);
+			ImGui::Text("GL State Changes: %u issued, %u skipped", lastFrame.glCallsIssued, lastFrame.glCallsSkipped);
+			const EngineMetrics::History& drawCalls = metrics->drawCalls();
+			ImGui::PlotLines("##DrawCalls", drawCalls.data(), static_cast<int>(drawCalls.size()), static_cast<int>(drawCalls.offset()),
+				NULL, 0.0f, FLT_MAX, ImVec2(-1.0f, 40.0f));
+
+			auto resourceElement = corePtr->getResourceElement();
+			if (resourceElement)
+			{
+				ImGui::Text("Textures: %zu (%.2f MB estimated)", resourceElement->getTextureCount(),
+					resourceElement->getTextureMemoryBytes() / (1024.0 * 1024.0));
+				const CoreResourceElement::TextureAtlas& atlas = resourceElement->getTextureAtlas();
+				ImGui::Text("Atlas: %zu textures packed into %zu pages", atlas.getPackedCount(), atlas.getPageCount());
+			}
+		}
+
+		//GPU time of each pass, read back from the GPU a few frames after it was rendered
+		//A sprite pass taking longer on the GPU than the Render System's update takes on the CPU points to fill rate rather than submission
+		if (ImGui::CollapsingHeader("GPU", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			ImGui::Columns(4, "GpuPassTimes");
+			ImGui::Text("Pass"); ImGui::NextColumn();
+			ImGui::Text("Latest (ms)"); ImGui::NextColumn();
+			ImGui::Text("Avg (ms)"); ImGui::NextColumn();
+			ImGui::Text("Max (ms)"); ImGui::NextColumn();
+			ImGui::Separator();
+			for (std::size_t i = 0; i < EngineMetrics::GPU_PASS_COUNT; i++)
+			{
+				EngineMetrics::GpuPass pass = static_cast<EngineMetrics::GpuPass>(i);
+				const EngineMetrics::History& passTimes = metrics->gpuPassMs(pass);
+				ImGui::Text("%s", EngineMetrics::getGpuPassName(pass)); ImGui::NextColumn();
+				ImGui::Text("%.3f", passTimes.latest()); ImGui::NextColumn();
+				ImGui::Text("%.3f", passTimes.average()); ImGui::NextColumn();
+				ImGui::Text("%.3f", passTimes.max()); ImGui::NextColumn();
+			}
+			ImGui::Columns(1);
+			const EngineMetrics::History& spriteTimes = metrics->gpuPassMs(EngineMetrics::GpuPass::Sprites);
+			ImGui::PlotLines("##GpuSpriteTimes", spriteTimes.data(), static_cast<int>(spriteTimes.size()), static_cast<int>(spriteTimes.offset()),
+				NULL, 0.0f, 16.7f, ImVec2(-1.0f, 40.0f));
+		}
+
+		//Physics
+		if (ImGui::CollapsingHeader("Physics", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			auto physicsElement = corePtr->getPhysicsElement();
+			if (physicsElement && physicsElement->getWorld())
+			{
+				auto world = physicsElement->getWorld();
+				ImGui::Text("Bodies: %d", world->GetBodyCount());
+				ImGui::Text("Contacts: %d", world->GetContactCount());
+			}
+			else
+			{
+				ImGui::Text("No Physics World");
+			}
+		}
+
+		//Heap allocations made by the Engine per frame
+		if (ImGui::CollapsingHeader("Memory", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			const EngineMetrics::History& allocations = metrics->allocationsPerFrame();
+			ImGui::Text("Allocations: %.0f this frame, %.1f avg, %.0f max", allocations.latest(), allocations.average(), allocations.max());
+			ImGui::PlotHistogram("##Allocations", allocations.data(), static_cast<int>(allocations.size()), static_cast<int>(allocations.offset()),
+				NULL, 0.0f, FLT_MAX, ImVec2(-1.0f, 40.0f));
+			//Transient data allocated from the Core's arenas rather than the heap
+			const EngineMetrics::FrameCounters& frame = metrics->lastFrame();
+			ImGui::Text("Frame Arena: %.1f KB used, %.1f KB reserved", frame.frameArenaBytes / 1024.0f, corePtr->getFrameArena().getCapacity() / 1024.0f);
+			ImGui::Text("Tick Arena: %.1f KB used, %.1f KB reserved", frame.tickArenaBytes / 1024.0f, corePtr->getTickArena().getCapacity() / 1024.0f);
+			ImGui::Text("Instance Buffer: %.1f KB used, %.1f KB peak, %.1f KB allocated", frame.instanceBufferBytes / 1024.0f,
+				frame.instanceBufferPeakBytes / 1024.0f, frame.instanceBufferAllocatedBytes / 1024.0f);
+
+			//Heap usage per tag, the allocation rate is averaged over the history
+			float averageFrameMs = metrics->frameTimeMs().average();
+			ImGui::Columns(4, "MemoryTags");
+			ImGui::Text("Tag"); ImGui::NextColumn();
+			ImGui::Text("Current (KB)"); ImGui::NextColumn();
+			ImGui::Text("Peak (KB)"); ImGui::NextColumn();
+			ImGui::Text("Allocations/s"); ImGui::NextColumn();
+			ImGui::Separator();
+			for (std::size_t i = 0; i < EngineMemory::MEMORY_TAG_COUNT; i++)
+			{
+				EngineMemory::MemoryTag tag = static_cast<EngineMemory::MemoryTag>(i);
+				EngineMemory::MemoryTagStats stats = EngineMemory::MemoryTracker::getTagStats(tag);
+				float allocationRate = averageFrameMs > 0.0f ? metrics->allocationsPerFrame(tag).average() * 1000.0f / averageFrameMs : 0.0f;
+				ImGui::Text("%s", EngineMemory::MemoryTracker::getTagName(tag)); ImGui::NextColumn();
+				ImGui::Text("%.1f", stats.currentBytes / 1024.0); ImGui::NextColumn();
+				ImGui::Text("%.1f", stats.peakBytes / 1024.0); ImGui::NextColumn();
+				ImGui::Text("%.0f", allocationRate); ImGui::NextColumn();
+			}
+			ImGui::Columns(1);
+		}
+
+		ImGui::End();
+	}
+
 	//Auxilliary function for use by the resource browser to display all directories and provide a button to select them
 	//Uses a typically C++17 and above library Filesystem, however the std::experimental library is used to enable use in C++14
 	void GuiElement::displayDirectories() {
@@ -1096,11 +1482,23 @@ namespace CoreGuiElement
 		ImGui::EndChild();
 	}
 
+	bool GuiElement::isInteracting() const
+	{
+		if (!ImGui::GetCurrentContext())
+		{
+			return false;
+		}
+		bool mouseDown = ImGui::IsMouseDown(ImGuiMouseButton_Left) || ImGui::IsMouseDown(ImGuiMouseButton_Right) || ImGui::IsMouseDown(ImGuiMouseButton_Middle);
+		return mouseDown || ImGui::IsAnyItemActive() || ImGui::GetIO().WantTextInput;
+	}
+
 	//Upon termination, shutdown Dear ImGui and destroy this Dear ImGui context, to deallocate resources
 	void GuiElement::terminate()
 	{
 		ImGui_ImplOpenGL3_Shutdown();
 		ImGui_ImplSDL2_Shutdown();
 		ImGui::DestroyContext();
+		//The context doesn't own the shared font atlas, so release it after the context
+		m_fontAtlas.reset();
 	}
 }
\ No newline at end of file
@@ -1,4 +1,4 @@
-//------- Event Element -----
+//------- Log Element -------
 //Simple Log To File
 //For The Sol Core Engine
 //---------------------------
@@ -15,9 +15,21 @@ namespace CoreLogElement
 	}
 
 	//Call after Core's attachElement(elementName) has been called
-	//Pass any required parameters for initialization, filename for the log file
-	bool LogElement::initialize(const std::string& logfileName)
+	//Pass any required parameters for initialization, filename for the log file, and whether to write a binary log
+	bool LogElement::initialize(const std::string& logfileName, bool binary)
 	{
+		//A binary log is written by the log pipeline itself, spdlog isn't needed
+		if (binary)
+		{
+			if (!EngineLog::Logger::startBinary(logfileName))
+			{
+				SOL_LOG_ERROR("[Log] Failed To Open Binary Log: %s", logfileName.c_str());
+				return false;
+			}
+			SOL_LOG_INFO("[Log] Successfully Initialized Binary Log");
+			return true;
+		}
+
 		try {
 			//Create file sink to log messages to the text file
 			//Truncated on opening
@@ -29,29 +41,50 @@ namespace CoreLogElement
 			logger->flush_on(spdlog::level::err);
 			//Register logger to spdlog
 			spdlog::set_default_logger(logger);
-			logger->info("[Log] Successfully Initialized Logger");
-			return true;
 		} catch (const std::exception& e) { //Catch any spdlog exceptions if spdlog throws
 			//e.what() returns a C-style string that displays a description of the exception
-			//std::cerr since logger not present
-			std::cerr << e.what() << std::endl;
+			//Logged to the console since the log pipeline has no sink yet
+			SOL_LOG_ERROR("[Log] Failed To Initialize Logger: %s", e.what());
 			return false;
 		}
+
+		//Direct the log pipeline to the logger, only the pipeline's background thread writes to it
+		//Messages keep the time they were logged at, rather than the time they were written
+		auto sinkLogger = logger;
+		EngineLog::Logger::start([sinkLogger](EngineLog::LogLevel level, u64 timestampNs, const char* message, std::size_t length)
+		{
+			spdlog::level::level_enum spdlogLevel = spdlog::level::info;
+			switch (level)
+			{
+			case EngineLog::LogLevel::Trace: spdlogLevel = spdlog::level::trace; break;
+			case EngineLog::LogLevel::Info: spdlogLevel = spdlog::level::info; break;
+			case EngineLog::LogLevel::Warn: spdlogLevel = spdlog::level::warn; break;
+			case EngineLog::LogLevel::Error: spdlogLevel = spdlog::level::err; break;
+			}
+			spdlog::log_clock::time_point time(std::chrono::duration_cast<spdlog::log_clock::duration>(std::chrono::nanoseconds(timestampNs)));
+			sinkLogger->log(time, spdlog::source_loc{}, spdlogLevel, spdlog::string_view_t(message, length));
+		});
+		SOL_LOG_INFO("[Log] Successfully Initialized Logger");
+		return true;
 	}
 
-	//Use logger to log messages appropriately (either info or error)
+	//Log messages appropriately (either info or error)
+	//Until the logger is initialized (e.g. whilst the Core is still attaching Elements), the log pipeline writes messages to the console instead
 	void LogElement::logInfo(const std::string& msg)
 	{
-		logger->info(msg);
+		SOL_LOG_INFO("%s", msg.c_str());
 	}
 	void LogElement::logError(const std::string& msg)
 	{
-		logger->error(msg);
+		SOL_LOG_ERROR("%s", msg.c_str());
 	}
 
 	void LogElement::terminate()
 	{
-		//Clean up logger resources
+		//Write any remaining messages, after which messages go to the console again
+		EngineLog::Logger::stop();
+		//Clean up logger resources (there are none for a binary log)
+		logger.reset();
 		spdlog::shutdown();
 	}
-}
\ No newline at end of file
+}
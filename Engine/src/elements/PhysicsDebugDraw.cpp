@@ -0,0 +1,72 @@
+//------- Physics Debug -----
+//Box2D Debug Drawing
+//For The Sol Core Engine
+//---------------------------
+
+#include "physics/PhysicsDebugDraw.h"
+
+#include "Config.h"
+
+namespace CorePhysicsElement
+{
+	PhysicsDebugDraw::PhysicsDebugDraw(EngineDebugDraw::DebugDraw& debugDraw, float scalingFactor) : m_debugDraw(debugDraw), m_scalingFactor(scalingFactor),
+		m_offset(ApplicationConfig::Config::screenWidth / 2.0f, ApplicationConfig::Config::screenHeight / 2.0f)
+	{
+	}
+
+	glm::vec2 PhysicsDebugDraw::toPixels(const b2Vec2& position) const
+	{
+		return glm::vec2(position.x, position.y) * m_scalingFactor + m_offset;
+	}
+
+	u32 PhysicsDebugDraw::toColor(const b2Color& color)
+	{
+		return EngineDebugDraw::DebugDraw::color(color.r, color.g, color.b, color.a);
+	}
+
+	void PhysicsDebugDraw::DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color)
+	{
+		u32 packed = toColor(color);
+		for (int32 i = 0; i < vertexCount; i++)
+		{
+			m_debugDraw.line(toPixels(vertices[i]), toPixels(vertices[(i + 1) % vertexCount]), packed);
+		}
+	}
+
+	void PhysicsDebugDraw::DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color)
+	{
+		DrawPolygon(vertices, vertexCount, color);
+	}
+
+	void PhysicsDebugDraw::DrawCircle(const b2Vec2& center, float radius, const b2Color& color)
+	{
+		m_debugDraw.circle(toPixels(center), radius * m_scalingFactor, toColor(color));
+	}
+
+	void PhysicsDebugDraw::DrawSolidCircle(const b2Vec2& center, float radius, const b2Vec2& axis, const b2Color& color)
+	{
+		//The axis line shows the body's rotation, which an outline alone wouldn't
+		u32 packed = toColor(color);
+		m_debugDraw.circle(toPixels(center), radius * m_scalingFactor, packed);
+		m_debugDraw.line(toPixels(center), toPixels(center + radius * axis), packed);
+	}
+
+	void PhysicsDebugDraw::DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color)
+	{
+		m_debugDraw.line(toPixels(p1), toPixels(p2), toColor(color));
+	}
+
+	void PhysicsDebugDraw::DrawTransform(const b2Transform& xf)
+	{
+		//Local x axis in red and y axis in green, 0.4 metres long
+		const float axisLength = 0.4f;
+		m_debugDraw.line(toPixels(xf.p), toPixels(xf.p + axisLength * xf.q.GetXAxis()), EngineDebugDraw::DebugDraw::color(1.0f, 0.0f, 0.0f));
+		m_debugDraw.line(toPixels(xf.p), toPixels(xf.p + axisLength * xf.q.GetYAxis()), EngineDebugDraw::DebugDraw::color(0.0f, 1.0f, 0.0f));
+	}
+
+	void PhysicsDebugDraw::DrawPoint(const b2Vec2& p, float size, const b2Color& color)
+	{
+		//Box2D gives point sizes in pixels
+		m_debugDraw.point(toPixels(p), size, toColor(color));
+	}
+}
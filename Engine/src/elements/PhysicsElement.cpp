@@ -4,6 +4,7 @@
 //---------------------------
 
 #include "physics/PhysicsElement.h"
+#include "physics/PhysicsDebugDraw.h"
 
 #include "Core.h"
 
@@ -20,15 +21,6 @@ namespace CorePhysicsElement
 	//Pass any required parameters for initialization, none
 	bool PhysicsElement::initialize()
 	{
-		auto corePtr = m_core.lock();
-		if (corePtr)
-		{
-			if (corePtr->getLogElement())
-			{
-				m_logElementAttached = true;
-			}
-		}
-
 		//Set up gravity, current default is the Earth's gravity
 		b2Vec2 gravity(0.0f, -9.81f);
 
@@ -41,15 +33,7 @@ namespace CorePhysicsElement
 		//Enable auto-clearing of forces after each simulation step
 		m_world->SetAutoClearForces(true);
 
-		if (m_logElementAttached)
-		{
-			if (corePtr)
-			{
-				corePtr->getLogElement()->logInfo("[Physics] Successfully Initialized");
-			}
-			return true;
-		}
-		std::cout << "[Physics] Successfully Initialized" << std::endl;
+		SOL_LOG_INFO("[Physics] Successfully Initialized");
 		return true;
 	}
 
@@ -70,16 +54,7 @@ namespace CorePhysicsElement
 		}
 
 		//If no world found, log error and return nullptr
-		auto corePtr = m_core.lock();
-		if (m_logElementAttached)
-		{
-			//Get LogElement to log error
-			if (corePtr)
-			{
-				corePtr->getLogElement()->logError("[Physics] Failed To Get World: nullptr found");
-			}
-		}
-		std::cerr << "[Physics] Failed To Get World: nullptr found" << std::endl;
+		SOL_LOG_ERROR("[Physics] Failed To Get World: nullptr found");
 		return nullptr;
 	}
 
@@ -96,4 +71,44 @@ namespace CorePhysicsElement
 			body = nextBody;
 		}
 	}
-}
\ No newline at end of file
+
+	void PhysicsElement::drawDebug(EngineDebugDraw::DebugDraw& debugDraw, float scalingFactor)
+	{
+		if (!m_world) return;
+
+		PhysicsDebugDraw physicsDebugDraw(debugDraw, scalingFactor);
+		u32 flags = 0;
+		if (debugDraw.isEnabled(EngineDebugDraw::DRAW_PHYSICS_SHAPES)) { flags |= b2Draw::e_shapeBit; }
+		if (debugDraw.isEnabled(EngineDebugDraw::DRAW_PHYSICS_JOINTS)) { flags |= b2Draw::e_jointBit; }
+		if (debugDraw.isEnabled(EngineDebugDraw::DRAW_PHYSICS_AABBS)) { flags |= b2Draw::e_aabbBit; }
+		if (debugDraw.isEnabled(EngineDebugDraw::DRAW_PHYSICS_CENTRES_OF_MASS)) { flags |= b2Draw::e_centerOfMassBit; }
+		if (flags)
+		{
+			physicsDebugDraw.SetFlags(flags);
+			m_world->SetDebugDraw(&physicsDebugDraw);
+			m_world->DebugDraw();
+			//The PhysicsDebugDraw only lives for this call
+			m_world->SetDebugDraw(nullptr);
+		}
+
+		//Box2D doesn't draw contacts itself, so each touching contact's points and normal are drawn here
+		if (debugDraw.isEnabled(EngineDebugDraw::DRAW_PHYSICS_CONTACTS))
+		{
+			u32 pointColor = EngineDebugDraw::DebugDraw::color(1.0f, 1.0f, 0.0f);
+			u32 normalColor = EngineDebugDraw::DebugDraw::color(0.0f, 1.0f, 1.0f);
+			const float normalLength = 0.3f; //Metres
+			for (b2Contact* contact = m_world->GetContactList(); contact != nullptr; contact = contact->GetNext())
+			{
+				if (!contact->IsTouching()) { continue; }
+				b2WorldManifold worldManifold;
+				contact->GetWorldManifold(&worldManifold);
+				for (int32 i = 0; i < contact->GetManifold()->pointCount; i++)
+				{
+					const b2Vec2& point = worldManifold.points[i];
+					debugDraw.point(physicsDebugDraw.toPixels(point), 6.0f, pointColor);
+					debugDraw.line(physicsDebugDraw.toPixels(point), physicsDebugDraw.toPixels(point + normalLength * worldManifold.normal), normalColor);
+				}
+			}
+		}
+	}
+}
@@ -6,7 +6,12 @@
 #include "render/RenderElement.h"
 
 #include "Core.h"
+#include "systems/GLRenderDevice.h"
 
+//C++ libraries
+#include <algorithm>
+#include <cmath>
+#include <utility>
 
 namespace CoreRenderElement
 {
@@ -22,27 +27,10 @@ namespace CoreRenderElement
 	//Here those parameters are the window name, the width and height of the window to be created, any SDL window flags to determine window properties, and whether vsync should be used
 	bool RenderElement::initialize(const std::string& windowName, float width, float height, SDL_WindowFlags window_flags, int vsync)
 	{
-		auto corePtr = m_core.lock();
-		if (corePtr)
-		{
-			if (corePtr->getLogElement())
-			{
-				m_logElementAttached = true;
-			}
-		}
-
 		//Initialize SDL
 		if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_GAMECONTROLLER) != 0)
 		{
-			if (m_logElementAttached)
-			{
-				if (corePtr)
-				{
-					corePtr->getLogElement()->logError(std::string("[Render] Failed To Initialize SDL") + SDL_GetError());
-				}
-				return false;
-			}
-			std::cerr << "[Render] Failed To Initialize SDL" << std::endl;
+			SOL_LOG_ERROR("[Render] Failed To Initialize SDL: %s", SDL_GetError());
 			return false;
 		}
 		else
@@ -64,15 +52,7 @@ namespace CoreRenderElement
 
 			if (!m_sdlWindow)
 			{
-				if (m_logElementAttached)
-				{
-					if (corePtr)
-					{
-						corePtr->getLogElement()->logError(std::string("[Render] Failed To Create SDL Window") + SDL_GetError());
-					}
-					return false;
-				}
-				std::cerr << "[Render] Failed To Create SDL Window" << std::endl;
+				SOL_LOG_ERROR("[Render] Failed To Create SDL Window: %s", SDL_GetError());
 				return false;
 			}
 
@@ -85,15 +65,7 @@ namespace CoreRenderElement
 
 			//Setup function pointers
 			if (!gladLoadGLLoader((GLADloadproc)SDL_GL_GetProcAddress)) {
-				if (m_logElementAttached)
-				{
-					if (corePtr)
-					{
-						corePtr->getLogElement()->logError(std::string("[Render] Failed To Create OpenGL Context") + SDL_GetError());
-					}
-					return false;
-				}
-				std::cerr << "[Render] Failed To Create OpenGL Context" << std::endl;
+				SOL_LOG_ERROR("[Render] Failed To Create OpenGL Context: %s", SDL_GetError());
 				return false;
 			}
 		}
@@ -101,17 +73,16 @@ namespace CoreRenderElement
 		//Enable depth testing
 		glEnable(GL_DEPTH_TEST);
 
+		//The game view itself is created by the first beginGameView, once the screen size is known
+		m_gpuTimer.create();
+
+		//Everything else creates and draws through the OpenGL device from here on, which times its sprite and debug line passes with the GPU timer
+		auto corePtr = m_core.lock();
+		if (corePtr) { corePtr->setRenderDevice(std::unique_ptr<EcsRenderSystem::RenderDevice>(new EcsRenderSystem::GLRenderDevice(&m_gpuTimer))); }
+
 		//If SDL initialized successfully, SDL window created successfully, and OpenGL context created successfully
 		//then log success and return true
-		if (m_logElementAttached)
-		{
-			if (corePtr)
-			{
-				corePtr->getLogElement()->logInfo("[Render] Successfully Initialized");
-			}
-			return true;
-		}
-		std::cout << "[Render] Successfully Initialized" << std::endl;
+		SOL_LOG_INFO("[Render] Successfully Initialized");
 		return true;
 	}
 
@@ -122,9 +93,360 @@ namespace CoreRenderElement
 		glClear(GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
 	}
 
+	void RenderElement::beginGameView()
+	{
+		if (!m_renderThreadRunning)
+		{
+			startGameView();
+		}
+	}
+
+	void RenderElement::endGameView()
+	{
+		if (m_renderThreadRunning)
+		{
+			acquireContext();
+		}
+		presentGameView();
+	}
+
+	void RenderElement::startGameView()
+	{
+		if (!m_dynamicResolution)
+		{
+			m_dynamicScale = 1.0f;
+		}
+		//Sized for the render scale, and resized only when the screen size or render scale changes
+		float renderScale = m_renderScale;
+		int textureWidth = std::max(1, static_cast<int>(std::lround(ApplicationConfig::Config::screenWidth * renderScale)));
+		int textureHeight = std::max(1, static_cast<int>(std::lround(ApplicationConfig::Config::screenHeight * renderScale)));
+		if (textureWidth != m_gameTextureWidth || textureHeight != m_gameTextureHeight)
+		{
+			if (!createGameView(textureWidth, textureHeight))
+			{
+				destroyGameView();
+			}
+			//Not retried until the size changes again, if it failed
+			m_gameTextureWidth = textureWidth;
+			m_gameTextureHeight = textureHeight;
+		}
+
+		//Each game view begins a frame of GPU timings, the oldest frame is read back if the GPU has finished with it
+		//Dynamic resolution follows the sprite pass, which brackets only the replay of the frame's command list
+		//Without the render thread the command list is replayed at the end of the frame, so a timing from here to there would include the simulation
+		if (m_gpuTimer.beginFrame(m_dynamicScale))
+		{
+			updateDynamicResolution(m_gpuTimer.getLatestMs(EngineMetrics::GpuPass::Sprites), m_gpuTimer.getLatestTag());
+		}
+
+		if (!m_gameFramebuffer)
+		{
+			//Without a game view the scene is rendered straight to the window as it was before there was one
+			m_gameView.texture = 0;
+			m_gameView.width = static_cast<int>(ApplicationConfig::Config::screenWidth);
+			m_gameView.height = static_cast<int>(ApplicationConfig::Config::screenHeight);
+			m_gameView.u = 1.0f;
+			m_gameView.v = 1.0f;
+			m_gameView.resolutionScale = 1.0f;
+			int drawableWidth = 0;
+			int drawableHeight = 0;
+			SDL_GL_GetDrawableSize(m_sdlWindow, &drawableWidth, &drawableHeight);
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			glViewport(0, 0, drawableWidth, drawableHeight);
+			m_gpuTimer.beginPass(EngineMetrics::GpuPass::Clear);
+			clearScreen();
+			m_gpuTimer.endPass(EngineMetrics::GpuPass::Clear);
+			return;
+		}
+
+		//Dynamic resolution renders to the region of the texture from its origin, the region is what's presented
+		m_gameView.texture = m_gameColorTexture;
+		m_gameView.width = std::max(1, static_cast<int>(std::lround(m_gameTextureWidth * m_dynamicScale)));
+		m_gameView.height = std::max(1, static_cast<int>(std::lround(m_gameTextureHeight * m_dynamicScale)));
+		m_gameView.u = static_cast<float>(m_gameView.width) / m_gameTextureWidth;
+		m_gameView.v = static_cast<float>(m_gameView.height) / m_gameTextureHeight;
+		m_gameView.resolutionScale = renderScale * m_dynamicScale;
+
+		glBindFramebuffer(GL_FRAMEBUFFER, m_gameFramebuffer);
+		glViewport(0, 0, m_gameView.width, m_gameView.height);
+		//Only the region rendered to is cleared, so a lower resolution saves fill rate on the clear as well
+		glEnable(GL_SCISSOR_TEST);
+		glScissor(0, 0, m_gameView.width, m_gameView.height);
+		m_gpuTimer.beginPass(EngineMetrics::GpuPass::Clear);
+		clearScreen();
+		m_gpuTimer.endPass(EngineMetrics::GpuPass::Clear);
+		glDisable(GL_SCISSOR_TEST);
+	}
+
+	void RenderElement::presentGameView()
+	{
+		if (!m_gameFramebuffer)
+		{
+			//The scene is already in the window
+			return;
+		}
+
+		int drawableWidth = 0;
+		int drawableHeight = 0;
+		SDL_GL_GetDrawableSize(m_sdlWindow, &drawableWidth, &drawableHeight);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(0, 0, drawableWidth, drawableHeight);
+		clearScreen();
+		if (m_presentGameView)
+		{
+			//Upscaled to the window with bilinear filtering
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, m_gameFramebuffer);
+			glBlitFramebuffer(0, 0, m_gameView.width, m_gameView.height, 0, 0, drawableWidth, drawableHeight, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+		}
+	}
+
+	bool RenderElement::createGameView(int width, int height)
+	{
+		if (!m_gameFramebuffer)
+		{
+			glGenFramebuffers(1, &m_gameFramebuffer);
+			glGenTextures(1, &m_gameColorTexture);
+			glGenRenderbuffers(1, &m_gameDepthStencil);
+		}
+
+		//Linear filtering, as the Editor's Game window samples it directly to upscale it
+		glBindTexture(GL_TEXTURE_2D, m_gameColorTexture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		glBindRenderbuffer(GL_RENDERBUFFER, m_gameDepthStencil);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, m_gameFramebuffer);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_gameColorTexture, 0);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_gameDepthStencil);
+		GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		if (status != GL_FRAMEBUFFER_COMPLETE)
+		{
+			SOL_LOG_ERROR("[Render] Failed To Create %dx%d Game View: framebuffer status 0x%x, rendering to the window instead", width, height, status);
+			return false;
+		}
+		return true;
+	}
+
+	void RenderElement::destroyGameView()
+	{
+		if (m_gameFramebuffer)
+		{
+			glDeleteFramebuffers(1, &m_gameFramebuffer);
+			glDeleteTextures(1, &m_gameColorTexture);
+			glDeleteRenderbuffers(1, &m_gameDepthStencil);
+		}
+		m_gameFramebuffer = 0;
+		m_gameColorTexture = 0;
+		m_gameDepthStencil = 0;
+		m_gameTextureWidth = 0;
+		m_gameTextureHeight = 0;
+	}
+
+	void RenderElement::updateDynamicResolution(float gpuMs, float renderedScale)
+	{
+		m_gameView.gpuFrameMs = gpuMs;
+		if (!m_dynamicResolution)
+		{
+			return;
+		}
+		//Timings are read back frames after they were rendered, so the scale is adjusted from the scale the timed game view was rendered at
+		float targetMs = m_targetGpuFrameMs;
+		if (gpuMs > targetMs)
+		{
+			//Fill cost goes with the area rendered, so the scale is lowered by the square root of how far over the target the GPU was
+			float scale = renderedScale * std::sqrt(targetMs / gpuMs);
+			m_dynamicScale = std::min(m_dynamicScale, std::max(scale, static_cast<float>(MIN_DYNAMIC_SCALE)));
+		}
+		else if (gpuMs < targetMs * 0.8f)
+		{
+			//Raised in small steps, and only once there is clear headroom, so it settles rather than oscillating about the target
+			m_dynamicScale = std::max(m_dynamicScale, std::min(renderedScale + 0.02f, 1.0f));
+		}
+	}
+
+	void RenderElement::setPresentGameView(bool present)
+	{
+		m_presentGameView = present;
+	}
+
+	const GameViewInfo& RenderElement::getGameView() const
+	{
+		return m_gameView;
+	}
+
+	void RenderElement::setRenderScale(float scale)
+	{
+		m_renderScale = std::min(std::max(scale, static_cast<float>(MIN_RENDER_SCALE)), 1.0f);
+	}
+
+	float RenderElement::getRenderScale() const
+	{
+		return m_renderScale;
+	}
+
+	void RenderElement::setDynamicResolution(bool enabled)
+	{
+		//The dynamic scale is reset when the next game view is started, as it may be being rendered on the render thread
+		m_dynamicResolution = enabled;
+	}
+
+	bool RenderElement::isDynamicResolutionEnabled() const
+	{
+		return m_dynamicResolution;
+	}
+
+	void RenderElement::setTargetGpuFrameMs(float targetMs)
+	{
+		m_targetGpuFrameMs = std::max(targetMs, 0.1f);
+	}
+
+	float RenderElement::getTargetGpuFrameMs() const
+	{
+		return m_targetGpuFrameMs;
+	}
+
 	//Swap the buffers which is useful as OpenGL renders the next frame in the background while displaying the current frame, swap to make this next frame visible
+	//Then hand what was submitted this frame to the render thread, if it is enabled
 	void RenderElement::swapBuffers() {
+		acquireContext();
 		SDL_GL_SwapWindow(m_sdlWindow);
+		applyRenderThreadSetting();
+		dispatchGameView();
+	}
+
+	void RenderElement::setRenderThreadEnabled(bool enabled)
+	{
+		m_renderThreadRequested = enabled;
+	}
+
+	bool RenderElement::isRenderThreadEnabled() const
+	{
+		return m_renderThreadRequested;
+	}
+
+	void RenderElement::submitGameView(std::function<void()> job)
+	{
+		if (!m_renderThreadRunning)
+		{
+			job();
+			return;
+		}
+		m_pendingJobs.push_back(std::move(job));
+	}
+
+	void RenderElement::acquireContext()
+	{
+		if (!m_contextOnRenderThread)
+		{
+			return;
+		}
+		{
+			SOL_PROFILE_ZONE("Render::WaitForRenderThread");
+			std::unique_lock<std::mutex> lock(m_renderMutex);
+			m_renderCondition.wait(lock, [this] { return !m_renderJobsInFlight; });
+		}
+		SDL_GL_MakeCurrent(m_sdlWindow, m_glContext);
+		m_contextOnRenderThread = false;
+	}
+
+	void RenderElement::discardGameView()
+	{
+		acquireContext();
+		m_pendingJobs.clear();
+	}
+
+	void RenderElement::applyRenderThreadSetting()
+	{
+		if (m_renderThreadRequested == m_renderThreadRunning)
+		{
+			return;
+		}
+		if (m_renderThreadRequested)
+		{
+			m_stopRenderThread = false;
+			m_renderThread = std::thread(&RenderElement::renderThreadLoop, this);
+			m_renderThreadRunning = true;
+			SOL_LOG_INFO("[Render] Render Thread Started");
+			return;
+		}
+
+		//The context is already back on the main thread, as the buffers have just been swapped
+		{
+			std::lock_guard<std::mutex> lock(m_renderMutex);
+			m_stopRenderThread = true;
+		}
+		m_renderCondition.notify_all();
+		m_renderThread.join();
+		m_renderThreadRunning = false;
+		//What was submitted this frame is rendered here rather than dropped, since it may upload data later frames draw from
+		if (!m_pendingJobs.empty())
+		{
+			startGameView();
+			for (auto& job : m_pendingJobs)
+			{
+				job();
+			}
+			m_pendingJobs.clear();
+		}
+		SOL_LOG_INFO("[Render] Render Thread Stopped");
+	}
+
+	void RenderElement::dispatchGameView()
+	{
+		if (!m_renderThreadRunning || m_pendingJobs.empty())
+		{
+			return;
+		}
+		//Released here, as a context can only be current on one thread at a time
+		SDL_GL_MakeCurrent(m_sdlWindow, nullptr);
+		m_contextOnRenderThread = true;
+		{
+			std::lock_guard<std::mutex> lock(m_renderMutex);
+			m_renderJobs.swap(m_pendingJobs);
+			m_renderJobsInFlight = true;
+		}
+		m_renderCondition.notify_all();
+	}
+
+	void RenderElement::renderThreadLoop()
+	{
+		EngineProfiler::Profiler::setThreadName("Render");
+		SOL_MEMORY_TAG(EngineMemory::MemoryTag::Render);
+		std::unique_lock<std::mutex> lock(m_renderMutex);
+		while (true)
+		{
+			m_renderCondition.wait(lock, [this] { return m_renderJobsInFlight || m_stopRenderThread; });
+			if (!m_renderJobsInFlight)
+			{
+				return;
+			}
+			lock.unlock();
+			{
+				SOL_PROFILE_ZONE("Render::GameView");
+				SDL_GL_MakeCurrent(m_sdlWindow, m_glContext);
+				startGameView();
+				for (auto& job : m_renderJobs)
+				{
+					job();
+				}
+				//Submitted before the context is released, so the main thread's commands are queued after everything rendered here
+				glFlush();
+				SDL_GL_MakeCurrent(m_sdlWindow, nullptr);
+				m_renderJobs.clear();
+			}
+			lock.lock();
+			m_renderJobsInFlight = false;
+			m_renderCondition.notify_all();
+		}
 	}
 
 	//Set the window size based upon the given parameters
@@ -138,8 +460,20 @@ namespace CoreRenderElement
 	//Cleanup by deallocating SDL and OpenGL resources
 	void RenderElement::terminate()
 	{
-		//Cleanup first, so remove m_sdlWindow and m_glContext
+		//Stop the render thread first, dropping anything submitted for it, so the context is back on this thread
+		discardGameView();
+		if (m_renderThreadRunning)
+		{
+			m_renderThreadRequested = false;
+			applyRenderThreadSetting();
+		}
+		//Cleanup first, so remove the game view, then m_sdlWindow and m_glContext
 		if (m_glContext) {
+			//The OpenGL device's objects are deleted before the context they belong to
+			auto corePtr = m_core.lock();
+			if (corePtr) { corePtr->setRenderDevice(nullptr); }
+			destroyGameView();
+			m_gpuTimer.destroy();
 			SDL_GL_DeleteContext(m_glContext);
 			m_glContext = 0;
 		}
@@ -161,16 +495,7 @@ namespace CoreRenderElement
 		}
 
 		//If no SDL window found, log error and return nullptr
-		auto corePtr = m_core.lock();
-		if (m_logElementAttached)
-		{
-			//Get LogElement to log error
-			if (corePtr)
-			{
-				corePtr->getLogElement()->logError("[Render] Failed To Get SDL Window: nullptr found");
-			}
-		}
-		std::cerr << "[Render] Failed To Get SDL Window: nullptr found" << std::endl;
+		SOL_LOG_ERROR("[Render] Failed To Get SDL Window: nullptr found");
 		return nullptr;
 	}
 
@@ -184,16 +509,7 @@ namespace CoreRenderElement
 		}
 
 		//If no OpenGL context found, log error and return nullptr
-		auto corePtr = m_core.lock();
-		if (m_logElementAttached)
-		{
-			//Get LogElement to log error
-			if (corePtr)
-			{
-				corePtr->getLogElement()->logError("[Render] Failed To Get OpenGL Context: nullptr found");
-			}
-		}
-		std::cerr << "[Render] Failed To Get OpenGL Context: nullptr found" << std::endl;
+		SOL_LOG_ERROR("[Render] Failed To Get OpenGL Context: nullptr found");
 		return nullptr;
 	}
 }
\ No newline at end of file
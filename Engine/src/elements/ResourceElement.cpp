@@ -6,8 +6,13 @@
 #include "resource/ResourceElement.h"
 
 #include "Core.h"
+#include "util/MemoryTracker.h"
 
 //External library STB_IMAGE
+//Decoded images are allocated through the Memory Tracker, tagged as Resource allocations
+#define STBI_MALLOC(size) EngineMemory::MemoryTracker::allocate(size, EngineMemory::MemoryTag::Resource)
+#define STBI_REALLOC(ptr, size) EngineMemory::MemoryTracker::reallocate(ptr, size, EngineMemory::MemoryTag::Resource)
+#define STBI_FREE(ptr) EngineMemory::MemoryTracker::free(ptr)
 #define STB_IMAGE_IMPLEMENTATION
 #include "util/stb_image.h"
 
@@ -24,21 +29,7 @@ namespace CoreResourceElement
 	//Pass any required parameters for initialization, none
 	bool ResourceElement::initialize()
 	{
-		auto corePtr = m_core.lock();
-		if (corePtr)
-		{
-			if (corePtr->getLogElement())
-			{
-				m_logElementAttached = true;
-			}
-		}
-
-		if (m_logElementAttached)
-		{
-			corePtr->getLogElement()->logInfo("[Resource] Successfully Initialized");
-			return true;
-		}
-		std::cout << "[Resource] Successfully Initialized" << std::endl;
+		SOL_LOG_INFO("[Resource] Successfully Initialized");
 		return true;
 	}
 
@@ -54,22 +45,16 @@ namespace CoreResourceElement
 			return it->second;
 		}
 		//If the resource is not in the cache, return nullptr
-		if (m_logElementAttached)
-		{
-			auto corePtr = m_core.lock();
-			if (corePtr)
-			{
-				corePtr->getLogElement()->logError("[Resource] Failed to Get Resource: " + filePath);
-			}
-			return nullptr;
-		}
-		std::cerr << "[Resource] Failed to Get Resource: " << filePath << std::endl;
+		SOL_LOG_ERROR("[Resource] Failed to Get Resource: %s", filePath.c_str());
 		return nullptr;
 	}
 
 	//Load an image from a file path, returns a TextureResource object
 	std::shared_ptr<Resource> ResourceElement::loadImage(const std::string& filePath)
 	{
+		SOL_PROFILE_FUNCTION();
+		SOL_MEMORY_TAG(EngineMemory::MemoryTag::Resource);
+
 		//Check if the image is already in the cache
 		auto it = m_resourceCache.find(filePath);
 		//If the image is in the cache, increment the refCount and return the resource
@@ -86,29 +71,23 @@ namespace CoreResourceElement
 		stbi_set_flip_vertically_on_load(true);
 		unsigned char* data = stbi_load(filePath.c_str(), &width, &height, &nrChannels, 0);
 
-		//Create the texture with OpenGL and get the texture ID
-		GLuint textureID;
-		//Generate the texture
-		glGenTextures(1, &textureID);
-		//Bind the texture
-		glBindTexture(GL_TEXTURE_2D, textureID);
-
-		//Texture filtering and wrapping
-		//linear filtering is smooth but provide option for gl_nearest if making pixel game
-		//for now clamp to edge is fine which may stretch edges hypothetically but for now that's not an issue
-		//currently not making use of mipmaps, to implement shortly
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		//The texture is created (and packed into the atlas) on this thread, so the OpenGL context is taken back if the render thread has it
+		auto corePtr = m_core.lock();
+		if (!corePtr)
+		{
+			stbi_image_free(data);
+			SOL_LOG_ERROR("[Resource] Failed to Load New Image: %s", filePath.c_str());
+			return nullptr;
+		}
+		corePtr->acquireGLContext();
+		EcsRenderSystem::RenderDevice& device = corePtr->getRenderDevice();
 
-		//Set the internal format and format parameters based on the number of channels
-		GLenum internalFormat = (nrChannels == 4) ? GL_RGBA : GL_RGB;
-		GLenum format = internalFormat;
+		//Create the texture through the render device, with a full mipmap chain, and get the texture ID
+		//Clamp to edge and linear filtering, see the device's createTexture
+		GLuint textureID = device.createTexture(width, height, nrChannels, data, EcsRenderSystem::RenderDevice::ALL_MIP_LEVELS);
 
-		//Set the texture parameters and generate mipmaps
-		glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-		glGenerateMipmap(GL_TEXTURE_2D);
+		//Also pack the image into the texture atlas if it is small enough, so sprites using it can be batched with sprites using other textures
+		m_textureAtlas.add(device, textureID, data, width, height, nrChannels);
 
 		//Free the image data
 		stbi_image_free(data);
@@ -128,35 +107,18 @@ namespace CoreResourceElement
 		//If the resource is created and stored in cache properly, return the resource
 		if (textureResource)
 		{
-			if (m_logElementAttached)
-			{
-				auto corePtr = m_core.lock();
-				if (corePtr)
-				{
-					corePtr->getLogElement()->logInfo("[Resource] Successfully Loaded New Image: " + filePath);
-				}
-				return textureResource;
-			}
-			std::cout << "[Resource] Successfully Loaded New Image: " << filePath << std::endl;
+			SOL_LOG_INFO("[Resource] Successfully Loaded New Image: %s", filePath.c_str());
 			return textureResource;
 		}
 		//If the resource is not created and stored in cache properly, return nullptr
-		if (m_logElementAttached)
-		{
-			auto corePtr = m_core.lock();
-			if (corePtr)
-			{
-				corePtr->getLogElement()->logError("[Resource] Failed to Load New Image: " + filePath);
-			}
-			return nullptr;
-		}
-		std::cerr << "[Resource] Failed to Load New Image: " << filePath << std::endl;
+		SOL_LOG_ERROR("[Resource] Failed to Load New Image: %s", filePath.c_str());
 		return nullptr;
 	}
 
 	//Load a shader from a file path, returns a ShaderResource object
 	std::shared_ptr<ShaderResource> ResourceElement::loadShader(const std::string& vertexPath, const std::string& fragmentPath)
 	{
+		SOL_MEMORY_TAG(EngineMemory::MemoryTag::Resource);
 		//Check if the shader is already in the cache
 		std::string combinedPath = vertexPath + "_" + fragmentPath;
 		auto it = m_resourceCache.find(combinedPath);
@@ -174,12 +136,7 @@ namespace CoreResourceElement
 		{
 			if (!corePtr->getShaderElement())
 			{
-				if (m_logElementAttached)
-				{
-					corePtr->getLogElement()->logError("[Resource] Failed to Create Shader: " + combinedPath);
-					return nullptr;
-				}
-				std::cerr << "[Resource] Failed to Create Shader: " << combinedPath << std::endl;
+				SOL_LOG_ERROR("[Resource] Failed to Create Shader: %s", combinedPath.c_str());
 				return nullptr;
 			}
 			shaderResource->shaderProgramID = corePtr->getShaderElement()->createShaderProgram(vertexPath, fragmentPath);
@@ -193,29 +150,11 @@ namespace CoreResourceElement
 		//If the resource is created and stored in cache properly, return the resource
 		if (shaderResource)
 		{
-			if (m_logElementAttached)
-			{
-				auto corePtr = m_core.lock();
-				if (corePtr)
-				{
-					corePtr->getLogElement()->logInfo("[Resource] Successfully Loaded New Shader");
-				}
-				return std::static_pointer_cast<ShaderResource>(shaderResource);
-			}
-			std::cout << "[Resource] Successfully Loaded New Shader: " << combinedPath << std::endl;
+			SOL_LOG_INFO("[Resource] Successfully Loaded New Shader: %s", combinedPath.c_str());
 			return std::static_pointer_cast<ShaderResource>(shaderResource);
 		}
 		//If the resource is not created and stored in cache properly, return nullptr
-		if (m_logElementAttached)
-		{
-			auto corePtr = m_core.lock();
-			if (corePtr)
-			{
-				corePtr->getLogElement()->logError("[Resource] Failed to Load New Shader");
-			}
-			return nullptr;
-		}
-		std::cerr << "[Resource] Failed to Load New Shader: " << combinedPath << std::endl;
+		SOL_LOG_ERROR("[Resource] Failed to Load New Shader: %s", combinedPath.c_str());
 		return nullptr;
 	}
 
@@ -231,16 +170,7 @@ namespace CoreResourceElement
 			return std::static_pointer_cast<TextureResource>(resource);
 		}
 		//If the image was not loaded successfully, return nullptr
-		if (m_logElementAttached)
-		{
-			auto corePtr = m_core.lock();
-			if (corePtr)
-			{
-				corePtr->getLogElement()->logError("[Resource] Failed to Load Texture Resource: " + filePath);
-			}
-			return nullptr;
-		}
-		std::cerr << "[Resource] Failed to Load Texture Resource: " << filePath << std::endl;
+		SOL_LOG_ERROR("[Resource] Failed to Load Texture Resource: %s", filePath.c_str());
 		return nullptr;
 	}
 
@@ -255,18 +185,26 @@ namespace CoreResourceElement
 			it->second->refCount--;
 			//If the refCount is 0, delete the resource
 			if (it->second->refCount <= 0) {
+				auto corePtr = m_core.lock();
+				if (corePtr) { corePtr->acquireGLContext(); }
 				//Delete the texture, if resource is a texture
-				if (it->second->type == Resource::ResourceType::Texture)
+				if (corePtr && it->second->type == Resource::ResourceType::Texture)
 				{
 					//Delete the texture
 					auto textureResource = std::static_pointer_cast<TextureResource>(it->second);
-					glDeleteTextures(1, &textureResource->textureID);
+					corePtr->getRenderDevice().deleteTexture(textureResource->textureID);
+					//Once no packed texture is left the atlas's pages are deleted, reclaiming their space
+					m_textureAtlas.remove(textureResource->textureID);
+					if (m_textureAtlas.getPackedCount() == 0)
+					{
+						m_textureAtlas.clear(corePtr->getRenderDevice());
+					}
 				}
 				//Delete the shader, if resource is a shader
-				else if (it->second->type == Resource::ResourceType::Shader) {
+				else if (corePtr && it->second->type == Resource::ResourceType::Shader) {
 					//Delete the shader program
 					auto shaderResource = std::static_pointer_cast<ShaderResource>(it->second);
-					glDeleteProgram(shaderResource->shaderProgramID);
+					corePtr->getRenderDevice().deleteProgram(shaderResource->shaderProgramID);
 				}
 				//Remove resource from cache
 				m_resourceCache.erase(it);
@@ -286,6 +224,39 @@ namespace CoreResourceElement
 		m_resourceCache.clear();
 	}
 	
+	//Estimate the GPU memory used by all cached textures
+	//Each texture is width * height * channels bytes at the base level, and its full mipmap chain adds roughly a third on top
+	//Each atlas page is RGBA with two mip levels, which add five sixteenths on top
+	size_t ResourceElement::getTextureMemoryBytes() const
+	{
+		size_t pageBytes = static_cast<size_t>(TextureAtlas::PAGE_SIZE) * TextureAtlas::PAGE_SIZE * 4;
+		size_t totalBytes = m_textureAtlas.getPageCount() * (pageBytes + pageBytes * 5 / 16);
+		for (const auto& resource : m_resourceCache)
+		{
+			if (resource.second->type == Resource::ResourceType::Texture)
+			{
+				auto texture = std::static_pointer_cast<TextureResource>(resource.second);
+				size_t baseBytes = static_cast<size_t>(texture->width) * texture->height * texture->nrChannels;
+				totalBytes += baseBytes + baseBytes / 3;
+			}
+		}
+		return totalBytes;
+	}
+
+	//Count the cached textures
+	size_t ResourceElement::getTextureCount() const
+	{
+		size_t count = 0;
+		for (const auto& resource : m_resourceCache)
+		{
+			if (resource.second->type == Resource::ResourceType::Texture)
+			{
+				count++;
+			}
+		}
+		return count;
+	}
+
 	//Resource Element cleanup by clearing the resource cache to deallocate resources
 	void ResourceElement::terminate()
 	{
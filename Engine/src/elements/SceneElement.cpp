@@ -19,30 +19,14 @@ namespace CoreSceneElement
 
 	bool SceneElement::initialize()
 	{
-		auto corePtr = m_core.lock();
-		if (corePtr)
-		{
-			if (corePtr->getLogElement())
-			{
-				m_logElementAttached = true;
-			}
-		}
-
 		//Then log success and return true
-		if (m_logElementAttached)
-		{
-			if (corePtr)
-			{
-				corePtr->getLogElement()->logInfo("[Scene] Successfully Initialized");
-			}
-			return true;
-		}
-		std::cout << "[Scene] Successfully Initialized" << std::endl;
+		SOL_LOG_INFO("[Scene] Successfully Initialized");
 		return true;
 	}
 
 	//Creates a new scene by resetting the ECS and the physics world 
 	void SceneElement::newScene() {
+		SOL_MEMORY_TAG(EngineMemory::MemoryTag::Scene);
 
 		auto corePtr = m_core.lock();
 		if (corePtr)
@@ -62,6 +46,7 @@ namespace CoreSceneElement
 
 	//Serialise the ECS Element's entity-component map into a JSON file, and reset the ECS's data structure(s) appropriately
 	void SceneElement::unloadScene(const std::string& sceneFilepath) {
+		SOL_MEMORY_TAG(EngineMemory::MemoryTag::Scene);
 		m_currentScene = "";
 
 		json j; //Create JSON object to hold all ECS data
@@ -97,6 +82,9 @@ namespace CoreSceneElement
 						else if (typeIndex == typeid(SpriteComponent)) {
 							jEntity["SpriteComponent"] = serializeSprite(*std::static_pointer_cast<SpriteComponent>(component));
 						}
+						else if (typeIndex == typeid(CameraComponent)) {
+							jEntity["CameraComponent"] = serializeCamera(*std::static_pointer_cast<CameraComponent>(component));
+						}
 					}
 					j[std::to_string(entity)] = jEntity;
 				}
@@ -113,7 +101,11 @@ namespace CoreSceneElement
 
 	//Deserialise the JSON file into the ECS Element's entity-component map, and set the ECS's data structure(s) appropriately
 	void SceneElement::loadScene(const std::string& sceneFilepath) {
+		SOL_PROFILE_FUNCTION();
+		SOL_MEMORY_TAG(EngineMemory::MemoryTag::Scene);
+
 		m_currentScene = sceneFilepath;
+		m_loadCount++;
 
 		std::ifstream file(sceneFilepath);
 		if (!file.is_open()) {
@@ -135,11 +127,15 @@ namespace CoreSceneElement
 			if (ecsPtr)
 			{
 				ecsPtr->clear();  //Prepare the ECS for new scene data
+				//Entities are created anew, so any Entity saved in a Component (e.g. a camera's target) is remapped once all are loaded
+				std::unordered_map<Entity, Entity> loadedEntities;
+				std::vector<Entity> loadedCameras;
 				for (const auto& entityPair : j.items()) {
 					const std::string& entityIdStr = entityPair.key();
 					const json& components = entityPair.value();
 
 					Entity newEntity = ecsPtr->createEntity();
+					loadedEntities[static_cast<Entity>(std::stoul(entityIdStr))] = newEntity;
 					//Deserialise each component based on its type
 					for (const auto& componentPair : components.items()) {
 						const std::string& compType = componentPair.key();
@@ -165,6 +161,21 @@ namespace CoreSceneElement
 							SpriteComponent sc = deserializeSprite(compJson);
 							ecsPtr->addComponent(newEntity, sc);
 						}
+						else if (compType == "CameraComponent") {
+							CameraComponent cam = deserializeCamera(compJson);
+							ecsPtr->addComponent(newEntity, cam);
+							loadedCameras.push_back(newEntity);
+						}
+					}
+				}
+				for (Entity cameraEntity : loadedCameras) {
+					CameraComponent& camera = ecsPtr->getCamera(cameraEntity);
+					auto target = loadedEntities.find(camera.targetEntity);
+					if (target != loadedEntities.end()) {
+						camera.targetEntity = target->second;
+					}
+					else {
+						camera.follow = false;
 					}
 				}
 			}
@@ -242,7 +253,20 @@ namespace CoreSceneElement
 			{"textureFilePath", component.textureFilePath},
 			{"size", {component.size.x, component.size.y}},
 			{"color", {component.color.r, component.color.g, component.color.b, component.color.a}},
-			{"shaderProgram", component.shaderProgram} //Redundant since nowhere actually setting this value for the sprite, just here as placeholder for now
+			{"shaderProgram", component.shaderProgram}, //Redundant since nowhere actually setting this value for the sprite, just here as placeholder for now
+			{"sortingLayer", component.sortingLayer},
+			{"orderInLayer", component.orderInLayer},
+			{"blendMode", static_cast<int>(component.blendMode)}
+		};
+	}
+
+	json SceneElement::serializeCamera(const CameraComponent& component) {
+		return {
+			{"primary", component.isPrimary},
+			{"zoom", component.zoom},
+			{"follow", component.follow},
+			{"targetEntity", component.targetEntity},
+			{"followSpeed", component.followSpeed}
 		};
 	}
 
@@ -318,15 +342,28 @@ namespace CoreSceneElement
 		glm::vec2 size = glm::vec2(j["size"][0], j["size"][1]);
 		glm::vec4 color = glm::vec4(j["color"][0], j["color"][1], j["color"][2], j["color"][3]);
 		unsigned int shaderProgram = j["shaderProgram"];
+		//Scenes saved before sprites had layers load as translucent sprites on layer 0
+		int sortingLayer = j.value("sortingLayer", 0);
+		int orderInLayer = j.value("orderInLayer", 0);
+		SpriteBlendMode blendMode = static_cast<SpriteBlendMode>(j.value("blendMode", static_cast<int>(SpriteBlendMode::Translucent)));
 
 		auto corePtr = m_core.lock();
 		if (corePtr) {
 			std::shared_ptr<TextureResource> textureResource = corePtr->getResourceElement()->loadTextureResource(texturePath);
 			unsigned int textureID = textureResource ? textureResource->textureID : 0;
-			return SpriteComponent(textureID, texturePath, size, color, shaderProgram);
+			return SpriteComponent(textureID, texturePath, size, color, shaderProgram, sortingLayer, orderInLayer, blendMode);
 		}
 	}
 
+	CameraComponent SceneElement::deserializeCamera(const json& j) {
+		bool isPrimary = j["primary"];
+		float zoom = j["zoom"];
+		bool follow = j["follow"];
+		std::uint32_t targetEntity = j["targetEntity"];
+		float followSpeed = j["followSpeed"];
+		return CameraComponent(isPrimary, zoom, follow, targetEntity, followSpeed);
+	}
+
 	//No resources requiring cleanup
 	void SceneElement::terminate()
 	{
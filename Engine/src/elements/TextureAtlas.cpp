@@ -0,0 +1,196 @@
+//------- Texture Atlas -----
+//Texture Atlas Packing
+//For The Sol Core Engine
+//---------------------------
+
+#include "resource/TextureAtlas.h"
+#include "systems/RenderDevice.h"
+
+//C++ libraries
+#include <algorithm>
+#include <climits>
+
+namespace CoreResourceElement
+{
+	namespace
+	{
+		//Mip levels generated for each page, limited so PADDING still separates packed textures at the smallest level
+		const int PAGE_MAX_MIP_LEVEL = 2;
+	}
+
+	TextureAtlas::TextureAtlas()
+	{
+		//Rect 0 is the whole texture
+		m_rects.push_back(AtlasRect{ 0.0f, 0.0f, 1.0f, 1.0f });
+	}
+
+	TextureAtlas::~TextureAtlas()
+	{
+	}
+
+	bool TextureAtlas::add(EcsRenderSystem::RenderDevice& device, u32 textureID, const unsigned char* pixels, int width, int height, int channels)
+	{
+		if (!pixels || width <= 0 || height <= 0 || width > MAX_PACKED_SIZE || height > MAX_PACKED_SIZE || (channels != 3 && channels != 4))
+		{
+			return false;
+		}
+		if (m_regions.count(textureID) || m_rects.size() > 0xFFFF)
+		{
+			return false;
+		}
+
+		//Find a page with room, creating a new page if none has room
+		int paddedWidth = width + 2 * PADDING;
+		int paddedHeight = height + 2 * PADDING;
+		int x = 0, y = 0, nodeIndex = -1;
+		size_t pageIndex = 0;
+		for (; pageIndex < m_pages.size(); pageIndex++)
+		{
+			nodeIndex = findPosition(m_pages[pageIndex], paddedWidth, paddedHeight, x, y);
+			if (nodeIndex >= 0)
+			{
+				break;
+			}
+		}
+		if (nodeIndex < 0)
+		{
+			if (m_pages.size() >= static_cast<size_t>(MAX_PAGES))
+			{
+				return false;
+			}
+			m_pages.emplace_back();
+			m_pages.back().texture = createPageTexture(device);
+			m_pages.back().skyline.push_back(SkylineNode{ 0, 0, PAGE_SIZE });
+			pageIndex = m_pages.size() - 1;
+			nodeIndex = findPosition(m_pages[pageIndex], paddedWidth, paddedHeight, x, y);
+		}
+		Page& page = m_pages[pageIndex];
+		placeAt(page, static_cast<size_t>(nodeIndex), x, y, paddedWidth, paddedHeight);
+
+		//Copy the pixels into the page, which regenerates the page's mipmaps
+		device.updateTexture(page.texture, x + PADDING, y + PADDING, width, height, channels, pixels);
+
+		//Inset by half a texel so linear filtering at the texture's edges never reaches the padding
+		const float texel = 1.0f / PAGE_SIZE;
+		AtlasRect rect;
+		rect.u0 = (x + PADDING + 0.5f) * texel;
+		rect.v0 = (y + PADDING + 0.5f) * texel;
+		rect.u1 = (x + PADDING + width - 0.5f) * texel;
+		rect.v1 = (y + PADDING + height - 0.5f) * texel;
+		m_regions[textureID] = AtlasRegion{ page.texture, static_cast<u16>(m_rects.size()) };
+		m_rects.push_back(rect);
+		m_version++;
+		return true;
+	}
+
+	void TextureAtlas::remove(u32 textureID)
+	{
+		m_regions.erase(textureID);
+	}
+
+	void TextureAtlas::clear(EcsRenderSystem::RenderDevice& device)
+	{
+		for (Page& page : m_pages)
+		{
+			device.deleteTexture(page.texture);
+		}
+		m_pages.clear();
+		m_regions.clear();
+		m_rects.resize(1);
+		m_version++;
+	}
+
+	u32 TextureAtlas::createPageTexture(EcsRenderSystem::RenderDevice& device)
+	{
+		//Cleared to transparent so the padding around every packed texture is transparent
+		//Created with the same filtering as every texture the Resource Element loads
+		std::vector<unsigned char> transparent(static_cast<size_t>(PAGE_SIZE) * PAGE_SIZE * 4, 0);
+		return device.createTexture(PAGE_SIZE, PAGE_SIZE, 4, transparent.data(), PAGE_MAX_MIP_LEVEL);
+	}
+
+	int TextureAtlas::fitAt(const Page& page, size_t index, int width, int height)
+	{
+		int x = page.skyline[index].x;
+		if (x + width > PAGE_SIZE)
+		{
+			return -1;
+		}
+		//The rectangle rests on the highest node it spans
+		int widthLeft = width;
+		int y = page.skyline[index].y;
+		while (widthLeft > 0)
+		{
+			y = std::max(y, page.skyline[index].y);
+			if (y + height > PAGE_SIZE)
+			{
+				return -1;
+			}
+			widthLeft -= page.skyline[index].width;
+			index++;
+		}
+		return y;
+	}
+
+	int TextureAtlas::findPosition(const Page& page, int width, int height, int& x, int& y)
+	{
+		int bestIndex = -1;
+		int bestTop = INT_MAX;
+		int bestWidth = INT_MAX;
+		for (size_t i = 0; i < page.skyline.size(); i++)
+		{
+			int fitY = fitAt(page, i, width, height);
+			if (fitY < 0)
+			{
+				continue;
+			}
+			//Bottom-left: the position leaving the lowest top edge, ties broken by the narrowest node to waste less space
+			if (fitY + height < bestTop || (fitY + height == bestTop && page.skyline[i].width < bestWidth))
+			{
+				bestIndex = static_cast<int>(i);
+				bestTop = fitY + height;
+				bestWidth = page.skyline[i].width;
+				x = page.skyline[i].x;
+				y = fitY;
+			}
+		}
+		return bestIndex;
+	}
+
+	void TextureAtlas::placeAt(Page& page, size_t index, int x, int y, int width, int height)
+	{
+		std::vector<SkylineNode>& skyline = page.skyline;
+		skyline.insert(skyline.begin() + index, SkylineNode{ x, y + height, width });
+
+		//Shrink or remove the nodes the new node now covers
+		for (size_t i = index + 1; i < skyline.size();)
+		{
+			int previousEnd = skyline[i - 1].x + skyline[i - 1].width;
+			if (skyline[i].x >= previousEnd)
+			{
+				break;
+			}
+			int overlap = previousEnd - skyline[i].x;
+			skyline[i].x += overlap;
+			skyline[i].width -= overlap;
+			if (skyline[i].width > 0)
+			{
+				break;
+			}
+			skyline.erase(skyline.begin() + i);
+		}
+
+		//Merge neighbouring nodes at the same height
+		for (size_t i = 0; i + 1 < skyline.size();)
+		{
+			if (skyline[i].y == skyline[i + 1].y)
+			{
+				skyline[i].width += skyline[i + 1].width;
+				skyline.erase(skyline.begin() + i + 1);
+			}
+			else
+			{
+				i++;
+			}
+		}
+	}
+}
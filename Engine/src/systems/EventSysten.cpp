@@ -32,14 +32,19 @@ namespace EcsEventSystem
     //Prepare actions based upon key event for the Physics System to utilise to apply forces/impulses/torques
     void EventSystem::fixedUpdate(double fixedTimestep)
     {
+        SOL_MEMORY_TAG(EngineMemory::MemoryTag::Event);
         //Get all input events and all input components to find key-relevant actions
-        m_inputEvents = m_ecsElement->getCore()->getEventElement()->getInputEvents();
-        auto inputComponents = m_ecsElement->getAllComponentsOfType<InputComponent>();
+        //Everything built here is only needed for this tick, so is allocated from the Core's tick arena
+        auto core = m_ecsElement->getCore();
+        auto& tickArena = core->getTickArena();
+        const auto& inputEvents = core->getEventElement()->getInputEvents();
+        auto inputComponents = m_ecsElement->getAllComponentsOfType<InputComponent>(tickArena);
 
         //Structure to hold the specific actions to be executed for each entity based on the pressed keys
-        std::unordered_map<Entity, std::vector<ActionData>> actionsPerEntity;
+        //Created in the arena so it outlives this function, until the end of the tick
+        auto actionsPerEntity = tickArena.create<CoreEventElement::ActionsPerEntity>(EngineMemory::ArenaAllocator<CoreEventElement::ActionsPerEntity::value_type>(tickArena));
 
-        for (const auto& event : m_inputEvents)
+        for (const auto& event : inputEvents)
         {
             SDL_Keycode eventKey = event.key.keysym.sym;
             for (const auto& inputPair : inputComponents)
@@ -53,13 +58,18 @@ namespace EcsEventSystem
                 {
                     //If so, add all actions mapped to this key to the actionsPerEntity for the entity
                     const std::vector<ActionData>& actions = actionIt->second;
-                    actionsPerEntity[entity].insert(actionsPerEntity[entity].end(), actions.begin(), actions.end());
+                    auto entityActions = actionsPerEntity->find(entity);
+                    if (entityActions == actionsPerEntity->end())
+                    {
+                        entityActions = actionsPerEntity->emplace(entity, EngineMemory::ArenaVector<ActionData>(EngineMemory::ArenaAllocator<ActionData>(tickArena))).first;
+                    }
+                    entityActions->second.insert(entityActions->second.end(), actions.begin(), actions.end());
                 }
             }
         }
 
         //Pass the actionsPerEntity to the Physics System
         //Or rather, set a data structure the Physics System can use to access these currently induced actions
-        m_ecsElement->getCore()->getEventElement()->setActionsForPhysics(actionsPerEntity);
+        core->getEventElement()->setActionsForPhysics(actionsPerEntity);
     }
 }
\ No newline at end of file
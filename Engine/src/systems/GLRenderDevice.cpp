@@ -0,0 +1,729 @@
+//------- GL Render Device --
+//OpenGL Rendering Backend
+//For The Sol Core Engine
+//---------------------------
+
+#include "systems/GLRenderDevice.h"
+#include "systems/RenderQueue.h"
+#include "util/Log.h"
+#include "util/Profiler.h"
+#include "util/MemoryTracker.h"
+
+//C++ libraries
+#include <algorithm>
+#include <cstddef>
+
+//External library GLM
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/packing.hpp>
+#include <glm/gtc/packing.hpp>
+
+namespace EcsRenderSystem
+{
+    GLRenderDevice::GLRenderDevice(EngineMetrics::GpuTimer* gpuTimer) : m_gpuTimer(gpuTimer)
+    {
+        //Vertex shader source for single drawing
+        const char* singleDrawVertexShaderSource = R"glsl(
+        #version 330 core
+        layout (location = 0) in vec2 aPos;
+        layout (location = 1) in vec2 aTexCoords;
+
+        uniform mat4 uModelMatrix;
+        uniform vec4 uvRect; //The sprite's UV rect within its texture (its atlas page if its texture is in the atlas)
+        
+        layout (std140) uniform Camera
+        {
+            mat4 view;
+            mat4 projection;
+        };
+
+        out vec2 TexCoords;
+
+        void main()
+        {
+            gl_Position = projection * view * uModelMatrix * vec4(aPos, 0.0, 1.0);
+            TexCoords = mix(uvRect.xy, uvRect.zw, aTexCoords);
+        }
+        )glsl";
+        //Fragment shader source for single drawing
+        const char* singleDrawFragmentShaderSource = R"glsl(
+        #version 330 core
+        out vec4 FragColor;
+
+        in vec2 TexCoords;
+
+        uniform sampler2D spriteTexture;
+        uniform vec4 spriteColor;
+        uniform float alphaCutoff; //Pixels with less alpha are discarded, 0 in every pass but the alpha tested pass
+
+        void main()
+        {
+            vec4 color = texture(spriteTexture, TexCoords) * spriteColor;
+            if (color.a < alphaCutoff)
+            {
+                discard;
+            }
+            FragColor = color;
+        }
+        )glsl";
+
+        //Vertex shader source for multi drawing
+        const char* multiDrawVertexShaderSource = R"glsl(
+        #version 330 core
+        layout (location = 0) in vec2 aPos;
+        layout (location = 1) in vec2 aTexCoords;
+        //Per-instance sprite data, see SpriteInstance
+        layout (location = 2) in vec2 aPosition;
+        layout (location = 3) in vec2 aScale;
+        layout (location = 4) in float aRotation;
+        layout (location = 5) in float aDepth;
+        layout (location = 6) in vec4 aTint;
+        layout (location = 7) in uint aUVRect;
+
+        layout (std140) uniform Camera
+        {
+            mat4 view;
+            mat4 projection;
+        };
+        uniform samplerBuffer uvRects; //The texture atlas's UV rects, indexed by aUVRect
+
+        out vec2 TexCoords;
+        out vec4 Tint;
+
+        void main()
+        {
+            //Scale, then rotate, then translate, as the model matrix of a singly drawn sprite does
+            float angle = aRotation * (6.28318530718 / 65536.0);
+            float s = sin(angle);
+            float c = cos(angle);
+            vec2 scaled = aPos * aScale;
+            vec2 rotated = vec2(scaled.x * c - scaled.y * s, scaled.x * s + scaled.y * c);
+            //The depth rank is mapped to z as GLRenderDevice::depthRankToZ does
+            gl_Position = projection * view * vec4(aPosition + rotated, aDepth * (2.0 / 2097152.0) - 1.0, 1.0);
+            vec4 rect = texelFetch(uvRects, int(aUVRect));
+            TexCoords = mix(rect.xy, rect.zw, aTexCoords);
+            Tint = aTint;
+        }
+        )glsl";
+        //Fragment shader source for multi drawing
+        const char* multiDrawFragmentShaderSource = R"glsl(
+        #version 330 core
+        out vec4 FragColor;
+
+        in vec2 TexCoords;
+        in vec4 Tint;
+
+        uniform sampler2D spriteTexture;
+        uniform float alphaCutoff; //Pixels with less alpha are discarded, 0 in every pass but the alpha tested pass
+
+        void main()
+        {    
+            vec4 color = texture(spriteTexture, TexCoords) * Tint;
+            if (color.a < alphaCutoff)
+            {
+                discard;
+            }
+            FragColor = color;
+        }
+        )glsl";
+
+        //Vertex shader source for the debug draw's lines, see EngineDebugDraw::DebugVertex
+        const char* debugLineVertexShaderSource = R"glsl(
+        #version 330 core
+        layout (location = 0) in vec2 aPos;
+        layout (location = 1) in vec4 aColor;
+
+        layout (std140) uniform Camera
+        {
+            mat4 view;
+            mat4 projection;
+        };
+
+        out vec4 Color;
+
+        void main()
+        {
+            gl_Position = projection * view * vec4(aPos, 0.0, 1.0);
+            Color = aColor;
+        }
+        )glsl";
+        //Fragment shader source for the debug draw's lines
+        const char* debugLineFragmentShaderSource = R"glsl(
+        #version 330 core
+        out vec4 FragColor;
+
+        in vec4 Color;
+
+        void main()
+        {
+            FragColor = Color;
+        }
+        )glsl";
+
+        //Create the two shaders, one for single drawing and one for multi drawing, and the debug draw's
+        m_defaultShaderID = createProgram(singleDrawVertexShaderSource, singleDrawFragmentShaderSource);
+        m_defaultInstanceShaderID = createProgram(multiDrawVertexShaderSource, multiDrawFragmentShaderSource);
+        m_debugLineShaderID = createProgram(debugLineVertexShaderSource, debugLineFragmentShaderSource);
+        //Resolve every uniform location once, rather than on every draw
+        m_singleDrawUniforms.modelMatrix = getUniformLocation(m_defaultShaderID, "uModelMatrix");
+        m_singleDrawUniforms.spriteColor = getUniformLocation(m_defaultShaderID, "spriteColor");
+        m_singleDrawUniforms.uvRect = getUniformLocation(m_defaultShaderID, "uvRect");
+        m_singleDrawUniforms.alphaCutoff = getUniformLocation(m_defaultShaderID, "alphaCutoff");
+        m_instanceAlphaCutoff = getUniformLocation(m_defaultInstanceShaderID, "alphaCutoff");
+        //The sprite's texture is on texture unit 0, and the atlas's UV rects on texture unit 1
+        glUseProgram(m_defaultInstanceShaderID);
+        glUniform1i(getUniformLocation(m_defaultInstanceShaderID, "uvRects"), 1);
+        glUseProgram(0);
+
+        //Every program reads the view and projection matrices from the same uniform buffer, so they are uploaded once rather than per draw
+        bindUniformBlock(m_defaultShaderID, "Camera", CAMERA_BINDING);
+        bindUniformBlock(m_defaultInstanceShaderID, "Camera", CAMERA_BINDING);
+        bindUniformBlock(m_debugLineShaderID, "Camera", CAMERA_BINDING);
+        glGenBuffers(1, &m_cameraUBO);
+        glBindBuffer(GL_UNIFORM_BUFFER, m_cameraUBO);
+        glBufferData(GL_UNIFORM_BUFFER, 2 * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_BINDING, m_cameraUBO);
+
+        //Texture buffer of UV rects, starting with only rect 0 (the whole texture) as an empty atlas has
+        const CoreResourceElement::AtlasRect wholeTexture = { 0.0f, 0.0f, 1.0f, 1.0f };
+        glGenBuffers(1, &m_uvRectBuffer);
+        glBindBuffer(GL_TEXTURE_BUFFER, m_uvRectBuffer);
+        glBufferData(GL_TEXTURE_BUFFER, sizeof(wholeTexture), &wholeTexture, GL_DYNAMIC_DRAW);
+        glGenTextures(1, &m_uvRectTexture);
+        glBindTexture(GL_TEXTURE_BUFFER, m_uvRectTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_uvRectBuffer);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        m_uvRects.assign(1, wholeTexture);
+
+        //Initialize the VAO, VBO, and EBO to be used for instanced rendering
+        //VAO for managing VBOs
+        //VBO as data container for vertex or instance attributes
+        //EBO for indices to process vertices
+
+        //Generate VAO
+        glGenVertexArrays(1, &m_mainVAO);
+        glBindVertexArray(m_mainVAO);
+
+        //Generate VBO
+        //Originally wrote the positions as (x,y) since 2D, but for depth testing and in the future projection/view matrices (x,y,z) needed
+        //Basic quad vertices for mapping textures to
+        float vertices[] = {
+            //Positions      //Texture Coordinates
+            0.5f, 0.5f, 0.0f,  1.0f, 1.0f, // Vertex 1
+            0.5f, -0.5f, 0.0f, 1.0f, 0.0f, // Vertex 2
+            -0.5f, -0.5f, 0.0f, 0.0f, 0.0f, // Vertex 3
+            -0.5f, 0.5f, 0.0f, 0.0f, 1.0f // Vertex 4
+        };
+        //Gen, bind, and buffer so ready
+        glGenBuffers(1, &m_quadVBO);
+        glBindBuffer(GL_ARRAY_BUFFER, m_quadVBO);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW); //Static as we not changing the vertices' values
+
+        //Generate EBO
+        //Indices for procesing vertex order
+        unsigned int indices[] = {
+            0, 1, 3,
+            1, 2, 3
+        };
+        //Gen, bind, and buffer so ready
+        glGenBuffers(1, &m_quadEBO);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_quadEBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW); //Static as we are not changing the indices' values
+
+        //Specify vertex attribute data
+        //Layout location 0 is the 3 positions (x,y,z)
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+        //Layout location 1 is the 2 texture coords
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
+
+        //Initialise the instance buffer for sprite instances
+        //Each frame's region starts small and grows with the number of sprites drawn, up to the chunk size
+        m_instanceBuffer.initialize(m_INITIAL_INSTANCES * sizeof(SpriteInstance), m_MAX_INSTANCES_PER_CHUNK * sizeof(SpriteInstance));
+
+        //Specify instance attribute data
+        //In this case since the vertices' positional data is in layout location 0, and the texture coords are in layout location 1, need to start at 2
+        //Layouts 2 to 7 are the fields of SpriteInstance, and are per instance not per vertex
+        for (unsigned int i = 2; i <= 7; i++) {
+            glEnableVertexAttribArray(i);
+            glVertexAttribDivisor(i, 1);
+        }
+        setInstanceAttributes(m_instanceBuffer.getBuffer(), 0);
+
+        //Unbind the VAO
+        glBindVertexArray(0);
+
+        //The debug draw's lines are a position and an RGBA8 color each, see EngineDebugDraw::DebugVertex
+        glGenVertexArrays(1, &m_debugLineVAO);
+        glBindVertexArray(m_debugLineVAO);
+        glGenBuffers(1, &m_debugLineVBO);
+        glBindBuffer(GL_ARRAY_BUFFER, m_debugLineVBO);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(EngineDebugDraw::DebugVertex), (void*)offsetof(EngineDebugDraw::DebugVertex, position));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(EngineDebugDraw::DebugVertex), (void*)offsetof(EngineDebugDraw::DebugVertex, color));
+
+        //Unbind the VAO
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    GLRenderDevice::~GLRenderDevice()
+    {
+        m_instanceBuffer.terminate();
+        discardRetained();
+        glDeleteTextures(1, &m_uvRectTexture);
+        glDeleteBuffers(1, &m_uvRectBuffer);
+        glDeleteBuffers(1, &m_cameraUBO);
+        glDeleteVertexArrays(1, &m_debugLineVAO);
+        glDeleteBuffers(1, &m_debugLineVBO);
+        glDeleteProgram(m_debugLineShaderID);
+        glDeleteVertexArrays(1, &m_mainVAO);
+        glDeleteBuffers(1, &m_quadVBO);
+        glDeleteBuffers(1, &m_quadEBO);
+        glDeleteProgram(m_defaultShaderID);
+        glDeleteProgram(m_defaultInstanceShaderID);
+    }
+
+    u32 GLRenderDevice::createTexture(int width, int height, int channels, const unsigned char* pixels, int maxMipLevel)
+    {
+        GLuint texture;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        //Texture filtering and wrapping, the same for every texture
+        //Clamp to edge so sprites' edges never sample the opposite edge
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, maxMipLevel);
+        //Rows of 3 channel images aren't 4 byte aligned
+        GLenum format = channels == 4 ? GL_RGBA : GL_RGB;
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, channels == 4 ? GL_RGBA8 : GL_RGB8, width, height, 0, format, GL_UNSIGNED_BYTE, pixels);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return texture;
+    }
+
+    void GLRenderDevice::updateTexture(u32 texture, int x, int y, int width, int height, int channels, const unsigned char* pixels)
+    {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, channels == 4 ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE, pixels);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    void GLRenderDevice::deleteTexture(u32 texture)
+    {
+        glDeleteTextures(1, &texture);
+    }
+
+    GLuint GLRenderDevice::compileShader(GLenum type, const char* source)
+    {
+        GLuint shader = glCreateShader(type);
+        glShaderSource(shader, 1, &source, NULL);
+        glCompileShader(shader);
+        int success;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+        if (!success)
+        {
+            char infoLog[1024];
+            glGetShaderInfoLog(shader, 1024, NULL, infoLog);
+            SOL_LOG_ERROR("[Render Device] Cannot Compile %s Shader\nInfo Log : %s", type == GL_VERTEX_SHADER ? "Vertex" : "Fragment", infoLog);
+            glDeleteShader(shader);
+            return 0;
+        }
+        return shader;
+    }
+
+    u32 GLRenderDevice::createProgram(const char* vertexSource, const char* fragmentSource)
+    {
+        GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
+        GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
+        if (!vertexShader || !fragmentShader)
+        {
+            //Deleting shader 0 is ignored
+            glDeleteShader(vertexShader);
+            glDeleteShader(fragmentShader);
+            return 0;
+        }
+        //Link fragment and vertex shaders
+        GLuint program = glCreateProgram();
+        glAttachShader(program, vertexShader);
+        glAttachShader(program, fragmentShader);
+        glLinkProgram(program);
+        //Delete the shaders as both linked into program now and no longer necessary
+        glDetachShader(program, vertexShader);
+        glDetachShader(program, fragmentShader);
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        int success;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (!success)
+        {
+            char infoLog[1024];
+            glGetProgramInfoLog(program, 1024, NULL, infoLog);
+            SOL_LOG_ERROR("[Render Device] Cannot Link Program\nInfo Log : %s", infoLog);
+            glDeleteProgram(program);
+            return 0;
+        }
+        return program;
+    }
+
+    void GLRenderDevice::deleteProgram(u32 program)
+    {
+        //A later program given the same name must have its uniforms resolved again
+        m_customProgramUniforms.erase(program);
+        glDeleteProgram(program);
+    }
+
+    void GLRenderDevice::discardRetained()
+    {
+        //Unbound through the state cache first, so the cache can't believe a later buffer given the same name is already bound
+        m_glState.bindArrayBuffer(0);
+        //Chunks without a buffer are 0, which is ignored
+        glDeleteBuffers(static_cast<GLsizei>(m_staticChunkBuffers.size()), m_staticChunkBuffers.data());
+        m_staticChunkBuffers.clear();
+    }
+
+    //Set which attribute to modify, then number of values per attribute,
+    //then data type of those values, normalisation status, stride (offset in bytes between consecutive attributes),
+    //then the pointer which specifies the offset of the first value of the first generic vertex attribute in the array in the data store of the buffer
+    //Set again by every instanced batch, to point at that batch's sprite instances
+    void GLRenderDevice::setInstanceAttributes(GLuint buffer, GLintptr offset)
+    {
+        m_glState.bindArrayBuffer(buffer);
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)(offset + offsetof(SpriteInstance, position)));
+        glVertexAttribPointer(3, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)(offset + offsetof(SpriteInstance, scale)));
+        glVertexAttribPointer(4, 1, GL_UNSIGNED_SHORT, GL_FALSE, sizeof(SpriteInstance), (void*)(offset + offsetof(SpriteInstance, rotation)));
+        glVertexAttribPointer(5, 1, GL_UNSIGNED_INT, GL_FALSE, sizeof(SpriteInstance), (void*)(offset + offsetof(SpriteInstance, depth)));
+        glVertexAttribPointer(6, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SpriteInstance), (void*)(offset + offsetof(SpriteInstance, tint)));
+        glVertexAttribIPointer(7, 1, GL_UNSIGNED_SHORT, sizeof(SpriteInstance), (void*)(offset + offsetof(SpriteInstance, uvRect)));
+    }
+
+    void GLRenderDevice::uploadRange(const RenderCommandList& commands, const UploadRangeCommand& upload)
+    {
+        const u8* data = commands.getData(upload.data);
+        GLsizeiptr size = upload.data.size;
+        switch (upload.target)
+        {
+        case UploadTarget::Camera:
+            glBindBuffer(GL_UNIFORM_BUFFER, m_cameraUBO);
+            glBufferSubData(GL_UNIFORM_BUFFER, 0, std::min(size, static_cast<GLsizeiptr>(2 * sizeof(glm::mat4))), data);
+            glBindBuffer(GL_UNIFORM_BUFFER, 0);
+            break;
+        case UploadTarget::UVRects:
+            if (size == 0)
+            {
+                break;
+            }
+            glBindBuffer(GL_TEXTURE_BUFFER, m_uvRectBuffer);
+            glBufferData(GL_TEXTURE_BUFFER, size, data, GL_DYNAMIC_DRAW);
+            glBindBuffer(GL_TEXTURE_BUFFER, 0);
+            m_uvRects.assign(reinterpret_cast<const CoreResourceElement::AtlasRect*>(data), reinterpret_cast<const CoreResourceElement::AtlasRect*>(data + size));
+            break;
+        case UploadTarget::StreamedInstances:
+            //Read in place from the command list, and written to the instance buffer by the first instanced batch that draws them
+            m_streamedInstances = reinterpret_cast<const SpriteInstance*>(data);
+            m_streamedInstanceCount = static_cast<size_t>(size) / sizeof(SpriteInstance);
+            break;
+        case UploadTarget::StaticChunk:
+        {
+            if (upload.index >= m_staticChunkBuffers.size())
+            {
+                if (size == 0)
+                {
+                    break;
+                }
+                m_staticChunkBuffers.resize(upload.index + 1, 0);
+            }
+            GLuint& buffer = m_staticChunkBuffers[upload.index];
+            if (size == 0)
+            {
+                if (buffer)
+                {
+                    //Unbound through the state cache first, so the cache can't believe a later buffer given the same name is already bound
+                    m_glState.bindArrayBuffer(0);
+                    glDeleteBuffers(1, &buffer);
+                    buffer = 0;
+                }
+                break;
+            }
+            if (!buffer)
+            {
+                glGenBuffers(1, &buffer);
+            }
+            m_glState.bindArrayBuffer(buffer);
+            glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+            break;
+        }
+        }
+    }
+
+    glm::mat4 GLRenderDevice::unpackModelMatrix(const SpriteInstance& instance)
+    {
+        glm::vec2 scale = glm::unpackHalf2x16(instance.scale);
+        glm::mat4 modelMatrix = glm::mat4(1.0f);
+        modelMatrix = glm::translate(modelMatrix, glm::vec3(instance.position, depthRankToZ(instance.depth)));
+        modelMatrix = glm::rotate(modelMatrix, instance.rotation / 65536.0f * glm::two_pi<float>(), glm::vec3(0.0f, 0.0f, 1.0f));
+        modelMatrix = glm::scale(modelMatrix, glm::vec3(scale, 0.0f));
+        return modelMatrix;
+    }
+
+    float GLRenderDevice::depthRankToZ(u32 depthRank)
+    {
+        //The orthographic projection maps z to -z, so greater ranks are nearer
+        //Ranks are 21 bits, so each is a distinct value of the 24 bit depth buffer
+        return depthRank * (2.0f / (1u << SortKey::DEPTH_BITS)) - 1.0f;
+    }
+
+    GLRenderDevice::SingleDrawUniforms& GLRenderDevice::getCustomProgramUniforms(GLuint program)
+    {
+        auto uniforms = m_customProgramUniforms.find(program);
+        if (uniforms != m_customProgramUniforms.end()) {
+            return uniforms->second;
+        }
+        //Resolved the first time a sprite using the program is drawn, a custom program must provide the single draw program's sprite uniforms and Camera block
+        SingleDrawUniforms resolved;
+        resolved.modelMatrix = getUniformLocation(program, "uModelMatrix");
+        resolved.spriteColor = getUniformLocation(program, "spriteColor");
+        resolved.uvRect = getUniformLocation(program, "uvRect");
+        //Optional, a custom program without it draws alpha tested sprites without discarding
+        resolved.alphaCutoff = glGetUniformLocation(program, "alphaCutoff");
+        bindUniformBlock(program, "Camera", CAMERA_BINDING);
+        return m_customProgramUniforms.emplace(program, resolved).first->second;
+    }
+
+    GLint GLRenderDevice::getUniformLocation(GLuint program, const char* name)
+    {
+        GLint location = glGetUniformLocation(program, name);
+        if (location < 0)
+        {
+            SOL_LOG_WARN("[Render Device] Program %u Has No Active Uniform %s", program, name);
+        }
+        return location;
+    }
+
+    void GLRenderDevice::bindUniformBlock(GLuint program, const char* name, GLuint bindingPoint)
+    {
+        GLuint blockIndex = glGetUniformBlockIndex(program, name);
+        if (blockIndex == GL_INVALID_INDEX)
+        {
+            SOL_LOG_WARN("[Render Device] Program %u Has No Uniform Block %s", program, name);
+            return;
+        }
+        glUniformBlockBinding(program, blockIndex, bindingPoint);
+    }
+
+    void GLRenderDevice::execute(RenderCommandList& commands) {
+        SOL_PROFILE_FUNCTION();
+        SOL_MEMORY_TAG(EngineMemory::MemoryTag::Render);
+        m_replayStats = ReplayStats();
+        m_streamedInstances = nullptr;
+        m_streamedInstanceCount = 0;
+        m_instanceChunkFirst = 0;
+        m_instanceChunkCount = 0;
+        m_instanceChunkOffset = -1;
+        bool instanceFrameBegun = false;
+
+        //Anything outside the replay (the GUI, the Resource Element, plugins) may have bound state directly, so nothing shadowed can be trusted
+        //From here on all state is changed through the cache, and the frame-wide state is set once rather than per draw
+        //Blending and depth writes are set per pass
+        m_glState.invalidate();
+        m_glState.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        m_glState.setDepthTest(true);
+        //Less or equal, so a translucent sprite is drawn over an opaque sprite of the same depth rank
+        m_glState.setDepthFunc(GL_LEQUAL);
+        //The atlas's UV rects for the instanced vertex shader
+        m_glState.bindTexture(1, GL_TEXTURE_BUFFER, m_uvRectTexture);
+        //The sprite pass runs until the debug lines, which are drawn over everything else
+        if (m_gpuTimer) {
+            m_gpuTimer->beginPass(EngineMetrics::GpuPass::Sprites);
+        }
+
+        for (const RenderCommand& command : commands.getCommands()) {
+            switch (command.type) {
+            case RenderCommandType::SetPipeline:
+                beginPass(command.setPipeline.pass);
+                m_pipelineProgram = command.setPipeline.program;
+                break;
+            case RenderCommandType::BindTexture:
+                m_glState.bindTexture(0, GL_TEXTURE_2D, command.bindTexture.texture);
+                break;
+            case RenderCommandType::UploadRange:
+                if (command.uploadRange.target == UploadTarget::StreamedInstances) {
+                    //Grow the instance buffer's regions if this frame's sprite instances don't fit in one, they are written by the first instanced batch
+                    m_instanceBuffer.beginFrame(command.uploadRange.data.size);
+                    instanceFrameBegun = true;
+                }
+                uploadRange(commands, command.uploadRange);
+                break;
+            case RenderCommandType::DrawInstanced:
+                if (command.drawInstanced.chunk == RenderCommandList::STREAMED_INSTANCES) {
+                    multiDraw(command.drawInstanced.first, command.drawInstanced.count);
+                }
+                else {
+                    drawStaticBatch(command.drawInstanced.chunk, command.drawInstanced.first, command.drawInstanced.count);
+                }
+                break;
+            case RenderCommandType::DrawSingle:
+                singleDraw(m_pipelineProgram != 0 ? m_pipelineProgram : m_defaultShaderID, command.drawSingle.first, command.drawSingle.count);
+                break;
+            case RenderCommandType::DrawLines:
+                if (m_gpuTimer) {
+                    m_gpuTimer->endPass(EngineMetrics::GpuPass::Sprites);
+                    m_gpuTimer->beginPass(EngineMetrics::GpuPass::DebugLines);
+                }
+                drawDebugLines(reinterpret_cast<const EngineDebugDraw::DebugVertex*>(commands.getData(command.drawLines.vertices)),
+                    command.drawLines.vertices.size / sizeof(EngineDebugDraw::DebugVertex));
+                if (m_gpuTimer) {
+                    m_gpuTimer->endPass(EngineMetrics::GpuPass::DebugLines);
+                }
+                break;
+            }
+        }
+        //Fenced after the frame's last instanced draw, so the region isn't written again until the GPU has finished reading it
+        if (instanceFrameBegun) {
+            m_instanceBuffer.endFrame();
+        }
+        if (m_gpuTimer) {
+            m_gpuTimer->endPass(EngineMetrics::GpuPass::Sprites);
+        }
+
+        //Restore the depth state the Render Element sets up, depth writes must be on for the next frame's clear to clear the depth buffer
+        m_glState.setDepthTest(true);
+        m_glState.setDepthWrite(true);
+        //Leave no VAO bound, so nothing drawn or created after the replay can modify the shared VAO
+        m_glState.bindVertexArray(0);
+        m_glState.useProgram(0);
+        //The streamed instances are only valid whilst the list is being replayed
+        m_streamedInstances = nullptr;
+        m_streamedInstanceCount = 0;
+        m_replayStats.instanceBufferBytes = static_cast<u32>(m_instanceBuffer.getFrameBytes());
+        m_replayStats.instanceBufferPeakBytes = static_cast<u32>(m_instanceBuffer.getPeakFrameBytes());
+        m_replayStats.instanceBufferAllocatedBytes = static_cast<u32>(m_instanceBuffer.getAllocatedBytes());
+        m_replayStats.glCallsIssued = m_glState.getCallsIssued();
+        m_replayStats.glCallsSkipped = m_glState.getCallsSkipped();
+        m_glState.resetCallCounts();
+        commands.markReplayed(m_replayStats);
+    }
+
+    //Static batches are always instanced, as their instances are already on the GPU
+    void GLRenderDevice::drawStaticBatch(u32 chunk, u32 first, u32 count) {
+        GLuint buffer = chunk < m_staticChunkBuffers.size() ? m_staticChunkBuffers[chunk] : 0;
+        if (!buffer) {
+            return;
+        }
+        m_glState.bindVertexArray(m_mainVAO);
+        setInstanceAttributes(buffer, first * sizeof(SpriteInstance));
+        m_glState.useProgram(m_defaultInstanceShaderID);
+        applyAlphaCutoff(m_instanceAlphaCutoff, m_instanceAlphaCutoffValue);
+        glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(count));
+        m_replayStats.drawCalls++;
+        m_replayStats.instancedDrawCalls++;
+    }
+
+    void GLRenderDevice::beginPass(u32 pass) {
+        //Opaque and alpha tested sprites write depth, so the pixels of sprites they hide are rejected before shading
+        //Translucent sprites only test against the depth, so they are hidden by opaque sprites in front but blend over everything behind
+        bool translucent = pass == SortKey::TRANSLUCENT_PASS;
+        m_glState.setBlend(translucent);
+        m_glState.setDepthWrite(!translucent);
+        m_alphaCutoff = pass == SortKey::ALPHA_TESTED_PASS ? m_ALPHA_TEST_CUTOFF : 0.0f;
+    }
+
+    void GLRenderDevice::applyAlphaCutoff(GLint location, float& value) {
+        if (location >= 0 && value != m_alphaCutoff) {
+            glUniform1f(location, m_alphaCutoff);
+            value = m_alphaCutoff;
+        }
+    }
+
+    //Non-instanced rendering, of sprites with the texture bound by the last BindTexture command
+    void GLRenderDevice::singleDraw(GLuint program, u32 first, u32 count) {
+        m_glState.bindVertexArray(m_mainVAO);
+        m_glState.useProgram(program);
+        SingleDrawUniforms& uniforms = program == m_defaultShaderID ? m_singleDrawUniforms : getCustomProgramUniforms(program);
+        applyAlphaCutoff(uniforms.alphaCutoff, uniforms.alphaCutoffValue);
+        //Looping through the correct section of the streamed instances, and rendering one by one
+        //The model matrix is unpacked from the instance so singly drawn sprites match instanced sprites exactly
+        size_t end = std::min(static_cast<size_t>(first) + count, m_streamedInstanceCount);
+        for (size_t j = first; j < end; j++) {
+
+            const SpriteInstance& instance = m_streamedInstances[j];
+            glUniformMatrix4fv(uniforms.modelMatrix, 1, GL_FALSE, glm::value_ptr(unpackModelMatrix(instance)));
+            glUniform4fv(uniforms.spriteColor, 1, glm::value_ptr(glm::unpackUnorm4x8(instance.tint)));
+            //Rect 0 is the whole texture
+            const CoreResourceElement::AtlasRect& rect = instance.uvRect < m_uvRects.size() ? m_uvRects[instance.uvRect] : m_uvRects[0];
+            glUniform4f(uniforms.uvRect, rect.u0, rect.v0, rect.u1, rect.v1);
+            glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+            m_replayStats.drawCalls++;
+            m_replayStats.singleDrawCalls++;
+        }
+    }
+
+    //Instanced (batch) rendering, of sprites with the texture bound by the last BindTexture command
+    void GLRenderDevice::multiDraw(u32 firstInstance, u32 count) {
+        m_glState.bindVertexArray(m_mainVAO);
+        //A batch is drawn in one call unless it crosses the end of a chunk of instances, then each chunk's part is a call
+        size_t first = firstInstance;
+        size_t end = std::min(static_cast<size_t>(firstInstance) + count, m_streamedInstanceCount);
+        while (first < end) {
+            if (first < m_instanceChunkFirst || first >= m_instanceChunkFirst + m_instanceChunkCount) {
+                //If the instances couldn't be written to the instance buffer, draw the rest of the batch one by one instead
+                if (!writeInstanceChunk(first)) {
+                    singleDraw(m_defaultShaderID, static_cast<u32>(first), static_cast<u32>(end - first));
+                    return;
+                }
+            }
+            size_t chunkCount = std::min(end, m_instanceChunkFirst + m_instanceChunkCount) - first;
+            //This part's sprite instances are already in the instance buffer, contiguous from its offset into the chunk
+            //OpenGL 3.3 has no base instance for draws, so the instance attributes are pointed at the part's offset instead (no data is copied)
+            setInstanceAttributes(m_instanceBuffer.getBuffer(), m_instanceChunkOffset + (first - m_instanceChunkFirst) * sizeof(SpriteInstance));
+            m_glState.useProgram(m_defaultInstanceShaderID);
+            applyAlphaCutoff(m_instanceAlphaCutoff, m_instanceAlphaCutoffValue);
+            //Draw the batch of sprites via instanced rendering
+            glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(chunkCount));
+            m_replayStats.drawCalls++;
+            m_replayStats.instancedDrawCalls++;
+            first += chunkCount;
+        }
+    }
+
+    bool GLRenderDevice::writeInstanceChunk(size_t first) {
+        size_t count = std::min(m_streamedInstanceCount - first, static_cast<size_t>(m_instanceBuffer.getRegionSize() / sizeof(SpriteInstance)));
+        m_instanceChunkFirst = first;
+        m_instanceChunkCount = 0;
+        m_instanceChunkOffset = m_instanceBuffer.write(&m_streamedInstances[first], count * sizeof(SpriteInstance));
+        if (m_instanceChunkOffset < 0) {
+            SOL_LOG_WARN_EVERY(5000, "[Render Device] Cannot Write %zu Sprite Instances To The Instance Buffer, Drawing Without Instancing", count);
+            return false;
+        }
+        m_instanceChunkCount = count;
+        return true;
+    }
+
+    void GLRenderDevice::drawDebugLines(const EngineDebugDraw::DebugVertex* vertices, size_t vertexCount) {
+        if (vertexCount == 0) {
+            return;
+        }
+        //Drawn after the sprites without the depth test, so lines are always visible over them
+        m_glState.setDepthTest(false);
+        m_glState.setBlend(true);
+        m_glState.useProgram(m_debugLineShaderID);
+        m_glState.bindVertexArray(m_debugLineVAO);
+        m_glState.bindArrayBuffer(m_debugLineVBO);
+        //Respecified every frame, so the driver can give a fresh buffer rather than waiting for the GPU to finish with last frame's lines
+        glBufferData(GL_ARRAY_BUFFER, vertexCount * sizeof(EngineDebugDraw::DebugVertex), vertices, GL_STREAM_DRAW);
+        glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(vertexCount));
+        m_replayStats.drawCalls++;
+    }
+}
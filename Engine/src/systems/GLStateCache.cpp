@@ -0,0 +1,161 @@
+//------- GL State Cache ----
+//Skips Redundant OpenGL State Changes
+//For The Sol Core Engine
+//---------------------------
+
+#include "systems/GLStateCache.h"
+
+namespace EcsRenderSystem
+{
+    GLStateCache::GLStateCache()
+    {
+        invalidate();
+    }
+
+    void GLStateCache::invalidate()
+    {
+        m_program = UNKNOWN;
+        m_activeTextureUnit = UNKNOWN;
+        for (int i = 0; i < TEXTURE_UNITS; i++)
+        {
+            m_texture2D[i] = UNKNOWN;
+            m_textureBuffer[i] = UNKNOWN;
+        }
+        m_vertexArray = UNKNOWN;
+        m_arrayBuffer = UNKNOWN;
+        m_blend = UNKNOWN;
+        m_blendSourceFactor = UNKNOWN;
+        m_blendDestinationFactor = UNKNOWN;
+        m_depthTest = UNKNOWN;
+        m_depthWrite = UNKNOWN;
+        m_depthFunc = UNKNOWN;
+    }
+
+    bool GLStateCache::change(GLuint& shadowed, GLuint requested)
+    {
+        if (shadowed == requested)
+        {
+            m_callsSkipped++;
+            return false;
+        }
+        shadowed = requested;
+        m_callsIssued++;
+        return true;
+    }
+
+    void GLStateCache::useProgram(GLuint program)
+    {
+        if (change(m_program, program))
+        {
+            glUseProgram(program);
+        }
+    }
+
+    void GLStateCache::bindTexture(GLuint unit, GLenum target, GLuint texture)
+    {
+        GLuint* shadowed = nullptr;
+        if (unit < static_cast<GLuint>(TEXTURE_UNITS))
+        {
+            if (target == GL_TEXTURE_2D)
+            {
+                shadowed = &m_texture2D[unit];
+            }
+            else if (target == GL_TEXTURE_BUFFER)
+            {
+                shadowed = &m_textureBuffer[unit];
+            }
+        }
+        //Untracked bindings are always issued
+        if (shadowed && *shadowed == texture)
+        {
+            m_callsSkipped++;
+            return;
+        }
+        //Only switch the active unit when the binding actually changes
+        if (change(m_activeTextureUnit, unit))
+        {
+            glActiveTexture(GL_TEXTURE0 + unit);
+        }
+        if (shadowed)
+        {
+            *shadowed = texture;
+        }
+        glBindTexture(target, texture);
+        m_callsIssued++;
+    }
+
+    void GLStateCache::bindVertexArray(GLuint vertexArray)
+    {
+        if (change(m_vertexArray, vertexArray))
+        {
+            glBindVertexArray(vertexArray);
+        }
+    }
+
+    void GLStateCache::bindArrayBuffer(GLuint buffer)
+    {
+        if (change(m_arrayBuffer, buffer))
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        }
+    }
+
+    void GLStateCache::setBlend(bool enabled)
+    {
+        if (change(m_blend, enabled ? GL_TRUE : GL_FALSE))
+        {
+            if (enabled)
+            {
+                glEnable(GL_BLEND);
+            }
+            else
+            {
+                glDisable(GL_BLEND);
+            }
+        }
+    }
+
+    void GLStateCache::setBlendFunc(GLenum sourceFactor, GLenum destinationFactor)
+    {
+        if (m_blendSourceFactor == sourceFactor && m_blendDestinationFactor == destinationFactor)
+        {
+            m_callsSkipped++;
+            return;
+        }
+        m_blendSourceFactor = sourceFactor;
+        m_blendDestinationFactor = destinationFactor;
+        glBlendFunc(sourceFactor, destinationFactor);
+        m_callsIssued++;
+    }
+
+    void GLStateCache::setDepthTest(bool enabled)
+    {
+        if (change(m_depthTest, enabled ? GL_TRUE : GL_FALSE))
+        {
+            if (enabled)
+            {
+                glEnable(GL_DEPTH_TEST);
+            }
+            else
+            {
+                glDisable(GL_DEPTH_TEST);
+            }
+        }
+    }
+
+    void GLStateCache::setDepthWrite(bool enabled)
+    {
+        if (change(m_depthWrite, enabled ? GL_TRUE : GL_FALSE))
+        {
+            glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+        }
+    }
+
+    void GLStateCache::setDepthFunc(GLenum function)
+    {
+        if (change(m_depthFunc, function))
+        {
+            glDepthFunc(function);
+        }
+    }
+}
@@ -0,0 +1,194 @@
+//------- Instance Buffer ---
+//Streams Instance Data To The GPU
+//For The Sol Core Engine
+//---------------------------
+
+#include "systems/InstanceRingBuffer.h"
+
+//C++ libraries
+#include <cstring>
+
+//External library SDL2, used to load ARB_buffer_storage since GLAD is generated for core OpenGL 3.3 only
+#include <SDL.h>
+
+#include "util/Log.h"
+
+namespace EcsRenderSystem
+{
+    namespace
+    {
+        //ARB_buffer_storage (core in OpenGL 4.4)
+        typedef void (APIENTRYP BufferStorageFunction)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+        const GLbitfield MAP_PERSISTENT_BIT = 0x0040;
+        const GLbitfield MAP_COHERENT_BIT = 0x0080;
+
+        //How long to wait on a fence before checking again, a region is normally free long before this
+        const GLuint64 FENCE_WAIT_TIMEOUT_NS = 1000000000;
+    }
+
+    InstanceRingBuffer::InstanceRingBuffer()
+    {
+    }
+
+    InstanceRingBuffer::~InstanceRingBuffer()
+    {
+        terminate();
+    }
+
+    void InstanceRingBuffer::initialize(GLsizeiptr regionSize, GLsizeiptr maxRegionSize)
+    {
+        m_maxRegionSize = maxRegionSize;
+        m_peakFrameBytes = 0;
+        allocate(regionSize < maxRegionSize ? regionSize : maxRegionSize);
+    }
+
+    void InstanceRingBuffer::allocate(GLsizeiptr regionSize)
+    {
+        m_regionSize = regionSize;
+        m_region = 0;
+        m_regionUsed = 0;
+        GLsizeiptr bufferSize = regionSize * FRAME_REGIONS;
+        glGenBuffers(1, &m_buffer);
+        glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+
+        BufferStorageFunction bufferStorage = nullptr;
+        if (SDL_GL_ExtensionSupported("GL_ARB_buffer_storage"))
+        {
+            bufferStorage = reinterpret_cast<BufferStorageFunction>(SDL_GL_GetProcAddress("glBufferStorage"));
+        }
+        if (bufferStorage)
+        {
+            //Coherent, so writes are visible to the GPU without flushing, the fences alone keep the CPU and GPU apart
+            GLbitfield flags = GL_MAP_WRITE_BIT | MAP_PERSISTENT_BIT | MAP_COHERENT_BIT;
+            bufferStorage(GL_ARRAY_BUFFER, bufferSize, nullptr, flags);
+            m_persistentData = static_cast<char*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, bufferSize, flags));
+        }
+        if (!m_persistentData)
+        {
+            //A buffer created with glBufferStorage is immutable, so it must be recreated to be allocated with glBufferData instead
+            if (bufferStorage)
+            {
+                glDeleteBuffers(1, &m_buffer);
+                glGenBuffers(1, &m_buffer);
+                glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+            }
+            glBufferData(GL_ARRAY_BUFFER, bufferSize, nullptr, GL_STREAM_DRAW);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        SOL_LOG_INFO("[ECS - Render System] Instance Buffer: %d x %.1f KB regions, %s", FRAME_REGIONS,
+            regionSize / 1024.0, m_persistentData ? "persistently mapped" : "mapped per write");
+    }
+
+    void InstanceRingBuffer::terminate()
+    {
+        for (GLsync& fence : m_fences)
+        {
+            if (fence)
+            {
+                glDeleteSync(fence);
+                fence = nullptr;
+            }
+        }
+        if (m_buffer)
+        {
+            if (m_persistentData)
+            {
+                glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+                glUnmapBuffer(GL_ARRAY_BUFFER);
+                glBindBuffer(GL_ARRAY_BUFFER, 0);
+                m_persistentData = nullptr;
+            }
+            glDeleteBuffers(1, &m_buffer);
+            m_buffer = 0;
+        }
+    }
+
+    void InstanceRingBuffer::beginFrame(GLsizeiptr frameSize)
+    {
+        m_frameBytes = 0;
+        if (m_buffer && frameSize > m_regionSize && m_regionSize < m_maxRegionSize)
+        {
+            GLsizeiptr regionSize = m_regionSize;
+            while (regionSize < frameSize && regionSize < m_maxRegionSize)
+            {
+                regionSize *= 2;
+            }
+            //OpenGL keeps a deleted buffer's storage until draws still reading it have finished, so the old buffer can go at once
+            //The new buffer has nothing in flight, so its regions need no fences
+            terminate();
+            allocate(regionSize < m_maxRegionSize ? regionSize : m_maxRegionSize);
+            return;
+        }
+        nextRegion();
+    }
+
+    void InstanceRingBuffer::nextRegion()
+    {
+        if (m_buffer && !m_fences[m_region] && m_regionUsed > 0)
+        {
+            m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+        m_region = (m_region + 1) % FRAME_REGIONS;
+        m_regionUsed = 0;
+        GLsync& fence = m_fences[m_region];
+        if (fence)
+        {
+            GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+            while (result == GL_TIMEOUT_EXPIRED)
+            {
+                //The GPU is more than FRAME_REGIONS regions behind, so the CPU has to wait for it
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_WAIT_TIMEOUT_NS);
+            }
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+
+    GLintptr InstanceRingBuffer::write(const void* data, GLsizeiptr size)
+    {
+        if (!m_buffer || size > m_regionSize)
+        {
+            return -1;
+        }
+        if (m_regionUsed + size > m_regionSize)
+        {
+            //A chunk of a frame too large for one region
+            nextRegion();
+        }
+        GLintptr offset = m_region * m_regionSize + m_regionUsed;
+        if (m_persistentData)
+        {
+            std::memcpy(m_persistentData + offset, data, size);
+        }
+        else
+        {
+            //The fences already guarantee the GPU is done with this region, so the driver needn't synchronize the mapping
+            glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+            void* mapped = glMapBufferRange(GL_ARRAY_BUFFER, offset, size, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+            if (!mapped)
+            {
+                glBindBuffer(GL_ARRAY_BUFFER, 0);
+                return -1;
+            }
+            std::memcpy(mapped, data, size);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+        m_regionUsed += size;
+        m_frameBytes += size;
+        if (m_frameBytes > m_peakFrameBytes)
+        {
+            m_peakFrameBytes = m_frameBytes;
+        }
+        return offset;
+    }
+
+    void InstanceRingBuffer::endFrame()
+    {
+        if (m_buffer && !m_fences[m_region])
+        {
+            m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+    }
+}
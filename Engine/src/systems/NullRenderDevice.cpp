@@ -0,0 +1,208 @@
+//------ Null Render Device -
+//Headless Rendering Backend
+//For The Sol Core Engine
+//---------------------------
+
+#include "systems/NullRenderDevice.h"
+#include "systems/RenderQueue.h"
+#include "systems/SpriteDraw.h"
+#include "util/DebugDraw.h"
+#include "util/Log.h"
+#include "util/Profiler.h"
+
+namespace EcsRenderSystem
+{
+    u32 NullRenderDevice::createTexture(int width, int height, int channels, const unsigned char* pixels, int maxMipLevel)
+    {
+        if (width <= 0 || height <= 0 || (channels != 3 && channels != 4) || maxMipLevel < 0)
+        {
+            reportInvalid("CreateTexture With An Invalid Size, Channel Count, Or Mip Level");
+            return 0;
+        }
+        u32 texture = m_nextHandle++;
+        m_textures[texture] = TextureSize{ width, height };
+        m_counts.texturesCreated++;
+        return texture;
+    }
+
+    void NullRenderDevice::updateTexture(u32 texture, int x, int y, int width, int height, int channels, const unsigned char* pixels)
+    {
+        m_counts.textureUpdates++;
+        auto size = m_textures.find(texture);
+        if (size == m_textures.end())
+        {
+            reportInvalid("UpdateTexture Of An Unknown Texture");
+            return;
+        }
+        if (!pixels || (channels != 3 && channels != 4) || x < 0 || y < 0 || width <= 0 || height <= 0 || x + width > size->second.width || y + height > size->second.height)
+        {
+            reportInvalid("UpdateTexture Outside Its Texture Or Without Pixels");
+        }
+    }
+
+    void NullRenderDevice::deleteTexture(u32 texture)
+    {
+        if (m_textures.erase(texture) == 0)
+        {
+            reportInvalid("DeleteTexture Of An Unknown Texture");
+        }
+    }
+
+    u32 NullRenderDevice::createProgram(const char* vertexSource, const char* fragmentSource)
+    {
+        if (!vertexSource || !fragmentSource)
+        {
+            reportInvalid("CreateProgram Without A Shader Source");
+            return 0;
+        }
+        u32 program = m_nextHandle++;
+        m_programs.insert(program);
+        m_counts.programsCreated++;
+        return program;
+    }
+
+    void NullRenderDevice::deleteProgram(u32 program)
+    {
+        if (m_programs.erase(program) == 0)
+        {
+            reportInvalid("DeleteProgram Of An Unknown Program");
+        }
+    }
+
+    void NullRenderDevice::execute(RenderCommandList& commands)
+    {
+        SOL_PROFILE_FUNCTION();
+        ReplayStats stats;
+        bool pipelineSet = false;
+        bool textureBound = false;
+        bool instancesUploaded = false;
+        u32 streamedInstances = 0;
+        m_counts.commandLists++;
+        m_counts.commands += commands.getCommands().size();
+
+        for (const RenderCommand& command : commands.getCommands()) {
+            switch (command.type) {
+            case RenderCommandType::SetPipeline:
+                m_counts.pipelineChanges++;
+                pipelineSet = true;
+                if (command.setPipeline.pass > SortKey::TRANSLUCENT_PASS) {
+                    reportInvalid("SetPipeline With An Unknown Pass");
+                }
+                if (command.setPipeline.program != 0 && m_programs.count(command.setPipeline.program) == 0) {
+                    reportInvalid("SetPipeline With An Unknown Program");
+                }
+                break;
+            case RenderCommandType::BindTexture:
+                //Sprites without a texture bind texture 0
+                m_counts.textureBinds++;
+                textureBound = true;
+                if (command.bindTexture.texture != 0 && m_textures.count(command.bindTexture.texture) == 0) {
+                    reportInvalid("BindTexture Of An Unknown Texture");
+                }
+                break;
+            case RenderCommandType::UploadRange:
+            {
+                const UploadRangeCommand& upload = command.uploadRange;
+                m_counts.uploads++;
+                m_counts.uploadBytes += upload.data.size;
+                if (static_cast<size_t>(upload.data.offset) + upload.data.size > commands.getDataBytes()) {
+                    reportInvalid("UploadRange Outside Its List's Data");
+                    break;
+                }
+                switch (upload.target) {
+                case UploadTarget::Camera:
+                    if (upload.data.size != 32 * sizeof(float)) {
+                        reportInvalid("UploadRange Of The Camera Isn't Two Matrices");
+                    }
+                    break;
+                case UploadTarget::UVRects:
+                    if (upload.data.size == 0 || upload.data.size % (4 * sizeof(float)) != 0) {
+                        reportInvalid("UploadRange Of The UV Rects Isn't Whole Rects");
+                    }
+                    break;
+                case UploadTarget::StreamedInstances:
+                    if (instancesUploaded) {
+                        reportInvalid("UploadRange Of The Streamed Instances More Than Once");
+                    }
+                    if (upload.data.size % sizeof(SpriteInstance) != 0) {
+                        reportInvalid("UploadRange Of The Streamed Instances Isn't Whole Instances");
+                    }
+                    instancesUploaded = true;
+                    streamedInstances = upload.data.size / sizeof(SpriteInstance);
+                    stats.instanceBufferBytes = upload.data.size;
+                    break;
+                case UploadTarget::StaticChunk:
+                    if (upload.data.size % sizeof(SpriteInstance) != 0) {
+                        reportInvalid("UploadRange Of A Static Chunk Isn't Whole Instances");
+                    }
+                    if (upload.index >= m_staticChunkInstances.size()) {
+                        m_staticChunkInstances.resize(upload.index + 1, 0);
+                    }
+                    m_staticChunkInstances[upload.index] = upload.data.size / sizeof(SpriteInstance);
+                    break;
+                }
+                break;
+            }
+            case RenderCommandType::DrawInstanced:
+            {
+                const DrawInstancedCommand& draw = command.drawInstanced;
+                m_counts.instancedDraws++;
+                m_counts.instancesDrawn += draw.count;
+                stats.drawCalls++;
+                stats.instancedDrawCalls++;
+                if (!pipelineSet || !textureBound) {
+                    reportInvalid("DrawInstanced Before A Pipeline And Texture Are Set");
+                }
+                if (draw.count == 0) {
+                    reportInvalid("DrawInstanced Of No Instances");
+                }
+                if (draw.chunk == RenderCommandList::STREAMED_INSTANCES) {
+                    if (!instancesUploaded || static_cast<u64>(draw.first) + draw.count > streamedInstances) {
+                        reportInvalid("DrawInstanced Outside The Streamed Instances");
+                    }
+                }
+                else if (draw.chunk >= m_staticChunkInstances.size() || static_cast<u64>(draw.first) + draw.count > m_staticChunkInstances[draw.chunk]) {
+                    reportInvalid("DrawInstanced Outside Its Static Chunk");
+                }
+                break;
+            }
+            case RenderCommandType::DrawSingle:
+                m_counts.singleDraws += command.drawSingle.count;
+                m_counts.instancesDrawn += command.drawSingle.count;
+                stats.drawCalls += command.drawSingle.count;
+                stats.singleDrawCalls += command.drawSingle.count;
+                if (!pipelineSet || !textureBound) {
+                    reportInvalid("DrawSingle Before A Pipeline And Texture Are Set");
+                }
+                if (!instancesUploaded || static_cast<u64>(command.drawSingle.first) + command.drawSingle.count > streamedInstances) {
+                    reportInvalid("DrawSingle Outside The Streamed Instances");
+                }
+                break;
+            case RenderCommandType::DrawLines:
+                m_counts.lineDraws++;
+                stats.drawCalls++;
+                if (static_cast<size_t>(command.drawLines.vertices.offset) + command.drawLines.vertices.size > commands.getDataBytes()) {
+                    reportInvalid("DrawLines Outside Its List's Data");
+                }
+                //Every line is a pair of vertices
+                if (command.drawLines.vertices.size % (2 * sizeof(EngineDebugDraw::DebugVertex)) != 0) {
+                    reportInvalid("DrawLines Isn't Whole Lines");
+                }
+                break;
+            }
+        }
+        stats.instanceBufferPeakBytes = stats.instanceBufferBytes;
+        commands.markReplayed(stats);
+    }
+
+    void NullRenderDevice::discardRetained()
+    {
+        m_staticChunkInstances.clear();
+    }
+
+    void NullRenderDevice::reportInvalid(const char* problem)
+    {
+        m_counts.invalidCalls++;
+        SOL_LOG_WARN_EVERY(5000, "[Render Device] Invalid Call: %s", problem);
+    }
+}
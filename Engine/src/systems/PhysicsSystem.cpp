@@ -46,18 +46,21 @@ namespace EcsPhysicsSystem
 
     void PhysicsSystem::fixedUpdate(double fixedTimestep)
     {
+        SOL_MEMORY_TAG(EngineMemory::MemoryTag::Physics);
         const int32 velocityIterations = 8;
         const int32 positionIterations = 3;
 
         float timeStep = static_cast<float>(fixedTimestep);
 
         //Get Components of the PhysicsBodyComponent and TransformComponent types
-        auto physicsComponents = m_ecsElement->getAllComponentsOfType<PhysicsBodyComponent>();
-        auto transformComponents = m_ecsElement->getAllComponentsOfType<TransformComponent>();
-        auto colliderComponents = m_ecsElement->getAllComponentsOfType<ColliderComponent>();
+        //The maps are only needed for this tick, so are allocated from the Core's tick arena
+        auto& tickArena = m_ecsElement->getCore()->getTickArena();
+        auto physicsComponents = m_ecsElement->getAllComponentsOfType<PhysicsBodyComponent>(tickArena);
+        auto transformComponents = m_ecsElement->getAllComponentsOfType<TransformComponent>(tickArena);
+        auto colliderComponents = m_ecsElement->getAllComponentsOfType<ColliderComponent>(tickArena);
         
-        //Retrieve actions for this frame
-        auto& actionsPerEntity = m_ecsElement->getCore()->getEventElement()->getActionsForPhysics();
+        //Retrieve actions for this tick, nullptr if the Event System hasn't set any
+        const CoreEventElement::ActionsPerEntity* actionsPerEntity = m_ecsElement->getCore()->getEventElement()->getActionsForPhysics();
 
         //Iterate through Entities with PhysicsBodyComponent and TransformComponent
         //This is to ensure all bodies are created with the appropriate fixtures and at the appropriate positions
@@ -150,33 +153,35 @@ namespace EcsPhysicsSystem
             }
 
             //Find and apply input actions specific to this entity
-            auto actionsIt = actionsPerEntity.find(entity);
-            if (actionsIt != actionsPerEntity.end()) {
-                const auto& actions = actionsIt->second;
-                for (const ActionData& action : actions) {
-                    //Apply each action
-                    b2Vec2 moveDirection(action.moveDirection.x, action.moveDirection.y);
-                    moveDirection.Normalize();
-                    float magnitude = action.magnitude;
-                    float angularMagnitude = action.angularMagnitude;
-                    //Switch based on the type of force to apply
-                    switch (action.fType) {
-                    //Force is a linear force applied to the centre of mass   
-                    case ForceType::Force:
-                        physicsComponent->body->ApplyForceToCenter(magnitude * moveDirection, true);
-                        break;
-                    //Impulse is a linear impulse applied to the centre of mass
-                    case ForceType::Impulse:
-                        physicsComponent->body->ApplyLinearImpulseToCenter(magnitude * moveDirection, true);
-                        break;
-                    //Torque is an angular force applied with origin of rotation as the centre of mass
-                    case ForceType::Torque:
-                        physicsComponent->body->ApplyTorque(angularMagnitude, true);
-                        break;
-                    //Angular impulse is an angular impulse applied with origin of rotation as the centre of mass
-                    case ForceType::AngularImpulse:
-                        physicsComponent->body->ApplyAngularImpulse(angularMagnitude, true);
-                        break;
+            if (actionsPerEntity) {
+                auto actionsIt = actionsPerEntity->find(entity);
+                if (actionsIt != actionsPerEntity->end()) {
+                    const auto& actions = actionsIt->second;
+                    for (const ActionData& action : actions) {
+                        //Apply each action
+                        b2Vec2 moveDirection(action.moveDirection.x, action.moveDirection.y);
+                        moveDirection.Normalize();
+                        float magnitude = action.magnitude;
+                        float angularMagnitude = action.angularMagnitude;
+                        //Switch based on the type of force to apply
+                        switch (action.fType) {
+                        //Force is a linear force applied to the centre of mass   
+                        case ForceType::Force:
+                            physicsComponent->body->ApplyForceToCenter(magnitude * moveDirection, true);
+                            break;
+                        //Impulse is a linear impulse applied to the centre of mass
+                        case ForceType::Impulse:
+                            physicsComponent->body->ApplyLinearImpulseToCenter(magnitude * moveDirection, true);
+                            break;
+                        //Torque is an angular force applied with origin of rotation as the centre of mass
+                        case ForceType::Torque:
+                            physicsComponent->body->ApplyTorque(angularMagnitude, true);
+                            break;
+                        //Angular impulse is an angular impulse applied with origin of rotation as the centre of mass
+                        case ForceType::AngularImpulse:
+                            physicsComponent->body->ApplyAngularImpulse(angularMagnitude, true);
+                            break;
+                        }
                     }
                 }
             }
@@ -0,0 +1,139 @@
+//--- Recording Render Device
+//Command Stream Dumping
+//For The Sol Core Engine
+//---------------------------
+
+#include "systems/RecordingRenderDevice.h"
+#include "systems/SpriteDraw.h"
+#include "util/DebugDraw.h"
+#include "util/Log.h"
+
+namespace EcsRenderSystem
+{
+    namespace
+    {
+        const char* uploadTargetName(UploadTarget target)
+        {
+            switch (target)
+            {
+            case UploadTarget::Camera: return "Camera";
+            case UploadTarget::UVRects: return "UVRects";
+            case UploadTarget::StreamedInstances: return "StreamedInstances";
+            case UploadTarget::StaticChunk: return "StaticChunk";
+            }
+            return "Unknown";
+        }
+    }
+
+    RecordingRenderDevice::RecordingRenderDevice(const std::string& filePath) : m_file(filePath, std::ios::out | std::ios::trunc)
+    {
+        if (!m_file.is_open())
+        {
+            SOL_LOG_ERROR("[Render Device] Failed To Open Command Stream File: %s", filePath.c_str());
+        }
+    }
+
+    u32 RecordingRenderDevice::createTexture(int width, int height, int channels, const unsigned char* pixels, int maxMipLevel)
+    {
+        u32 texture = NullRenderDevice::createTexture(width, height, channels, pixels, maxMipLevel);
+        m_file << "CreateTexture " << texture << " " << width << "x" << height << "x" << channels << " maxMipLevel=" << maxMipLevel << "\n";
+        return texture;
+    }
+
+    void RecordingRenderDevice::updateTexture(u32 texture, int x, int y, int width, int height, int channels, const unsigned char* pixels)
+    {
+        NullRenderDevice::updateTexture(texture, x, y, width, height, channels, pixels);
+        m_file << "UpdateTexture " << texture << " x=" << x << " y=" << y << " " << width << "x" << height << "x" << channels << "\n";
+    }
+
+    void RecordingRenderDevice::deleteTexture(u32 texture)
+    {
+        NullRenderDevice::deleteTexture(texture);
+        m_file << "DeleteTexture " << texture << "\n";
+    }
+
+    u32 RecordingRenderDevice::createProgram(const char* vertexSource, const char* fragmentSource)
+    {
+        u32 program = NullRenderDevice::createProgram(vertexSource, fragmentSource);
+        m_file << "CreateProgram " << program << "\n";
+        return program;
+    }
+
+    void RecordingRenderDevice::deleteProgram(u32 program)
+    {
+        NullRenderDevice::deleteProgram(program);
+        m_file << "DeleteProgram " << program << "\n";
+    }
+
+    void RecordingRenderDevice::execute(RenderCommandList& commands)
+    {
+        m_file << "CommandList " << m_listsRecorded++ << ": " << commands.getCommands().size() << " commands, " << commands.getDataBytes() << " bytes of data\n";
+        for (const RenderCommand& command : commands.getCommands())
+        {
+            writeCommand(command);
+        }
+        //Checked after writing, so the number of invalid calls the list made is written after it
+        NullRenderDevice::execute(commands);
+        u64 invalidCalls = getCounts().invalidCalls;
+        if (invalidCalls != m_invalidCallsWritten)
+        {
+            m_file << "  ! " << invalidCalls - m_invalidCallsWritten << " invalid calls, see the log\n";
+            m_invalidCallsWritten = invalidCalls;
+        }
+        //Flushed once per list, so the file is complete up to the last list even if the application stops abruptly
+        m_file.flush();
+    }
+
+    void RecordingRenderDevice::discardRetained()
+    {
+        NullRenderDevice::discardRetained();
+        m_file << "DiscardRetained\n";
+    }
+
+    void RecordingRenderDevice::writeCommand(const RenderCommand& command)
+    {
+        switch (command.type)
+        {
+        case RenderCommandType::SetPipeline:
+            m_file << "  SetPipeline pass=" << command.setPipeline.pass << " program=" << command.setPipeline.program << "\n";
+            break;
+        case RenderCommandType::BindTexture:
+            m_file << "  BindTexture " << command.bindTexture.texture << "\n";
+            break;
+        case RenderCommandType::UploadRange:
+        {
+            const UploadRangeCommand& upload = command.uploadRange;
+            m_file << "  UploadRange " << uploadTargetName(upload.target);
+            if (upload.target == UploadTarget::StaticChunk)
+            {
+                m_file << " chunk=" << upload.index;
+            }
+            m_file << " offset=" << upload.data.offset << " bytes=" << upload.data.size;
+            if (upload.target == UploadTarget::StreamedInstances || upload.target == UploadTarget::StaticChunk)
+            {
+                m_file << " instances=" << upload.data.size / sizeof(SpriteInstance);
+            }
+            m_file << "\n";
+            break;
+        }
+        case RenderCommandType::DrawInstanced:
+            m_file << "  DrawInstanced ";
+            if (command.drawInstanced.chunk == RenderCommandList::STREAMED_INSTANCES)
+            {
+                m_file << "streamed";
+            }
+            else
+            {
+                m_file << "chunk=" << command.drawInstanced.chunk;
+            }
+            m_file << " first=" << command.drawInstanced.first << " count=" << command.drawInstanced.count << "\n";
+            break;
+        case RenderCommandType::DrawSingle:
+            m_file << "  DrawSingle first=" << command.drawSingle.first << " count=" << command.drawSingle.count << "\n";
+            break;
+        case RenderCommandType::DrawLines:
+            m_file << "  DrawLines lines=" << command.drawLines.vertices.size / (2 * sizeof(EngineDebugDraw::DebugVertex)) << "\n";
+            break;
+        }
+    }
+}
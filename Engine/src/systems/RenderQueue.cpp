@@ -0,0 +1,172 @@
+//------- Render Queue ------
+//Sort Keyed Draws
+//For The Sol Core Engine
+//---------------------------
+
+#include "systems/RenderQueue.h"
+
+//C++ libraries
+#include <algorithm>
+#include <future>
+#include <thread>
+
+namespace EcsRenderSystem
+{
+    namespace
+    {
+        const int RADIX_BITS = 8;
+        const int RADIX = 1 << RADIX_BITS;
+        const int PASSES = 64 / RADIX_BITS;
+
+        inline u32 digitOf(u64 key, int pass)
+        {
+            return static_cast<u32>(key >> (pass * RADIX_BITS)) & (RADIX - 1);
+        }
+
+        //Run function(0) to function(count - 1) at once, function(0) on the calling thread, returning once all have finished
+        //Worker threads are std::async tasks, as the Core uses to prepare Elements in parallel
+        template<typename Function>
+        void parallelFor(unsigned int count, const Function& function)
+        {
+            std::vector<std::future<void>> tasks;
+            tasks.reserve(count);
+            for (unsigned int i = 1; i < count; i++)
+            {
+                tasks.push_back(std::async(std::launch::async, [&function, i]() { function(i); }));
+            }
+            function(0);
+            for (auto& task : tasks)
+            {
+                task.get();
+            }
+        }
+    }
+
+    u32 SortKey::depthRank(int layer, int order)
+    {
+        u32 clampedLayer = static_cast<u32>(std::max(0, std::min(layer, MAX_LAYER)));
+        u32 clampedOrder = static_cast<u32>(std::max(MIN_ORDER, std::min(order, MAX_ORDER)) - MIN_ORDER);
+        return (clampedLayer << 16) | clampedOrder;
+    }
+
+    u64 SortKey::make(u32 pass, u32 depthRank, u32 shader, u32 texture)
+    {
+        const u64 maxDepth = (1u << DEPTH_BITS) - 1;
+        u64 depth = std::min<u64>(depthRank, maxDepth);
+        u64 shaderBits = std::min(shader, MAX_SHADER);
+        u64 textureBits = texture & MAX_TEXTURE;
+        u64 key = static_cast<u64>(pass & 0x3) << PASS_SHIFT;
+        if (pass == TRANSLUCENT_PASS)
+        {
+            return key | (depth << 41) | (shaderBits << 29) | (textureBits << 9);
+        }
+        //Front to back, so the nearest draws fill the depth buffer first and the pixels they hide are rejected before shading
+        return key | (shaderBits << 50) | (textureBits << 30) | ((maxDepth - depth) << 9);
+    }
+
+    void RenderQueue::sort()
+    {
+        const size_t count = m_items.size();
+        if (count < 2)
+        {
+            return;
+        }
+        m_scratch.resize(count);
+
+        //Each thread sorts a contiguous chunk of the items, which keeps every pass stable
+        unsigned int threads = 1;
+        if (count >= PARALLEL_THRESHOLD)
+        {
+            unsigned int hardwareThreads = std::thread::hardware_concurrency();
+            threads = hardwareThreads == 0 ? 1 : (hardwareThreads < MAX_SORT_THREADS ? hardwareThreads : MAX_SORT_THREADS);
+        }
+        const size_t chunkSize = (count + threads - 1) / threads;
+
+        //counts[chunk][pass][digit], first filled for every pass in one read of the items
+        m_counts.assign(static_cast<size_t>(threads) * PASSES * RADIX, 0);
+        m_offsets.resize(static_cast<size_t>(threads) * RADIX);
+        auto chunkCounts = [&](unsigned int chunk, int pass) { return &m_counts[(static_cast<size_t>(chunk) * PASSES + pass) * RADIX]; };
+
+        parallelFor(threads, [&](unsigned int chunk)
+        {
+            size_t begin = std::min(count, chunk * chunkSize);
+            size_t end = std::min(count, begin + chunkSize);
+            for (size_t i = begin; i < end; i++)
+            {
+                u64 key = m_items[i].key;
+                for (int pass = 0; pass < PASSES; pass++)
+                {
+                    chunkCounts(chunk, pass)[digitOf(key, pass)]++;
+                }
+            }
+        });
+
+        DrawItem* source = m_items.data();
+        DrawItem* destination = m_scratch.data();
+        bool firstPass = true;
+        for (int pass = 0; pass < PASSES; pass++)
+        {
+            //A digit shared by every item (e.g. the pass when every sprite is translucent) wouldn't reorder anything
+            bool trivial = false;
+            for (int digit = 0; digit < RADIX && !trivial; digit++)
+            {
+                size_t total = 0;
+                for (unsigned int chunk = 0; chunk < threads; chunk++)
+                {
+                    total += chunkCounts(chunk, pass)[digit];
+                }
+                trivial = total == count;
+            }
+            if (trivial)
+            {
+                continue;
+            }
+
+            //The first histograms were of the original order, after a pass each chunk holds different items so is counted again
+            if (!firstPass && threads > 1)
+            {
+                parallelFor(threads, [&](unsigned int chunk)
+                {
+                    size_t* digitCounts = chunkCounts(chunk, pass);
+                    std::fill(digitCounts, digitCounts + RADIX, 0);
+                    size_t begin = std::min(count, chunk * chunkSize);
+                    size_t end = std::min(count, begin + chunkSize);
+                    for (size_t i = begin; i < end; i++)
+                    {
+                        digitCounts[digitOf(source[i].key, pass)]++;
+                    }
+                });
+            }
+            firstPass = false;
+
+            //Each digit's items go after every smaller digit's, and each chunk's after the previous chunks' with the same digit
+            size_t offset = 0;
+            for (int digit = 0; digit < RADIX; digit++)
+            {
+                for (unsigned int chunk = 0; chunk < threads; chunk++)
+                {
+                    m_offsets[chunk * RADIX + digit] = offset;
+                    offset += chunkCounts(chunk, pass)[digit];
+                }
+            }
+
+            parallelFor(threads, [&](unsigned int chunk)
+            {
+                size_t* chunkOffsets = &m_offsets[chunk * RADIX];
+                size_t begin = std::min(count, chunk * chunkSize);
+                size_t end = std::min(count, begin + chunkSize);
+                for (size_t i = begin; i < end; i++)
+                {
+                    destination[chunkOffsets[digitOf(source[i].key, pass)]++] = source[i];
+                }
+            });
+            std::swap(source, destination);
+        }
+
+        //After an odd number of passes the sorted items are in the scratch space
+        if (source != m_items.data())
+        {
+            m_items.swap(m_scratch);
+        }
+    }
+}
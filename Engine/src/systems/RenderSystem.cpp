@@ -7,508 +7,479 @@
 #include "ecs/EcsElement.h"
 #include <iostream>
 #include <algorithm>
+#include <cmath>
 
 #include "Core.h"
 
 namespace EcsRenderSystem
 {
     RenderSystem::RenderSystem(std::shared_ptr<CoreEcsElement::EcsElement> ecsElement)
-        : m_ecsElement(ecsElement), m_mainVAO(0), m_quadVBO(0), m_quadEBO(0)
+        : m_ecsElement(ecsElement)
     {
+        auto core = m_ecsElement->getCore();
+        //Without a Render Element (e.g. headless) the command lists are replayed straight away by the Core's device
+        m_renderElement = core ? core->get<CoreRenderElement::RenderElement>() : nullptr;
+        m_device = core ? &core->getRenderDevice() : nullptr;
         initialize();
     }
 
     RenderSystem::~RenderSystem()
     {
+        //A submitted command list mustn't be replayed once the Render System is gone, and the static chunks are released on the main thread
+        if (m_renderElement) { m_renderElement->discardGameView(); }
+        if (m_device) { m_device->discardRetained(); }
     }
 
     void RenderSystem::initialize()
     {
-        //Creating the two shader program IDs to be used
-        //One for if batch rendering is to being used, one for if not
-        //Check though to see if the sprite's shaderProgram field is 0, if it isn't then render using that shader but do so in a single draw call not instanced draw call
-        
+        //The programs and buffers sprites are drawn with belong to the Core's render device, so only the projection is set up here
         setProjectionMatrix(); //Initial setting of the default project matrix, however this function is called every update to ensure it doesn't need to be changed
+    }
 
-        //Vertex shader source for single drawing
-        const char* singleDrawVertexShaderSource = R"glsl(
-        #version 330 core
-        layout (location = 0) in vec2 aPos;
-        layout (location = 1) in vec2 aTexCoords;
-
-        uniform mat4 uModelMatrix;
-        
-        uniform mat4 view;
-        uniform mat4 projection;
-        uniform bool useWireframe; //Uniform to toggle wireframe rendering
-
-        out vec2 TexCoords;
-
-        void main()
+    void RenderSystem::updateUVRects(RenderCommandList& commands)
+    {
+        if (!m_textureAtlas || m_textureAtlas->getVersion() == m_uvRectsVersion)
         {
-            gl_Position = projection * view * uModelMatrix * vec4(aPos, 0.0, 1.0);
-            TexCoords = aTexCoords;
+            return;
         }
-        )glsl";
-        //Fragment shader source for single drawing
-        const char* singleDrawFragmentShaderSource = R"glsl(
-        #version 330 core
-        out vec4 FragColor;
-
-        in vec2 TexCoords;
+        const auto& rects = m_textureAtlas->getRects();
+        commands.uploadRange(UploadTarget::UVRects, 0, rects.data(), rects.size() * sizeof(CoreResourceElement::AtlasRect));
+        m_uvRectsVersion = m_textureAtlas->getVersion();
+    }
 
-        uniform sampler2D spriteTexture;
-        uniform vec4 lineColor;
-        uniform bool useWireframe;
+    SpriteInstance RenderSystem::packSpriteInstance(const TransformComponent& transform, const SpriteComponent& sprite)
+    {
+        SpriteInstance instance;
+        instance.position = glm::vec2(transform.position);
+        instance.scale = glm::packHalf2x16(glm::vec2(transform.scale) * sprite.size);
+        //Rotation is wrapped into a single turn, so any angle (including negative angles) is representable
+        float turns = transform.rotation / 360.0f;
+        turns -= std::floor(turns);
+        instance.rotation = static_cast<u16>(static_cast<u32>(turns * 65536.0f + 0.5f) & 0xFFFF);
+        instance.depth = SortKey::depthRank(sprite.sortingLayer, sprite.orderInLayer);
+        instance.tint = glm::packUnorm4x8(sprite.color);
+        return instance;
+    }
 
-        void main()
+    //Check if the aspect ratio has changed and if it has, update the projection matrix accordingly
+    void RenderSystem::setProjectionMatrix()
+    {
+        float aspect = ApplicationConfig::Config::screenWidth / ApplicationConfig::Config::screenHeight;
+        if (aspect != m_aspect)
         {
-            if (useWireframe)
-            {
-                FragColor = lineColor;
-            } else {
-                FragColor = texture(spriteTexture, TexCoords);
-            }
-        }
-        )glsl";
-
-        //Vertex shader source for multi drawing
-        const char* multiDrawVertexShaderSource = R"glsl(
-        #version 330 core
-        layout (location = 0) in vec2 aPos;
-        layout (location = 1) in vec2 aTexCoords;
-        layout (location = 2) in mat4 aModelMatrix;
-
-        uniform mat4 view;
-        uniform mat4 projection;
-
-        out vec2 TexCoords;
+            float halfHeight = ApplicationConfig::Config::screenHeight / 2.0f;
+            float halfWidth = halfHeight * aspect;
 
-        void main()
-        {
-            gl_Position = projection * view * aModelMatrix * vec4(aPos, 0.0, 1.0);
-            TexCoords = aTexCoords;
+            m_projectionMatrix = glm::ortho(-halfWidth, halfWidth, -halfHeight, halfHeight, -1.0f, 1.0f); //Set the projection matrix to orthographic and base upon the screen dimensions
+            m_aspect = aspect;
+            m_cameraChanged = true;
         }
-        )glsl";
-        //Fragment shader source for multi drawing
-        const char* multiDrawFragmentShaderSource = R"glsl(
-        #version 330 core
-        out vec4 FragColor;
-
-        in vec2 TexCoords;
-
-        uniform sampler2D spriteTexture;
+    }
 
-        void main()
-        {    
-            FragColor = texture(spriteTexture, TexCoords);
+    void RenderSystem::updateCamera(double deltaTime)
+    {
+        //The primary camera with the lowest Entity, so the choice is stable when several are primary
+        Entity cameraEntity = 0;
+        CameraComponent* camera = nullptr;
+        auto cameraComponents = m_ecsElement->getAllComponentsOfType<CameraComponent>(m_ecsElement->getCore()->getFrameArena());
+        for (const auto& cameraPair : cameraComponents) {
+            if (cameraPair.second->isPrimary && (!camera || cameraPair.first < cameraEntity)) {
+                cameraEntity = cameraPair.first;
+                camera = cameraPair.second.get();
+            }
         }
-        )glsl";
-
-        //Create the two shaders, one for single drawing and one for multi drawing
-        m_defaultShaderID = createShader(singleDrawVertexShaderSource, singleDrawFragmentShaderSource);
-        m_defaultInstanceShaderID = createShader(multiDrawVertexShaderSource, multiDrawFragmentShaderSource);
-
-        //Initialize the VAO, VBO, and EBO to be used for instanced rendering
-        //VAO for managing VBOs
-        //VBO as data container for vertex or instance attributes
-        //EBO for indices to process vertices
-
-        //Generate VAO
-        glGenVertexArrays(1, &m_mainVAO);
-        glBindVertexArray(m_mainVAO);
-
-        //Generate VBO
-        //Originally wrote the positions as (x,y) since 2D, but for depth testing and in the future projection/view matrices (x,y,z) needed
-        //Basic quad vertices for mapping textures to
-        float vertices[] = {
-            //Positions      //Texture Coordinates
-            0.5f, 0.5f, 0.0f,  1.0f, 1.0f, // Vertex 1
-            0.5f, -0.5f, 0.0f, 1.0f, 0.0f, // Vertex 2
-            -0.5f, -0.5f, 0.0f, 0.0f, 0.0f, // Vertex 3
-            -0.5f, 0.5f, 0.0f, 0.0f, 1.0f // Vertex 4
-        };
-        //Gen, bind, and buffer so ready
-        glGenBuffers(1, &m_quadVBO);
-        glBindBuffer(GL_ARRAY_BUFFER, m_quadVBO);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW); //Static as we not changing the vertices' values
-
-        //Generate EBO
-        //Indices for procesing vertex order
-        unsigned int indices[] = {
-            0, 1, 3,
-            1, 2, 3
-        };
-        //Gen, bind, and buffer so ready
-        glGenBuffers(1, &m_quadEBO);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_quadEBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW); //Static as we are not changing the indices' values
-
-        //Specify vertex attribute data
-        //Layout location 0 is the 3 positions (x,y,z)
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-        //Layout location 1 is the 2 texture coords
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-
-        //Initialise the instance buffer for model matrices
-
-        glGenBuffers(1, &m_modelVBO);
-        glBindBuffer(GL_ARRAY_BUFFER, m_modelVBO);
-        //Required for OpenGL to allocate the maximum potential memory possibly needed
-        glBufferData(GL_ARRAY_BUFFER, m_MAX_SPRITES * sizeof(glm::mat4), NULL, GL_DYNAMIC_DRAW); //Dynamic as the matrices data will change a lot
-
-        //Specify instance attribute data
-        //Loop 4 times since the mat4 is split into 4 lots of vec4
-        //So effectively each vec4 is a vertex attribute and 4 of those make up the mat4
-        //In this case since the vertices' positional data is in layout location 0, and the texture coords are in layout location 1, need to start at 2
-        //And increment this by 1 each time since there are 4 vec4 to be stored
-        //First vec4 will be in layout 2, then the next in layout 3, and so on
-        //Effectively:
-        //Layout 2 is like an array of the first vec4 of every matrix being processed, layout 3 gets the second, and so forth
-        //And then 
-        for (unsigned int i = 0; i < 4; i++) {
-            glEnableVertexAttribArray(i + 2);
-            //Set which attribute to modify, then number of values per attribute, 
-            //then data type of those values, normalisation status, stride (offset in bytes between consecutive attributes),
-            //then the pointer which specifies the offset of the first value of the first generic vertex attribute in the array in the data store of the buffer
-            glVertexAttribPointer(i + 2, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(i * sizeof(glm::vec4)));
-            //Attributes per instance not per vertex
-            glVertexAttribDivisor(i + 2, 1);
+        TransformComponent* cameraTransform = camera ? m_ecsElement->findComponent<TransformComponent>(cameraEntity) : nullptr;
+
+        glm::vec2 position(0.0f);
+        float rotation = 0.0f;
+        float zoom = 1.0f;
+        if (cameraTransform) {
+            //Follow only whilst the scene is running, so the camera can be placed freely in the Editor
+            if (camera->follow && m_ecsElement->isSceneRunning()) {
+                const TransformComponent* target = m_ecsElement->findComponent<TransformComponent>(camera->targetEntity);
+                if (target) {
+                    //Close the same fraction of the distance every second, whatever the frame rate
+                    float t = camera->followSpeed > 0.0f ? 1.0f - std::exp(-camera->followSpeed * static_cast<float>(deltaTime)) : 1.0f;
+                    cameraTransform->position.x += (target->position.x - cameraTransform->position.x) * t;
+                    cameraTransform->position.y += (target->position.y - cameraTransform->position.y) * t;
+                }
+            }
+            position = glm::vec2(cameraTransform->position);
+            rotation = glm::radians(cameraTransform->rotation);
+            zoom = std::max(camera->zoom, 0.01f);
         }
 
-        //Unbind the VAO
-        glBindVertexArray(0);
-
-        //Define vertices for a wireframe square
-        float squareVertices[] = {
-            0.5f, 0.5f, 0.0f,  // Top right
-            0.5f, -0.5f, 0.0f, // Bottom right
-            -0.5f, -0.5f, 0.0f, // Bottom left
-            -0.5f, 0.5f, 0.0f  // Top left
-        };
-
-        //Generate VAO and VBO for the wireframe square
-        glGenVertexArrays(1, &m_wireframeSquareVAO);
-        glBindVertexArray(m_wireframeSquareVAO);
-
-        glGenBuffers(1, &m_wireframeSquareVBO);
-        glBindBuffer(GL_ARRAY_BUFFER, m_wireframeSquareVBO);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(squareVertices), squareVertices, GL_STATIC_DRAW);
-
-        //Specify vertex attribute data
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+        //Zoom about the camera's position, after moving and rotating the scene so the camera is at the origin
+        glm::mat4 viewMatrix = glm::scale(glm::mat4(1.0f), glm::vec3(zoom, zoom, 1.0f));
+        viewMatrix = glm::rotate(viewMatrix, -rotation, glm::vec3(0.0f, 0.0f, 1.0f));
+        viewMatrix = glm::translate(viewMatrix, glm::vec3(-position, 0.0f));
+        if (viewMatrix != m_viewMatrix) {
+            m_viewMatrix = viewMatrix;
+            m_cameraChanged = true;
+        }
 
-        //Unbind the VAO
-        glBindVertexArray(0);
+        //The screen's rectangle in the scene, enlarged to bound it if the camera is rotated
+        float halfHeight = ApplicationConfig::Config::screenHeight / 2.0f / zoom;
+        float halfWidth = halfHeight * m_aspect;
+        float c = std::abs(std::cos(rotation));
+        float s = std::abs(std::sin(rotation));
+        glm::vec2 halfExtents(halfWidth * c + halfHeight * s, halfWidth * s + halfHeight * c);
+        m_viewMin = position - halfExtents;
+        m_viewMax = position + halfExtents;
+    }
 
-        //Circle parameters, number of segments to divide the circle into, more segments means a smoother circle
-        const int numSegments = 32;
-        //Define vertices for a wireframe circle
-        float circleVertices[3 * numSegments]; //Vertex count for the circle
+    void RenderSystem::updateSpriteGrid()
+    {
+        u32 structureVersion = m_ecsElement->getStructureVersion();
+        if (!m_cullableSpritesGathered || structureVersion != m_cullableSpritesVersion) {
+            m_cullableSprites.clear();
+            m_spriteGrid.clear();
+            auto& frameArena = m_ecsElement->getCore()->getFrameArena();
+            auto transformComponents = m_ecsElement->getAllComponentsOfType<TransformComponent>(frameArena);
+            auto spriteComponents = m_ecsElement->getAllComponentsOfType<SpriteComponent>(frameArena);
+            auto bodyComponents = m_ecsElement->getAllComponentsOfType<PhysicsBodyComponent>(frameArena);
+
+            //Only the sprites no longer gathered are removed from the static sprite cache, the rest keep their slots
+            //so a sprite that is still there is compared with its cached draw below, and its chunk is left alone if it hasn't changed
+            for (auto slot = m_staticSpriteSlots.begin(); slot != m_staticSpriteSlots.end(); ) {
+                if (spriteComponents.count(slot->first) == 0 || transformComponents.count(slot->first) == 0) {
+                    m_staticSprites.remove(slot->second);
+                    m_freeStaticSpriteSlots.push_back(slot->second);
+                    slot = m_staticSpriteSlots.erase(slot);
+                }
+                else {
+                    ++slot;
+                }
+            }
 
-        for (int i = 0; i < numSegments; ++i) {
-            float angle = 2.0f * M_PI * float(i) / float(numSegments);
-            circleVertices[3 * i] = 0.5f * cosf(angle); //0.5f is the radius
-            circleVertices[3 * i + 1] = 0.5f * sinf(angle);
-            circleVertices[3 * i + 2] = 0.0f;
+            for (const auto& spritePair : spriteComponents) {
+                auto transformPair = transformComponents.find(spritePair.first);
+                if (transformPair != transformComponents.end()) {
+                    auto bodyPair = bodyComponents.find(spritePair.first);
+                    std::shared_ptr<PhysicsBodyComponent> body = bodyPair != bodyComponents.end() ? bodyPair->second : nullptr;
+                    m_cullableSprites.push_back(CullableSprite{ transformPair->second, spritePair.second, body, getStaticSpriteSlot(spritePair.first) });
+                }
+            }
+            m_cullableSpritesVersion = structureVersion;
+            m_cullableSpritesGathered = true;
         }
 
-        //Generate VAO and VBO for the wireframe circle
-        glGenVertexArrays(1, &m_wireframeCircleVAO);
-        glBindVertexArray(m_wireframeCircleVAO);
+        //Transforms and sprites are modified directly (by the Physics System, the Editor, and scripts), so every sprite's bounds are refreshed
+        //This is only a comparison for sprites that haven't moved out of their cells, the grid only changes for those that have
+        //Likewise a static sprite's draw is packed and compared with its cached draw, its chunk is only rebuilt if they differ
+        //A sprite whose body becomes dynamic (or is given a program) moves from its chunk to the grid, and back if it becomes static again
+        for (size_t i = 0; i < m_cullableSprites.size(); i++) {
+            const CullableSprite& cullable = m_cullableSprites[i];
+            glm::vec2 min, max;
+            getSpriteBounds(*cullable.transform, *cullable.sprite, min, max);
+            if (isStatic(cullable)) {
+                m_spriteGrid.remove(static_cast<u32>(i));
+                m_staticSprites.update(cullable.staticSlot, makeSpriteDraw(cullable), min, max);
+            }
+            else {
+                m_staticSprites.remove(cullable.staticSlot);
+                m_spriteGrid.update(static_cast<u32>(i), min, max);
+            }
+        }
+    }
 
-        glGenBuffers(1, &m_wireframeCircleVBO);
-        glBindBuffer(GL_ARRAY_BUFFER, m_wireframeCircleVBO);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(circleVertices), circleVertices, GL_STATIC_DRAW);
+    u32 RenderSystem::getStaticSpriteSlot(Entity entity)
+    {
+        auto found = m_staticSpriteSlots.find(entity);
+        if (found != m_staticSpriteSlots.end()) {
+            return found->second;
+        }
+        u32 slot;
+        if (!m_freeStaticSpriteSlots.empty()) {
+            slot = m_freeStaticSpriteSlots.back();
+            m_freeStaticSpriteSlots.pop_back();
+        }
+        else {
+            slot = static_cast<u32>(m_staticSpriteSlots.size());
+        }
+        m_staticSpriteSlots.emplace(entity, slot);
+        return slot;
+    }
 
-        //Specify vertex attribute data
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    bool RenderSystem::isStatic(const CullableSprite& cullable)
+    {
+        return (!cullable.body || cullable.body->type == BodyType::Static) && cullable.sprite->shaderProgram == 0;
+    }
 
-        //Unbind the VAO
-        glBindVertexArray(0);
+    SpriteDraw RenderSystem::makeSpriteDraw(const CullableSprite& cullable)
+    {
+        SpriteDraw draw;
+        draw.texture = cullable.sprite->textureID;
+        draw.program = cullable.sprite->shaderProgram;
+        draw.instance = packSpriteInstance(*cullable.transform, *cullable.sprite);
+        const CoreResourceElement::AtlasRegion* region = m_textureAtlas ? m_textureAtlas->find(draw.texture) : nullptr;
+        if (region) {
+            draw.texture = region->pageTexture;
+            draw.instance.uvRect = region->rectIndex;
+        }
+        switch (cullable.sprite->blendMode) {
+        case SpriteBlendMode::Opaque:
+            draw.pass = SortKey::OPAQUE_PASS;
+            break;
+        case SpriteBlendMode::AlphaTested:
+            draw.pass = SortKey::ALPHA_TESTED_PASS;
+            break;
+        default:
+            draw.pass = SortKey::TRANSLUCENT_PASS;
+            break;
+        }
+        return draw;
     }
 
-    //Check if the aspect ratio has changed and if it has, update the projection matrix accordingly
-    void RenderSystem::setProjectionMatrix()
+    void RenderSystem::getSpriteBounds(const TransformComponent& transform, const SpriteComponent& sprite, glm::vec2& min, glm::vec2& max)
     {
-        float aspect = ApplicationConfig::Config::screenWidth / ApplicationConfig::Config::screenHeight;
-        if (aspect != m_aspect)
-        {
-            float halfHeight = ApplicationConfig::Config::screenHeight / 2.0f;
-            float halfWidth = halfHeight * aspect;
+        glm::vec2 halfSize = glm::abs(glm::vec2(transform.scale) * sprite.size) * 0.5f;
+        float rotation = glm::radians(transform.rotation);
+        float c = std::abs(std::cos(rotation));
+        float s = std::abs(std::sin(rotation));
+        glm::vec2 halfExtents(halfSize.x * c + halfSize.y * s, halfSize.x * s + halfSize.y * c);
+        min = glm::vec2(transform.position) - halfExtents;
+        max = glm::vec2(transform.position) + halfExtents;
+    }
 
-            m_projectionMatrix = glm::ortho(-halfWidth, halfWidth, -halfHeight, halfHeight, -1.0f, 1.0f); //Set the projection matrix to orthographic and base upon the screen dimensions
-            m_aspect = aspect;
+    u32 RenderSystem::getCustomProgramSortIndex(u32 program)
+    {
+        auto sortIndex = m_customProgramSortIndices.find(program);
+        if (sortIndex != m_customProgramSortIndices.end()) {
+            return sortIndex->second;
         }
+        //Sort index 0 is the default programs
+        u32 assigned = static_cast<u32>(m_customProgramSortIndices.size()) + 1;
+        m_customProgramSortIndices.emplace(program, assigned);
+        return assigned;
     }
 
     void RenderSystem::update(double deltaTime) {
+        SOL_MEMORY_TAG(EngineMemory::MemoryTag::Render);
+        //Get this frame's counters so sprites and draw calls can be counted
+        m_frameCounters = &m_ecsElement->getCore()->getMetrics()->currentFrame();
+        //Count the draw calls of any list replayed since the last frame, with the render thread last frame's list may still be being replayed
+        publishReplayStats(m_commandLists[0]);
+        publishReplayStats(m_commandLists[1]);
+        //Record into the list submitted two frames ago, whose replay has finished
+        RenderCommandList& commands = m_commandLists[m_recordIndex];
+        commands.clear();
         //Check is projection matrix should be changed and if so, change
         setProjectionMatrix();
         //Get all Entities with both TransformComponent and SpriteComponent
-        auto transformComponents = m_ecsElement->getAllComponentsOfType<TransformComponent>();
-        auto spriteComponents = m_ecsElement->getAllComponentsOfType<SpriteComponent>();
-        auto colliderComponents = m_ecsElement->getAllComponentsOfType<ColliderComponent>(); //For use in rendering wireframes if made visible
+        //Everything built here is only needed for this frame, so is allocated from the Core's frame arena
+        auto& frameArena = m_ecsElement->getCore()->getFrameArena();
+
+        //Sprites whose textures are in the texture atlas are drawn from their atlas page, so sprites with different textures share batches
+        auto resourceElement = m_ecsElement->getCore()->getResourceElement();
+        m_textureAtlas = resourceElement ? &resourceElement->getTextureAtlas() : nullptr;
+        updateUVRects(commands);
 
-        std::vector<std::pair<std::shared_ptr<SpriteComponent>, std::shared_ptr<TransformComponent>>> tmpSpriteTransformPairs;
+        //View the scene through the primary camera, and find the sprites and static chunks visible through it
+        updateCamera(deltaTime);
+        if (m_cameraChanged)
+        {
+            glm::mat4* camera = static_cast<glm::mat4*>(commands.uploadRange(UploadTarget::Camera, 0, 2 * sizeof(glm::mat4)));
+            camera[0] = m_viewMatrix;
+            camera[1] = m_projectionMatrix;
+            m_cameraChanged = false;
+        }
+        updateSpriteGrid();
+        EngineMemory::ArenaVector<u32> visibleSprites{ EngineMemory::ArenaAllocator<u32>(frameArena) };
+        m_spriteGrid.query(m_viewMin, m_viewMax, visibleSprites);
+        //The grid returns sprites in an order that changes as they move between cells, and the sort is stable, so sprites with equal keys
+        //(e.g. default translucent sprites sharing an atlas page) would swap draw order as they move, ordering by index keeps it fixed
+        std::sort(visibleSprites.begin(), visibleSprites.end());
+        m_frameCounters->staticChunksRebuilt += m_staticSprites.rebuild(commands);
+        EngineMemory::ArenaVector<u32> visibleChunks{ EngineMemory::ArenaAllocator<u32>(frameArena) };
+        m_staticSprites.query(m_viewMin, m_viewMax, visibleChunks);
+
+        SpriteDraws spriteDraws{ SpriteDraws::allocator_type(frameArena) };
+        spriteDraws.reserve(visibleSprites.size());
 
         //Sprite rendering
-        for (const auto& spritePair : spriteComponents) {
-            auto transformPair = transformComponents.find(spritePair.first);
-            if (transformPair != transformComponents.end()) {
-                tmpSpriteTransformPairs.push_back(std::make_pair(spritePair.second, transformPair->second));
+        //Pack each visible sprite's instance data
+        //The vertex shader builds the transformation from the position, rotation, and scale from the TransformComponent and the sprite's size
+        //Each draw is queued with a sort key of its pass, depth rank, shader, and texture
+        m_renderQueue.clear();
+        m_renderQueue.reserve(visibleSprites.size());
+        for (u32 visibleSprite : visibleSprites) {
+            SpriteDraw draw = makeSpriteDraw(m_cullableSprites[visibleSprite]);
+            u32 shader = draw.program != 0 ? getCustomProgramSortIndex(draw.program) : 0;
+            m_renderQueue.push(SortKey::make(draw.pass, draw.instance.depth, shader, draw.texture), static_cast<u32>(spriteDraws.size()));
+            spriteDraws.push_back(draw);
+        }
+        //Each visible static chunk's batches are queued by the keys they were built with, so they are drawn in order with the streamed sprites
+        StaticBatchDraws staticBatches{ StaticBatchDraws::allocator_type(frameArena) };
+        u32 staticSpritesSubmitted = 0;
+        for (u32 visibleChunk : visibleChunks) {
+            const StaticSpriteCache::Chunk& chunk = m_staticSprites.getChunk(visibleChunk);
+            for (size_t i = 0; i < chunk.batches.size(); i++) {
+                m_renderQueue.push(chunk.batches[i].key, STATIC_BATCH_BIT | static_cast<u32>(staticBatches.size()));
+                staticBatches.push_back(StaticBatchDraw{ 0, visibleChunk, static_cast<u32>(i) });
             }
+            staticSpritesSubmitted += static_cast<u32>(chunk.members.size());
         }
-
-        //New loop for rendering colliders irrespective of sprite components
-        for (const auto& colliderPair : colliderComponents) {
-            auto transformPair = transformComponents.find(colliderPair.first);
-            if (transformPair != transformComponents.end() && colliderPair.second->isVisible) {
-                bool isCircle = colliderPair.second->shapeType == ShapeType::Circle;
-                renderWireframe(*(transformPair->second), *(colliderPair.second), isCircle);
+        m_frameCounters->staticChunksDrawn += static_cast<u32>(visibleChunks.size());
+        m_frameCounters->spritesSubmitted += static_cast<u32>(spriteDraws.size()) + staticSpritesSubmitted;
+        m_frameCounters->spritesCulled += static_cast<u32>(m_cullableSprites.size() - spriteDraws.size() - staticSpritesSubmitted);
+
+        //Sort the sprites to be drawn into their passes
+        //Opaque and alpha tested sprites sharing a shader and texture are consecutive (front to back), translucent sprites go back to front
+        m_renderQueue.sort();
+
+        SpriteDraws sortedDraws{ SpriteDraws::allocator_type(frameArena) };
+        sortedDraws.reserve(spriteDraws.size());
+        StaticBatchDraws sortedStaticBatches{ StaticBatchDraws::allocator_type(frameArena) };
+        sortedStaticBatches.reserve(staticBatches.size());
+        for (const DrawItem& item : m_renderQueue.getItems()) {
+            if (item.index & STATIC_BATCH_BIT) {
+                StaticBatchDraw staticBatch = staticBatches[item.index & ~STATIC_BATCH_BIT];
+                staticBatch.position = sortedDraws.size();
+                sortedStaticBatches.push_back(staticBatch);
+                continue;
             }
+            sortedDraws.push_back(spriteDraws[item.index]);
         }
-
-        //Sort the temporary vector of sprite-transform pairs
-        std::sort(tmpSpriteTransformPairs.begin(), tmpSpriteTransformPairs.end(), //Provides the range of the sort
-            [](const auto& a, const auto& b) { //Input parameters to the lambda function
-                return a.first->textureID < b.first->textureID; //Condition for sorting, i.e. sorting by textureID of sprite
-            });
-
-        //Clear m_modelMatricesCache as otherwise it will infinitely increase
-        m_modelMatricesCache.clear();
-
-        //Calculate model matrices
-        //Used to manipulate sprites based on transformational data from the transform component
-        for (size_t i = 0; i < tmpSpriteTransformPairs.size(); i++) {
-            auto& tmpPair = tmpSpriteTransformPairs[i];
-            //Calculate the model matrix (transformation) using the position, rotation, and scale from the TransformComponent
-            glm::mat4 modelMatrix = glm::mat4(1.0f);
-            
-            modelMatrix = glm::translate(modelMatrix, tmpPair.second->position);
-            modelMatrix = glm::rotate(modelMatrix, glm::radians(tmpPair.second->rotation), glm::vec3(0.0f, 0.0f, 1.0f));
-               
-            modelMatrix = glm::scale(modelMatrix, tmpPair.second->scale);
-            modelMatrix = glm::scale(modelMatrix, glm::vec3(tmpPair.first->size.x, tmpPair.first->size.y, 0));
-
-            m_modelMatricesCache.push_back(modelMatrix);
+        //Every streamed sprite instance, in the order the sprites are drawn, recorded even if there are none so every replay is one frame of the instance buffer
+        SpriteInstance* streamedInstances = static_cast<SpriteInstance*>(commands.uploadRange(UploadTarget::StreamedInstances, 0, sortedDraws.size() * sizeof(SpriteInstance)));
+        for (size_t i = 0; i < sortedDraws.size(); i++) {
+            streamedInstances[i] = sortedDraws[i].instance;
         }
 
-        //Render sprites, but check first to ensure there are any appropriate sprites to be rendered
-        if (tmpSpriteTransformPairs.size() > 0)
+        //Record sprites, but check first to ensure there are any appropriate sprites to be rendered
+        if (sortedDraws.size() > 0 || sortedStaticBatches.size() > 0)
         {
-            renderSprites(tmpSpriteTransformPairs);
+            renderSprites(commands, sortedDraws, sortedStaticBatches);
         }
-    }
-
-    void RenderSystem::fixedUpdate(double fixedTimestep) {
-        //Not necessary for the Render System as it doesn't require fixed updates
-    }
 
-    //For use in creating the default shaders for single drawing and multi drawing
-    unsigned int RenderSystem::createShader(const char* vertexShaderSource, const char* fragmentShaderSource) {
-        //Vertex shader
-        unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-        glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-        glCompileShader(vertexShader);
-        //Check for vertex shader compilation errors
-        int  success;
-        char infoLog[512];
-        glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-        if (!success)
+        //Collider outlines and the physics world are added to the debug draw, then everything in it is drawn with one draw call
+        EngineDebugDraw::DebugDraw& debugDraw = m_ecsElement->getCore()->getDebugDraw();
+        if (debugDraw.isEnabled(EngineDebugDraw::DRAW_COLLIDERS))
         {
-            glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
-            std::cerr << "[ECS - Render System] Cannot Compile Vertex Shader" << std::endl << "Info Log : " << infoLog << std::endl;
+            drawColliders(debugDraw);
         }
-        //Fragment shader
-        unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-        glCompileShader(fragmentShader);
-        //Check for fragment shader compile errors
-        glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-        if (!success)
+        if (debugDraw.isEnabled(EngineDebugDraw::DRAW_PHYSICS))
         {
-            glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
-            std::cerr << "[ECS - Render System] Cannot Compile Fragment Shader" << std::endl << "Info Log : " << infoLog << std::endl;
-        }
-        //Link fragment and vertex shaders
-        unsigned int shaderProgram = glCreateProgram();
-        glAttachShader(shaderProgram, vertexShader);
-        glAttachShader(shaderProgram, fragmentShader);
-        glLinkProgram(shaderProgram);
-        //Check for linking errors
-        glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-        if (!success) {
-            glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-            std::cerr << "[ECS - Render System] Cannot Link Program" << std::endl << "Info Log : " << infoLog << std::endl;
-        }
-        //Delete shaders since program has been created
-        glDeleteShader(vertexShader);
-        glDeleteShader(fragmentShader);
-        return shaderProgram;
-    }
-
-    //Determine whether to use single drawing or multi drawing depending on the number of sprites to be rendered (with the same texture)
-    //Make calls to these functions based on this decision
-    void RenderSystem::renderSprites(std::vector<std::pair<std::shared_ptr<SpriteComponent>, std::shared_ptr<TransformComponent>>> tmpSpriteTransformPairs) {
-        GLsizei numSpritesByTexture = 1;
-        int currentTexture = tmpSpriteTransformPairs[0].first->textureID;
-        size_t numSpritesRenderedBeforeThisBatch = 0;
-
-        //Bind the shared VAO
-        glBindVertexArray(m_mainVAO);
-
-        for (size_t i = 0; i < tmpSpriteTransformPairs.size(); i++) {
-
-            //If the next sprite has a different textureID, render the batch using the current texture ID
-            //If the number of sprites in the batch is too little for instanced rendering by the textureID to be worth it, then draw individually
-            //If the number of sprites in the batch is high enough for instanced rendering by the textureID to be worth it, buffer the batch, then draw instanced
-            if (tmpSpriteTransformPairs[i].first->textureID != currentTexture) {
-
-                //If there aren't enough sprites in this batch to make the benefit of instanced rendering greater than the deficit of the overhead of buffering the model matrices then
-                //For every sprite in the right range (essentially offset by the number of sprites already rendered in this frame before this batch (not including any in this batch)
-                //Render those sprites one by one
-                if (numSpritesByTexture < m_MIN_SPRITES_FOR_INSTANCING) {
-                    singleDraw(currentTexture, numSpritesByTexture, numSpritesRenderedBeforeThisBatch);
-                }
-
-                //If there are enough sprites in this batch to make the benefit of instanced rendering greater than the deficit of the overhead of buffering the model matrices then
-                else {
-                    multiDraw(currentTexture, numSpritesByTexture, numSpritesRenderedBeforeThisBatch);
-                }
-
-                //When the batch is finished drawing, update the numSpritesRenderedBeforeThisBatch
-                numSpritesRenderedBeforeThisBatch += numSpritesByTexture;
-                //Set current texture to the ID of the next texture, and reset numSpritesByTexture
-                currentTexture = tmpSpriteTransformPairs[i].first->textureID;
-                numSpritesByTexture = 1;
-            }
-            //Checking the one after, but also making sure the one after won't be out of bounds
-            if (i != tmpSpriteTransformPairs.size() - 1 && tmpSpriteTransformPairs[i + 1].first->textureID == currentTexture) {
-                numSpritesByTexture++;
+            auto physicsElement = m_ecsElement->getCore()->getPhysicsElement();
+            if (physicsElement)
+            {
+                physicsElement->drawDebug(debugDraw, m_scalingFactor);
             }
         }
+        const auto& debugVertices = debugDraw.getVertices();
+        if (!debugVertices.empty())
+        {
+            commands.drawLines(debugVertices.data(), debugVertices.size() * sizeof(EngineDebugDraw::DebugVertex));
+        }
+        m_frameCounters->debugLines += static_cast<u32>(debugDraw.getLineCount());
 
-        //Need to render the final batch as the loop won't render the final batch due to there being no next sprite texture ID to check
-        //If the number of sprites in the batch is too little for instanced rendering by the textureID to be worth it, then draw individually
-        //If the number of sprites in the batch is high enough for instanced rendering by the textureID to be worth it, buffer the batch, then draw instanced
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, currentTexture);
-        if (numSpritesByTexture < m_MIN_SPRITES_FOR_INSTANCING) {
-            singleDraw(currentTexture, numSpritesByTexture, numSpritesRenderedBeforeThisBatch);
+        //Replayed straight away, or by the render thread once this frame has been presented
+        m_recordIndex = 1 - m_recordIndex;
+        RenderDevice* device = m_device;
+        if (m_renderElement)
+        {
+            m_renderElement->submitGameView([device, &commands]() { device->execute(commands); });
         }
-        //If there are enough sprites in this batch to make the benefit of instanced rendering greater than the deficit of the overhead of buffering the model matrices then
-        else {
-            multiDraw(currentTexture, numSpritesByTexture, numSpritesRenderedBeforeThisBatch);
+        else if (device)
+        {
+            device->execute(commands);
         }
-
-        //Unind the shared VAO
-        glBindVertexArray(0);
+        publishReplayStats(commands);
     }
 
-    //Non-instanced rendering
-    void RenderSystem::singleDraw(int currentTexture, GLsizei numSpritesByTexture, size_t numSpritesRenderedBeforeThisBatch) {
-        //Bind the texture for this batch of sprites
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, currentTexture);
-        glUseProgram(m_defaultShaderID);
-        //Get uniform location
-        GLint modelLoc = glGetUniformLocation(m_defaultShaderID, "uModelMatrix");
-        GLint viewLoc = glGetUniformLocation(m_defaultShaderID, "view");
-        GLint projLoc = glGetUniformLocation(m_defaultShaderID, "projection");
-        glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(m_viewMatrix));
-        glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(m_projectionMatrix));
-        //Looping through the correct section of the model matrices cache, and rendering one by one
-        for (size_t j = numSpritesRenderedBeforeThisBatch; j < numSpritesRenderedBeforeThisBatch + numSpritesByTexture; j++) {
-
-            glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(m_modelMatricesCache[j]));
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-            glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    void RenderSystem::publishReplayStats(RenderCommandList& commands)
+    {
+        if (!commands.isReplayed() || commands.areStatsPublished())
+        {
+            return;
         }
-        //Unbind
-        glBindTexture(GL_TEXTURE_2D, 0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        const ReplayStats& stats = commands.getStats();
+        m_frameCounters->drawCalls += stats.drawCalls;
+        m_frameCounters->instancedDrawCalls += stats.instancedDrawCalls;
+        m_frameCounters->singleDrawCalls += stats.singleDrawCalls;
+        m_frameCounters->glCallsIssued += stats.glCallsIssued;
+        m_frameCounters->glCallsSkipped += stats.glCallsSkipped;
+        m_frameCounters->instanceBufferBytes = stats.instanceBufferBytes;
+        m_frameCounters->instanceBufferPeakBytes = stats.instanceBufferPeakBytes;
+        m_frameCounters->instanceBufferAllocatedBytes = stats.instanceBufferAllocatedBytes;
+        commands.setStatsPublished();
     }
 
-    //Instanced (batch) rendering
-    void RenderSystem::multiDraw(int currentTexture, GLsizei numSpritesByTexture, size_t numSpritesRenderedBeforeThisBatch) {
-        //Buffer the model matrix data of these sprites to the GPU to be used for instanced rendering
-        //Add all model matrices in the appropriate range to a temporary store, to be used to buffer sub data
-        std::vector<glm::mat4> tmpModelMatricesVec(m_modelMatricesCache.begin() + numSpritesRenderedBeforeThisBatch,
-            m_modelMatricesCache.begin() + numSpritesRenderedBeforeThisBatch + numSpritesByTexture);
-        glBindBuffer(GL_ARRAY_BUFFER, m_modelVBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, tmpModelMatricesVec.size() * sizeof(glm::mat4), tmpModelMatricesVec.data());
-        tmpModelMatricesVec.clear();
-        //Bind the texture for this batch of sprites
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, currentTexture);
-        glUseProgram(m_defaultInstanceShaderID);
-        //Get uniform location
-        GLint viewLoc = glGetUniformLocation(m_defaultInstanceShaderID, "view");
-        GLint projLoc = glGetUniformLocation(m_defaultInstanceShaderID, "projection");
-        glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(m_viewMatrix));
-        glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(m_projectionMatrix));
-        //Draw the batch of sprites via instanced rendering
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr, numSpritesByTexture);
-        //Unbind
-        glBindTexture(GL_TEXTURE_2D, 0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    void RenderSystem::fixedUpdate(double fixedTimestep) {
+        //Not necessary for the Render System as it doesn't require fixed updates
     }
 
-    //Render a square or cicle wireframe for an Entity whose collider is set to be visible in the Editor
-    void RenderSystem::renderWireframe(const TransformComponent& transform, const ColliderComponent& collider, bool isCircle) {
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, glm::vec3(transform.position.x, transform.position.y, 0.0f));
-        model = glm::rotate(model, glm::radians(transform.rotation), glm::vec3(0.0f, 0.0f, 1.0f));
-
-        glm::vec3 sizeInPixels;
-        if (isCircle) {
-            //Convert the radius from meters to pixels and calculate the diameter for scaling
-            float diameterInPixels = collider.radius * 2.0f * m_scalingFactor;
-            sizeInPixels = glm::vec3(diameterInPixels, diameterInPixels, 1.0f);
-        }
-        else {
-            //Box collider sizing
-            sizeInPixels = glm::vec3(collider.width * m_scalingFactor, collider.height * m_scalingFactor, 1.0f);
-        }
-
-        model = glm::scale(model, sizeInPixels); //Apply the size in pixels
-        model = glm::scale(model, glm::vec3(transform.scale.x, transform.scale.y, 1.0f)); //Then apply any additional scaling from the transform
-
-        glUseProgram(m_defaultShaderID);
-
-        GLint modelLoc = glGetUniformLocation(m_defaultShaderID, "uModelMatrix");
-        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-
-        GLint viewLoc = glGetUniformLocation(m_defaultShaderID, "uViewMatrix");
-        GLint projLoc = glGetUniformLocation(m_defaultShaderID, "uProjectionMatrix");
-        glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(m_viewMatrix));
-        glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(m_projectionMatrix));
-
-        GLint useWireframeLoc = glGetUniformLocation(m_defaultShaderID, "useWireframe");
-        GLint lineColorLoc = glGetUniformLocation(m_defaultShaderID, "lineColor");
-
-        glUniform1i(useWireframeLoc, GL_TRUE);
-        glUniform4f(lineColorLoc, 1.0f, 0.0f, 0.0f, 1.0f); //Red color for wireframe
+    //Determine whether to use single drawing or multi drawing depending on the number of sprites to be rendered (with the same texture and program)
+    //Record calls to these based on this decision
+    void RenderSystem::renderSprites(RenderCommandList& commands, const SpriteDraws& spriteDraws, const StaticBatchDraws& staticBatchDraws) {
+        SOL_PROFILE_FUNCTION();
+        //Static batches are drawn where they were sorted to, before the sprite draw at their position
+        //Static batches are always instanced, as their instances are already on the GPU
+        size_t nextStaticBatch = 0;
+        auto drawStaticBatchesAt = [&](size_t position) {
+            while (nextStaticBatch < staticBatchDraws.size() && staticBatchDraws[nextStaticBatch].position == position) {
+                const StaticBatchDraw& staticBatchDraw = staticBatchDraws[nextStaticBatch];
+                const StaticSpriteCache::Batch& batch = m_staticSprites.getChunk(staticBatchDraw.chunk).batches[staticBatchDraw.batch];
+                commands.setPipeline(batch.pass, 0);
+                commands.bindTexture(batch.texture);
+                commands.drawInstanced(staticBatchDraw.chunk, batch.first, batch.count);
+                nextStaticBatch++;
+            }
+        };
+        drawStaticBatchesAt(0);
 
-        if (isCircle) {
-            glBindVertexArray(m_wireframeCircleVAO);
-            glDrawArrays(GL_LINE_LOOP, 0, 32); //Circle is made of 32 segments, as decided in the initialise function
+        //The sprites are sorted, so sprites with the same pass, texture, and program are consecutive unless translucent sprites are separated by depth
+        //Each run of them is one batch, drawn once the next sprite's pass, texture, or program differs, a static batch comes between them, or there is no next sprite
+        size_t numSpritesRenderedBeforeThisBatch = 0;
+        for (size_t i = 1; i <= spriteDraws.size(); i++) {
+            const SpriteDraw& batch = spriteDraws[numSpritesRenderedBeforeThisBatch];
+            bool staticBatchNext = nextStaticBatch < staticBatchDraws.size() && staticBatchDraws[nextStaticBatch].position == i;
+            if (i < spriteDraws.size() && !staticBatchNext && spriteDraws[i].pass == batch.pass && spriteDraws[i].texture == batch.texture && spriteDraws[i].program == batch.program) {
+                continue;
+            }
+            u32 first = static_cast<u32>(numSpritesRenderedBeforeThisBatch);
+            u32 numSpritesInBatch = static_cast<u32>(i - numSpritesRenderedBeforeThisBatch);
+            commands.setPipeline(batch.pass, batch.program);
+            commands.bindTexture(batch.texture);
+
+            //Sprites with their own program are always drawn one by one, since the instanced vertex shader is specific to the default program
+            //If there aren't enough sprites in this batch to make the benefit of instanced rendering greater than the deficit of the overhead of buffering the instances then
+            //Render those sprites one by one
+            if (batch.program != 0 || numSpritesInBatch < m_MIN_SPRITES_FOR_INSTANCING) {
+                commands.drawSingle(first, numSpritesInBatch);
+            }
+            //If there are enough sprites in this batch to make the benefit of instanced rendering greater than the deficit of the overhead of buffering the instances then
+            else {
+                commands.drawInstanced(RenderCommandList::STREAMED_INSTANCES, first, numSpritesInBatch);
+            }
+            numSpritesRenderedBeforeThisBatch = i;
+            drawStaticBatchesAt(i);
         }
-        else {
-            glBindVertexArray(m_wireframeSquareVAO);
-            glDrawArrays(GL_LINE_LOOP, 0, 4); //4 vertices for the square
+    }
+
+    //Outline a box or circle for every Entity whose collider is set to be visible in the Editor, in the collider's size in pixels scaled by the transform
+    void RenderSystem::drawColliders(EngineDebugDraw::DebugDraw& debugDraw) {
+        auto colliderComponents = m_ecsElement->getAllComponentsOfType<ColliderComponent>(m_ecsElement->getCore()->getFrameArena());
+        const u32 colliderColor = EngineDebugDraw::DebugDraw::color(1.0f, 0.0f, 0.0f); //Red color for colliders
+        for (const auto& colliderPair : colliderComponents) {
+            const ColliderComponent& collider = *(colliderPair.second);
+            if (!collider.isVisible) {
+                continue;
+            }
+            const TransformComponent* transform = m_ecsElement->findComponent<TransformComponent>(colliderPair.first);
+            if (!transform) {
+                continue;
+            }
+            glm::vec2 centre = glm::vec2(transform->position);
+            if (collider.shapeType == ShapeType::Circle) {
+                //Convert the radius from meters to pixels, an unevenly scaled circle is outlined with its x scale
+                debugDraw.circle(centre, collider.radius * m_scalingFactor * std::abs(transform->scale.x), colliderColor);
+            }
+            else {
+                glm::vec2 halfExtents = glm::vec2(collider.width, collider.height) * (m_scalingFactor * 0.5f) * glm::abs(glm::vec2(transform->scale));
+                debugDraw.box(centre, halfExtents, glm::radians(transform->rotation), colliderColor);
+            }
         }
-        //Unbind
-        glUniform1i(useWireframeLoc, GL_FALSE);
-        glBindVertexArray(0);
-        glUseProgram(0);
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,188 @@
+//------- Spatial Grid ------
+//Uniform Grid For Culling
+//For The Sol Core Engine
+//---------------------------
+
+#include "systems/SpatialGrid.h"
+
+//C++ libraries
+#include <algorithm>
+#include <cmath>
+
+namespace EcsRenderSystem
+{
+    int SpatialGrid::cellCoordinate(float position)
+    {
+        //Clamped so far away (or non-finite) positions can't overflow the conversion
+        float cell = std::floor(position / CELL_SIZE);
+        if (!(cell > -1.0e9f))
+        {
+            return -1000000000;
+        }
+        return static_cast<int>(std::min(cell, 1.0e9f));
+    }
+
+    u64 SpatialGrid::cellKey(int x, int y)
+    {
+        return (static_cast<u64>(static_cast<u32>(x)) << 32) | static_cast<u32>(y);
+    }
+
+    void SpatialGrid::update(u32 item, const glm::vec2& min, const glm::vec2& max)
+    {
+        if (item >= m_items.size())
+        {
+            m_items.resize(item + 1);
+        }
+        Item& entry = m_items[item];
+        entry.min = min;
+        entry.max = max;
+
+        int cellMinX = cellCoordinate(min.x);
+        int cellMinY = cellCoordinate(min.y);
+        int cellMaxX = cellCoordinate(max.x);
+        int cellMaxY = cellCoordinate(max.y);
+        bool large = cellMaxX - cellMinX >= MAX_ITEM_CELLS || cellMaxY - cellMinY >= MAX_ITEM_CELLS;
+        //Most updates are of items that haven't left their cells, which need nothing more
+        if (entry.present && entry.large == large &&
+            (large || (entry.cellMinX == cellMinX && entry.cellMinY == cellMinY && entry.cellMaxX == cellMaxX && entry.cellMaxY == cellMaxY)))
+        {
+            return;
+        }
+
+        if (entry.present)
+        {
+            removeFromCells(item);
+        }
+        entry.cellMinX = cellMinX;
+        entry.cellMinY = cellMinY;
+        entry.cellMaxX = cellMaxX;
+        entry.cellMaxY = cellMaxY;
+        entry.large = large;
+        entry.present = true;
+        insertIntoCells(item);
+    }
+
+    void SpatialGrid::remove(u32 item)
+    {
+        if (item < m_items.size() && m_items[item].present)
+        {
+            removeFromCells(item);
+            m_items[item].present = false;
+        }
+    }
+
+    void SpatialGrid::clear()
+    {
+        m_items.clear();
+        m_cells.clear();
+        m_largeItems.clear();
+    }
+
+    void SpatialGrid::insertIntoCells(u32 item)
+    {
+        const Item& entry = m_items[item];
+        if (entry.large)
+        {
+            m_largeItems.push_back(item);
+            return;
+        }
+        for (int y = entry.cellMinY; y <= entry.cellMaxY; y++)
+        {
+            for (int x = entry.cellMinX; x <= entry.cellMaxX; x++)
+            {
+                m_cells[cellKey(x, y)].push_back(item);
+            }
+        }
+    }
+
+    void SpatialGrid::removeFromCells(u32 item)
+    {
+        const Item& entry = m_items[item];
+        if (entry.large)
+        {
+            m_largeItems.erase(std::find(m_largeItems.begin(), m_largeItems.end(), item));
+            return;
+        }
+        for (int y = entry.cellMinY; y <= entry.cellMaxY; y++)
+        {
+            for (int x = entry.cellMinX; x <= entry.cellMaxX; x++)
+            {
+                auto cell = m_cells.find(cellKey(x, y));
+                std::vector<u32>& items = cell->second;
+                //Order within a cell doesn't matter, so swap with the last item rather than shifting
+                *std::find(items.begin(), items.end(), item) = items.back();
+                items.pop_back();
+                if (items.empty())
+                {
+                    m_cells.erase(cell);
+                }
+            }
+        }
+    }
+
+    void SpatialGrid::test(u32 item, const glm::vec2& min, const glm::vec2& max, EngineMemory::ArenaVector<u32>& items)
+    {
+        Item& entry = m_items[item];
+        if (entry.queryStamp == m_queryStamp)
+        {
+            return;
+        }
+        entry.queryStamp = m_queryStamp;
+        if (entry.max.x >= min.x && entry.min.x <= max.x && entry.max.y >= min.y && entry.min.y <= max.y)
+        {
+            items.push_back(item);
+        }
+    }
+
+    void SpatialGrid::query(const glm::vec2& min, const glm::vec2& max, EngineMemory::ArenaVector<u32>& items)
+    {
+        m_queryStamp++;
+        if (m_queryStamp == 0)
+        {
+            //Wrapped around, so clear every stamp rather than risk matching one from 2^32 queries ago
+            for (Item& entry : m_items)
+            {
+                entry.queryStamp = 0;
+            }
+            m_queryStamp = 1;
+        }
+
+        for (u32 item : m_largeItems)
+        {
+            test(item, min, max, items);
+        }
+
+        int cellMinX = cellCoordinate(min.x);
+        int cellMinY = cellCoordinate(min.y);
+        int cellMaxX = cellCoordinate(max.x);
+        int cellMaxY = cellCoordinate(max.y);
+        //When zoomed far out the rectangle can cover more cells than exist, so visit the existing cells instead
+        double rectangleCells = (static_cast<double>(cellMaxX) - cellMinX + 1) * (static_cast<double>(cellMaxY) - cellMinY + 1);
+        if (rectangleCells > static_cast<double>(m_cells.size()))
+        {
+            for (const auto& cell : m_cells)
+            {
+                for (u32 item : cell.second)
+                {
+                    test(item, min, max, items);
+                }
+            }
+            return;
+        }
+        for (int y = cellMinY; y <= cellMaxY; y++)
+        {
+            for (int x = cellMinX; x <= cellMaxX; x++)
+            {
+                auto cell = m_cells.find(cellKey(x, y));
+                if (cell == m_cells.end())
+                {
+                    continue;
+                }
+                for (u32 item : cell->second)
+                {
+                    test(item, min, max, items);
+                }
+            }
+        }
+    }
+}
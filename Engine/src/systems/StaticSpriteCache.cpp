@@ -0,0 +1,194 @@
+//------- Static Sprites ----
+//Retained Static Sprite Batches
+//For The Sol Core Engine
+//---------------------------
+
+#include "systems/StaticSpriteCache.h"
+#include "systems/RenderQueue.h"
+
+//C++ libraries
+#include <algorithm>
+#include <cmath>
+
+namespace EcsRenderSystem
+{
+    namespace
+    {
+        bool sameDraw(const SpriteDraw& a, const SpriteDraw& b)
+        {
+            return a.texture == b.texture && a.program == b.program && a.pass == b.pass &&
+                a.instance.position == b.instance.position && a.instance.scale == b.instance.scale && a.instance.tint == b.instance.tint &&
+                a.instance.depth == b.instance.depth && a.instance.rotation == b.instance.rotation && a.instance.uvRect == b.instance.uvRect;
+        }
+
+        int chunkCoordinate(float position)
+        {
+            //Clamped so far away (or non-finite) positions can't overflow the conversion
+            float chunk = std::floor(position / StaticSpriteCache::CHUNK_SIZE);
+            if (!(chunk > -1.0e9f))
+            {
+                return -1000000000;
+            }
+            return static_cast<int>(std::min(chunk, 1.0e9f));
+        }
+    }
+
+    u64 StaticSpriteCache::chunkKey(const glm::vec2& position)
+    {
+        return (static_cast<u64>(static_cast<u32>(chunkCoordinate(position.x))) << 32) | static_cast<u32>(chunkCoordinate(position.y));
+    }
+
+    void StaticSpriteCache::update(u32 item, const SpriteDraw& draw, const glm::vec2& min, const glm::vec2& max)
+    {
+        if (item >= m_items.size())
+        {
+            m_items.resize(item + 1);
+        }
+        Item& entry = m_items[item];
+        //Most static sprites haven't changed, which needs nothing more
+        if (entry.present && sameDraw(entry.draw, draw))
+        {
+            return;
+        }
+
+        u64 key = chunkKey(draw.instance.position);
+        auto found = m_chunksByKey.find(key);
+        u32 chunk;
+        if (found != m_chunksByKey.end())
+        {
+            chunk = found->second;
+        }
+        else
+        {
+            chunk = static_cast<u32>(m_chunks.size());
+            m_chunks.emplace_back();
+            m_chunksByKey.emplace(key, chunk);
+        }
+
+        if (entry.present && entry.chunk != chunk)
+        {
+            remove(item);
+        }
+        if (!entry.present)
+        {
+            m_chunks[chunk].members.push_back(item);
+            entry.chunk = chunk;
+            entry.present = true;
+            m_spriteCount++;
+        }
+        entry.draw = draw;
+        entry.min = min;
+        entry.max = max;
+        markDirty(chunk);
+    }
+
+    void StaticSpriteCache::remove(u32 item)
+    {
+        if (item >= m_items.size() || !m_items[item].present)
+        {
+            return;
+        }
+        Item& entry = m_items[item];
+        std::vector<u32>& members = m_chunks[entry.chunk].members;
+        //Order within a chunk doesn't matter (its instances are sorted when it is rebuilt), so swap with the last member rather than shifting
+        *std::find(members.begin(), members.end(), item) = members.back();
+        members.pop_back();
+        markDirty(entry.chunk);
+        entry.present = false;
+        m_spriteCount--;
+    }
+
+    void StaticSpriteCache::clear(RenderCommandList& commands)
+    {
+        //Chunk indices are reused once cleared, so every chunk's buffer is released before they are
+        for (size_t i = 0; i < m_chunks.size(); i++)
+        {
+            commands.uploadRange(UploadTarget::StaticChunk, static_cast<u32>(i), nullptr, 0);
+        }
+        m_items.clear();
+        m_chunks.clear();
+        m_chunksByKey.clear();
+        m_dirtyChunks.clear();
+        m_spriteCount = 0;
+    }
+
+    void StaticSpriteCache::markDirty(u32 chunk)
+    {
+        if (!m_chunks[chunk].dirty)
+        {
+            m_chunks[chunk].dirty = true;
+            m_dirtyChunks.push_back(chunk);
+        }
+    }
+
+    u32 StaticSpriteCache::rebuild(RenderCommandList& commands)
+    {
+        u32 rebuilt = static_cast<u32>(m_dirtyChunks.size());
+        for (u32 chunk : m_dirtyChunks)
+        {
+            rebuildChunk(chunk, commands);
+        }
+        m_dirtyChunks.clear();
+        return rebuilt;
+    }
+
+    void StaticSpriteCache::rebuildChunk(u32 index, RenderCommandList& commands)
+    {
+        Chunk& chunk = m_chunks[index];
+        chunk.dirty = false;
+        chunk.batches.clear();
+        chunk.min = glm::vec2(1.0f);
+        chunk.max = glm::vec2(-1.0f);
+        if (chunk.members.empty())
+        {
+            commands.uploadRange(UploadTarget::StaticChunk, index, nullptr, 0);
+            return;
+        }
+
+        //Sorted by the same keys as streamed sprites, so each batch is consecutive and in its pass's order
+        m_sortScratch.clear();
+        for (u32 member : chunk.members)
+        {
+            const SpriteDraw& draw = m_items[member].draw;
+            m_sortScratch.emplace_back(SortKey::make(draw.pass, draw.instance.depth, 0, draw.texture), member);
+        }
+        std::sort(m_sortScratch.begin(), m_sortScratch.end());
+
+        m_instanceScratch.clear();
+        chunk.min = m_items[chunk.members[0]].min;
+        chunk.max = m_items[chunk.members[0]].max;
+        for (const auto& sorted : m_sortScratch)
+        {
+            const Item& entry = m_items[sorted.second];
+            chunk.min = glm::min(chunk.min, entry.min);
+            chunk.max = glm::max(chunk.max, entry.max);
+
+            //Opaque and alpha tested sprites of a texture are one batch whatever their depth, as the depth test orders them
+            //Translucent sprites are only batched with sprites of the same depth rank, so batches can be drawn back to front between streamed sprites
+            Batch* batch = chunk.batches.empty() ? nullptr : &chunk.batches.back();
+            if (!batch || batch->pass != entry.draw.pass || batch->texture != entry.draw.texture ||
+                (entry.draw.pass == SortKey::TRANSLUCENT_PASS && m_instanceScratch.back().depth != entry.draw.instance.depth))
+            {
+                chunk.batches.push_back(Batch{ sorted.first, entry.draw.texture, entry.draw.pass, static_cast<u32>(m_instanceScratch.size()), 0 });
+                batch = &chunk.batches.back();
+            }
+            batch->count++;
+            m_instanceScratch.push_back(entry.draw.instance);
+        }
+
+        commands.uploadRange(UploadTarget::StaticChunk, index, m_instanceScratch.data(), m_instanceScratch.size() * sizeof(SpriteInstance));
+    }
+
+    void StaticSpriteCache::query(const glm::vec2& min, const glm::vec2& max, EngineMemory::ArenaVector<u32>& chunks) const
+    {
+        //There are far fewer chunks than sprites, so every chunk is tested
+        for (size_t i = 0; i < m_chunks.size(); i++)
+        {
+            const Chunk& chunk = m_chunks[i];
+            if (!chunk.batches.empty() && chunk.max.x >= min.x && chunk.min.x <= max.x && chunk.max.y >= min.y && chunk.min.y <= max.y)
+            {
+                chunks.push_back(static_cast<u32>(i));
+            }
+        }
+    }
+}
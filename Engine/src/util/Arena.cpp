@@ -0,0 +1,93 @@
+//------- Arena -------------
+//Linear Arena Allocation
+//For The Sol Core Engine
+//---------------------------
+
+#include "util/Arena.h"
+
+//C++ libraries
+#include <algorithm>
+#include <cstring>
+
+namespace EngineMemory
+{
+	namespace
+	{
+		//Smallest block an arena allocates, so a fresh arena doesn't allocate a block per container
+		const std::size_t MIN_ARENA_BLOCK_SIZE = 64 * 1024;
+	}
+
+	LinearArena::LinearArena(std::size_t initialCapacity)
+	{
+		if (initialCapacity > 0)
+		{
+			m_blocks.emplace_back();
+			m_blocks.back().memory.reset(new char[initialCapacity]);
+			m_blocks.back().size = initialCapacity;
+			m_current = m_blocks.back().memory.get();
+			m_end = m_current + initialCapacity;
+		}
+	}
+
+	void* LinearArena::allocateFromNewBlock(std::size_t size, std::size_t alignment)
+	{
+		//Blocks at least double, so an arena needs only a few blocks however large its first frame is
+		if (!m_blocks.empty())
+		{
+			m_usedInFullBlocks += static_cast<std::size_t>(m_current - m_blocks.back().memory.get());
+		}
+		std::size_t blockSize = std::max(std::max(size + alignment, MIN_ARENA_BLOCK_SIZE), getCapacity());
+		m_blocks.emplace_back();
+		m_blocks.back().memory.reset(new char[blockSize]);
+		m_blocks.back().size = blockSize;
+		m_current = m_blocks.back().memory.get();
+		m_end = m_current + blockSize;
+		return allocate(size, alignment);
+	}
+
+	void LinearArena::reset()
+	{
+		m_peak = std::max(m_peak, getUsed());
+#ifdef _DEBUG
+		//Anything still pointing into the arena after a reset reads garbage rather than stale (but plausible) data
+		if (m_blocks.size() == 1)
+		{
+			std::memset(m_blocks.back().memory.get(), 0xCD, static_cast<std::size_t>(m_current - m_blocks.back().memory.get()));
+		}
+#endif
+		if (m_blocks.size() > 1)
+		{
+			//Coalesce into one block that fits everything the arena has needed so far, after which reset no longer allocates
+			std::size_t capacity = getCapacity();
+			m_blocks.clear();
+			m_blocks.emplace_back();
+			m_blocks.back().memory.reset(new char[capacity]);
+			m_blocks.back().size = capacity;
+		}
+		m_usedInFullBlocks = 0;
+		if (!m_blocks.empty())
+		{
+			m_current = m_blocks.back().memory.get();
+			m_end = m_current + m_blocks.back().size;
+		}
+	}
+
+	std::size_t LinearArena::getUsed() const
+	{
+		if (m_blocks.empty())
+		{
+			return 0;
+		}
+		return m_usedInFullBlocks + static_cast<std::size_t>(m_current - m_blocks.back().memory.get());
+	}
+
+	std::size_t LinearArena::getCapacity() const
+	{
+		std::size_t capacity = 0;
+		for (const auto& block : m_blocks)
+		{
+			capacity += block.size;
+		}
+		return capacity;
+	}
+}
@@ -0,0 +1,610 @@
+//------- Binary Log --------
+//Structured Binary Logging
+//For The Sol Core Engine
+//---------------------------
+
+#include "util/BinaryLog.h"
+#include "util/Log.h"
+
+//C++ libraries
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+namespace EngineLog
+{
+	namespace
+	{
+		const char BINARY_LOG_MAGIC[8] = { 'S', 'O', 'L', 'B', 'N', 'L', 'O', 'G' };
+		const u32 BINARY_LOG_VERSION = 1;
+		//Limit on any length read from a binary log, so a corrupt file can't request huge allocations
+		const u64 BINARY_LOG_MAX_LENGTH = 4096;
+
+		enum class BinaryLogRecord : u8
+		{
+			Format = 0, //Interned format string: ID, length, characters
+			Message = 1 //Format ID, level, timestamp delta, thread ID, payload length, payload
+		};
+
+		//A printf conversion specification, e.g. %-8.3llu
+		struct FormatSpec
+		{
+			char flags[6] = {};
+			bool widthArgument = false; //Width given by an int argument (*)
+			int width = -1;
+			bool precisionArgument = false; //Precision given by an int argument (.*)
+			int precision = -1;
+			char length[3] = {};
+			char conversion = 0;
+		};
+
+		//Parse the specification following a '%', returning the character after it, or nullptr if the format ends mid-specification
+		const char* parseSpec(const char* p, FormatSpec& spec)
+		{
+			int flagCount = 0;
+			while (*p && std::strchr("-+ #0", *p) && flagCount < 5)
+			{
+				spec.flags[flagCount++] = *p++;
+			}
+			if (*p == '*')
+			{
+				spec.widthArgument = true;
+				p++;
+			}
+			else if (*p >= '0' && *p <= '9')
+			{
+				spec.width = 0;
+				while (*p >= '0' && *p <= '9') { spec.width = spec.width * 10 + (*p++ - '0'); }
+			}
+			if (*p == '.')
+			{
+				p++;
+				spec.precision = 0;
+				if (*p == '*')
+				{
+					spec.precisionArgument = true;
+					p++;
+				}
+				else
+				{
+					while (*p >= '0' && *p <= '9') { spec.precision = spec.precision * 10 + (*p++ - '0'); }
+				}
+			}
+			int lengthCount = 0;
+			while (*p && std::strchr("hljztL", *p) && lengthCount < 2)
+			{
+				spec.length[lengthCount++] = *p++;
+			}
+			if (!*p)
+			{
+				return nullptr;
+			}
+			spec.conversion = *p++;
+			return p;
+		}
+
+		u64 zigzagEncode(i64 value)
+		{
+			return (static_cast<u64>(value) << 1) ^ static_cast<u64>(value >> 63);
+		}
+
+		i64 zigzagDecode(u64 value)
+		{
+			return static_cast<i64>(value >> 1) ^ -static_cast<i64>(value & 1);
+		}
+
+		//Bounded writes into a payload or record, once a write doesn't fit every later write is skipped
+		struct ByteWriter
+		{
+			char* data;
+			std::size_t capacity;
+			std::size_t position = 0;
+			bool full = false;
+
+			ByteWriter(char* data, std::size_t capacity) : data(data), capacity(capacity) {}
+
+			void writeBytes(const void* bytes, std::size_t size)
+			{
+				if (full || capacity - position < size)
+				{
+					full = true;
+					return;
+				}
+				std::memcpy(data + position, bytes, size);
+				position += size;
+			}
+			void writeU8(u8 value) { writeBytes(&value, 1); }
+			void writeVarint(u64 value)
+			{
+				u8 bytes[10];
+				int count = 0;
+				while (value >= 0x80)
+				{
+					bytes[count++] = static_cast<u8>(value | 0x80);
+					value >>= 7;
+				}
+				bytes[count++] = static_cast<u8>(value);
+				writeBytes(bytes, count);
+			}
+			void writeDouble(double value)
+			{
+				u64 bits;
+				std::memcpy(&bits, &value, sizeof(bits));
+				for (int i = 0; i < 8; i++) { writeU8(static_cast<u8>(bits >> (8 * i))); }
+			}
+			//Truncates the string to whatever space is left, rather than dropping it
+			void writeString(const char* str)
+			{
+				std::size_t length = std::strlen(str);
+				std::size_t remaining = full ? 0 : capacity - position;
+				if (remaining < 2)
+				{
+					full = true;
+					return;
+				}
+				length = std::min<std::size_t>(length, std::min<std::size_t>(remaining - 2, 0x3FFF)); //Length fits a two byte varint
+				writeVarint(length);
+				writeBytes(str, length);
+			}
+		};
+
+		struct ByteReader
+		{
+			const char* data;
+			std::size_t length;
+			std::size_t position = 0;
+
+			ByteReader(const char* data, std::size_t length) : data(data), length(length) {}
+
+			bool readU8(u8& value)
+			{
+				if (position >= length)
+				{
+					return false;
+				}
+				value = static_cast<u8>(data[position++]);
+				return true;
+			}
+			bool readVarint(u64& value)
+			{
+				value = 0;
+				for (int shift = 0; shift < 64; shift += 7)
+				{
+					u8 byte;
+					if (!readU8(byte))
+					{
+						return false;
+					}
+					value |= static_cast<u64>(byte & 0x7F) << shift;
+					if (!(byte & 0x80))
+					{
+						return true;
+					}
+				}
+				return false;
+			}
+			bool readDouble(double& value)
+			{
+				u64 bits = 0;
+				for (int i = 0; i < 8; i++)
+				{
+					u8 byte;
+					if (!readU8(byte))
+					{
+						return false;
+					}
+					bits |= static_cast<u64>(byte) << (8 * i);
+				}
+				std::memcpy(&value, &bits, sizeof(value));
+				return true;
+			}
+			bool readString(const char*& str, std::size_t& strLength)
+			{
+				u64 size;
+				if (!readVarint(size) || size > length - position)
+				{
+					return false;
+				}
+				str = data + position;
+				strLength = static_cast<std::size_t>(size);
+				position += strLength;
+				return true;
+			}
+		};
+
+		//Append printf output to text, clamping to the space left
+		void appendFormatted(char* text, std::size_t capacity, std::size_t& position, const char* format, ...)
+		{
+			va_list args;
+			va_start(args, format);
+			int written = std::vsnprintf(text + position, capacity - position, format, args);
+			va_end(args);
+			if (written > 0)
+			{
+				position += std::min<std::size_t>(static_cast<std::size_t>(written), capacity - 1 - position);
+			}
+		}
+
+		//Rebuild a specification for snprintf, with any * arguments written in and integers widened to long long
+		void buildSpec(const FormatSpec& spec, int width, int precision, const char* length, char conversion, char* out, std::size_t outSize)
+		{
+			std::size_t position = 0;
+			out[0] = '\0';
+			appendFormatted(out, outSize, position, "%%%s", spec.flags);
+			if (width >= 0) { appendFormatted(out, outSize, position, "%d", width); }
+			if (precision >= 0) { appendFormatted(out, outSize, position, ".%d", precision); }
+			appendFormatted(out, outSize, position, "%s%c", length, conversion);
+		}
+
+		bool hasLength(const FormatSpec& spec, const char* length) { return std::strcmp(spec.length, length) == 0; }
+		bool isSigned(char conversion) { return conversion == 'd' || conversion == 'i'; }
+		bool isUnsigned(char conversion) { return conversion == 'u' || conversion == 'o' || conversion == 'x' || conversion == 'X'; }
+		bool isFloating(char conversion) { return std::strchr("fFeEgGaA", conversion) != nullptr; }
+
+		void writeU32(FILE* file, u32 value)
+		{
+			for (int i = 0; i < 4; i++) { std::fputc(static_cast<u8>(value >> (8 * i)), file); }
+		}
+
+		bool readFileVarint(FILE* file, u64& value)
+		{
+			value = 0;
+			for (int shift = 0; shift < 64; shift += 7)
+			{
+				int c = std::fgetc(file);
+				if (c == EOF)
+				{
+					return false;
+				}
+				value |= static_cast<u64>(c & 0x7F) << shift;
+				if (!(c & 0x80))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool readFileBytes(FILE* file, std::vector<char>& bytes, u64 length)
+		{
+			if (length > BINARY_LOG_MAX_LENGTH)
+			{
+				return false;
+			}
+			bytes.resize(static_cast<std::size_t>(length));
+			return length == 0 || std::fread(bytes.data(), 1, bytes.size(), file) == bytes.size();
+		}
+
+		const char* levelName(u8 level)
+		{
+			switch (static_cast<LogLevel>(level))
+			{
+			case LogLevel::Trace: return "trace";
+			case LogLevel::Info: return "info";
+			case LogLevel::Warn: return "warning";
+			case LogLevel::Error: return "error";
+			}
+			return "unknown";
+		}
+	}
+
+	std::size_t captureArguments(const char* format, va_list args, char* payload, std::size_t capacity)
+	{
+		ByteWriter writer(payload, capacity);
+		for (const char* p = format; *p; )
+		{
+			if (*p++ != '%')
+			{
+				continue;
+			}
+			if (*p == '%')
+			{
+				p++;
+				continue;
+			}
+			FormatSpec spec;
+			p = parseSpec(p, spec);
+			if (!p)
+			{
+				break;
+			}
+			if (spec.widthArgument) { writer.writeVarint(zigzagEncode(va_arg(args, int))); }
+			if (spec.precisionArgument) { writer.writeVarint(zigzagEncode(va_arg(args, int))); }
+
+			if (isSigned(spec.conversion))
+			{
+				i64 value;
+				if (hasLength(spec, "l")) { value = va_arg(args, long); }
+				else if (hasLength(spec, "ll")) { value = va_arg(args, long long); }
+				else if (hasLength(spec, "z")) { value = static_cast<i64>(va_arg(args, std::size_t)); }
+				else if (hasLength(spec, "j")) { value = va_arg(args, intmax_t); }
+				else if (hasLength(spec, "t")) { value = va_arg(args, ptrdiff_t); }
+				else { value = va_arg(args, int); }
+				writer.writeVarint(zigzagEncode(value));
+			}
+			else if (isUnsigned(spec.conversion))
+			{
+				u64 value;
+				if (hasLength(spec, "l")) { value = va_arg(args, unsigned long); }
+				else if (hasLength(spec, "ll")) { value = va_arg(args, unsigned long long); }
+				else if (hasLength(spec, "z")) { value = va_arg(args, std::size_t); }
+				else if (hasLength(spec, "j")) { value = va_arg(args, uintmax_t); }
+				else if (hasLength(spec, "t")) { value = static_cast<u64>(va_arg(args, ptrdiff_t)); }
+				else if (hasLength(spec, "hh")) { value = static_cast<unsigned char>(va_arg(args, unsigned int)); }
+				else if (hasLength(spec, "h")) { value = static_cast<unsigned short>(va_arg(args, unsigned int)); }
+				else { value = va_arg(args, unsigned int); }
+				writer.writeVarint(value);
+			}
+			else if (isFloating(spec.conversion))
+			{
+				writer.writeDouble(hasLength(spec, "L") ? static_cast<double>(va_arg(args, long double)) : va_arg(args, double));
+			}
+			else if (spec.conversion == 'c')
+			{
+				writer.writeVarint(static_cast<unsigned char>(va_arg(args, int)));
+			}
+			else if (spec.conversion == 's')
+			{
+				const char* str = va_arg(args, const char*);
+				writer.writeString(str ? str : "(null)");
+			}
+			else if (spec.conversion == 'p')
+			{
+				writer.writeVarint(reinterpret_cast<uintptr_t>(va_arg(args, void*)));
+			}
+			else
+			{
+				//Unknown conversion, the type of its argument (and so every later argument) can't be known
+				break;
+			}
+		}
+		return writer.position;
+	}
+
+	std::size_t formatArguments(const char* format, const char* payload, std::size_t payloadLength, char* text, std::size_t capacity)
+	{
+		if (capacity == 0)
+		{
+			return 0;
+		}
+		text[0] = '\0';
+		ByteReader reader(payload, payloadLength);
+		std::size_t position = 0;
+		char spec[48];
+		char str[BINARY_LOG_MAX_LENGTH + 1];
+		for (const char* p = format; *p && position < capacity - 1; )
+		{
+			if (*p != '%')
+			{
+				text[position++] = *p++;
+				continue;
+			}
+			p++;
+			if (*p == '%')
+			{
+				text[position++] = *p++;
+				continue;
+			}
+			FormatSpec parsed;
+			p = parseSpec(p, parsed);
+			if (!p)
+			{
+				break;
+			}
+			//A payload that ran out of space ends the message at the first missing argument
+			u64 encoded;
+			int width = parsed.width;
+			int precision = parsed.precision;
+			if (parsed.widthArgument)
+			{
+				if (!reader.readVarint(encoded)) { break; }
+				width = static_cast<int>(zigzagDecode(encoded));
+			}
+			if (parsed.precisionArgument)
+			{
+				if (!reader.readVarint(encoded)) { break; }
+				precision = static_cast<int>(zigzagDecode(encoded));
+			}
+
+			if (isSigned(parsed.conversion) || isUnsigned(parsed.conversion) || parsed.conversion == 'c' || parsed.conversion == 'p')
+			{
+				if (!reader.readVarint(encoded)) { break; }
+				if (isSigned(parsed.conversion))
+				{
+					buildSpec(parsed, width, precision, "ll", 'd', spec, sizeof(spec));
+					appendFormatted(text, capacity, position, spec, static_cast<long long>(zigzagDecode(encoded)));
+				}
+				else if (isUnsigned(parsed.conversion))
+				{
+					buildSpec(parsed, width, precision, "ll", parsed.conversion, spec, sizeof(spec));
+					appendFormatted(text, capacity, position, spec, static_cast<unsigned long long>(encoded));
+				}
+				else if (parsed.conversion == 'c')
+				{
+					buildSpec(parsed, width, -1, "", 'c', spec, sizeof(spec));
+					appendFormatted(text, capacity, position, spec, static_cast<int>(encoded));
+				}
+				else
+				{
+					appendFormatted(text, capacity, position, "0x%llx", static_cast<unsigned long long>(encoded));
+				}
+			}
+			else if (isFloating(parsed.conversion))
+			{
+				double value;
+				if (!reader.readDouble(value)) { break; }
+				buildSpec(parsed, width, precision, "", parsed.conversion, spec, sizeof(spec));
+				appendFormatted(text, capacity, position, spec, value);
+			}
+			else if (parsed.conversion == 's')
+			{
+				const char* value;
+				std::size_t valueLength;
+				if (!reader.readString(value, valueLength)) { break; }
+				valueLength = std::min<std::size_t>(valueLength, BINARY_LOG_MAX_LENGTH);
+				std::memcpy(str, value, valueLength);
+				str[valueLength] = '\0';
+				buildSpec(parsed, width, precision, "", 's', spec, sizeof(spec));
+				appendFormatted(text, capacity, position, spec, str);
+			}
+			else
+			{
+				break;
+			}
+		}
+		text[position] = '\0';
+		return position;
+	}
+
+	BinaryLogWriter::~BinaryLogWriter()
+	{
+		close();
+	}
+
+	bool BinaryLogWriter::open(const std::string& filePath)
+	{
+		close();
+		m_file = std::fopen(filePath.c_str(), "wb");
+		if (!m_file)
+		{
+			return false;
+		}
+		//Records are small, so let the C runtime batch them into large writes
+		std::setvbuf(m_file, nullptr, _IOFBF, 64 * 1024);
+		m_formatIDs.clear();
+		m_lastTimestampNs = 0;
+		std::fwrite(BINARY_LOG_MAGIC, 1, sizeof(BINARY_LOG_MAGIC), m_file);
+		writeU32(m_file, BINARY_LOG_VERSION);
+		return true;
+	}
+
+	void BinaryLogWriter::close()
+	{
+		if (m_file)
+		{
+			std::fclose(m_file);
+			m_file = nullptr;
+		}
+	}
+
+	void BinaryLogWriter::writeMessage(const char* format, LogLevel level, u64 timestampNs, u32 threadID, const char* payload, std::size_t payloadLength)
+	{
+		if (!m_file)
+		{
+			return;
+		}
+		//A message's payload may be as long as the longest message, see LOG_MAX_MESSAGE_SIZE
+		char record[LOG_MAX_MESSAGE_SIZE + 32];
+
+		//The first message with a format writes the format, every later one refers to it by ID
+		auto found = m_formatIDs.find(format);
+		u32 formatID;
+		if (found == m_formatIDs.end())
+		{
+			formatID = static_cast<u32>(m_formatIDs.size());
+			m_formatIDs.emplace(format, formatID);
+			std::size_t formatLength = std::min<std::size_t>(std::strlen(format), BINARY_LOG_MAX_LENGTH);
+			ByteWriter header(record, sizeof(record));
+			header.writeU8(static_cast<u8>(BinaryLogRecord::Format));
+			header.writeVarint(formatID);
+			header.writeVarint(formatLength);
+			std::fwrite(record, 1, header.position, m_file);
+			std::fwrite(format, 1, formatLength, m_file);
+		}
+		else
+		{
+			formatID = found->second;
+		}
+
+		//Timestamps are stored relative to the previous message, messages are almost in order so the difference is usually small
+		ByteWriter writer(record, sizeof(record));
+		writer.writeU8(static_cast<u8>(BinaryLogRecord::Message));
+		writer.writeVarint(formatID);
+		writer.writeU8(static_cast<u8>(level));
+		writer.writeVarint(zigzagEncode(static_cast<i64>(timestampNs - m_lastTimestampNs)));
+		writer.writeVarint(threadID);
+		writer.writeVarint(payloadLength);
+		writer.writeBytes(payload, payloadLength);
+		std::fwrite(record, 1, writer.position, m_file);
+		m_lastTimestampNs = timestampNs;
+	}
+
+	void BinaryLogWriter::flush()
+	{
+		if (m_file)
+		{
+			std::fflush(m_file);
+		}
+	}
+
+	bool decodeBinaryLog(const std::string& binaryPath, const std::string& textPath)
+	{
+		FILE* in = std::fopen(binaryPath.c_str(), "rb");
+		if (!in)
+		{
+			return false;
+		}
+		char magic[sizeof(BINARY_LOG_MAGIC)];
+		u8 versionBytes[4];
+		if (std::fread(magic, 1, sizeof(magic), in) != sizeof(magic) || std::memcmp(magic, BINARY_LOG_MAGIC, sizeof(magic)) != 0
+			|| std::fread(versionBytes, 1, sizeof(versionBytes), in) != sizeof(versionBytes)
+			|| (versionBytes[0] | versionBytes[1] << 8 | versionBytes[2] << 16 | static_cast<u32>(versionBytes[3]) << 24) != BINARY_LOG_VERSION)
+		{
+			std::fclose(in);
+			return false;
+		}
+		FILE* out = std::fopen(textPath.c_str(), "w");
+		if (!out)
+		{
+			std::fclose(in);
+			return false;
+		}
+
+		std::vector<std::string> formats;
+		std::vector<char> bytes;
+		char text[BINARY_LOG_MAX_LENGTH + 1];
+		u64 timestampNs = 0;
+		bool valid = true;
+		int type;
+		while ((type = std::fgetc(in)) != EOF)
+		{
+			u64 id, length;
+			if (type == static_cast<int>(BinaryLogRecord::Format))
+			{
+				if (!readFileVarint(in, id) || !readFileVarint(in, length) || !readFileBytes(in, bytes, length) || id != formats.size())
+				{
+					valid = false;
+					break;
+				}
+				formats.emplace_back(bytes.begin(), bytes.end());
+				continue;
+			}
+
+			int level;
+			u64 delta, threadID;
+			if (type != static_cast<int>(BinaryLogRecord::Message) || !readFileVarint(in, id) || (level = std::fgetc(in)) == EOF
+				|| !readFileVarint(in, delta) || !readFileVarint(in, threadID) || !readFileVarint(in, length)
+				|| !readFileBytes(in, bytes, length) || id >= formats.size())
+			{
+				valid = false;
+				break;
+			}
+			timestampNs += static_cast<u64>(zigzagDecode(delta));
+			formatArguments(formats[static_cast<std::size_t>(id)].c_str(), bytes.data(), bytes.size(), text, sizeof(text));
+
+			//Same layout as the text log, with the logging thread's ID added
+			std::time_t seconds = static_cast<std::time_t>(timestampNs / 1000000000ull);
+			std::tm localTime;
+			localtime_s(&localTime, &seconds);
+			char timeText[32];
+			std::strftime(timeText, sizeof(timeText), "%Y-%m-%d %H:%M:%S", &localTime);
+			std::fprintf(out, "[%s.%03u] [thread %llu] [%s] %s\n", timeText, static_cast<unsigned>((timestampNs / 1000000ull) % 1000),
+				static_cast<unsigned long long>(threadID), levelName(static_cast<u8>(level)), text);
+		}
+		std::fclose(in);
+		std::fclose(out);
+		return valid;
+	}
+}
@@ -0,0 +1,91 @@
+//------- Debug Draw --------
+//Batched Debug Lines
+//For The Sol Core Engine
+//---------------------------
+
+#include "util/DebugDraw.h"
+
+//C++ libraries
+#include <cmath>
+
+//External library GLM
+#include <glm/gtc/packing.hpp>
+
+namespace EngineDebugDraw
+{
+	namespace
+	{
+		//Segments of every circle, and their directions computed once rather than per circle
+		const int CIRCLE_SEGMENTS = 32;
+
+		struct UnitCircle
+		{
+			glm::vec2 directions[CIRCLE_SEGMENTS];
+		};
+
+		const glm::vec2* unitCircle()
+		{
+			//A function-local static is initialized exactly once even if several threads draw the first circle at the same time
+			static const UnitCircle circle = []()
+			{
+				UnitCircle computed;
+				for (int i = 0; i < CIRCLE_SEGMENTS; i++)
+				{
+					float angle = 6.28318530718f * i / CIRCLE_SEGMENTS;
+					computed.directions[i] = glm::vec2(std::cos(angle), std::sin(angle));
+				}
+				return computed;
+			}();
+			return circle.directions;
+		}
+	}
+
+	u32 DebugDraw::color(float r, float g, float b, float a)
+	{
+		return glm::packUnorm4x8(glm::vec4(r, g, b, a));
+	}
+
+	void DebugDraw::line(const glm::vec2& from, const glm::vec2& to, u32 color)
+	{
+		m_vertices.push_back(DebugVertex{ from, color });
+		m_vertices.push_back(DebugVertex{ to, color });
+	}
+
+	void DebugDraw::polygon(const glm::vec2* vertices, int vertexCount, u32 color)
+	{
+		for (int i = 0; i < vertexCount; i++)
+		{
+			line(vertices[i], vertices[(i + 1) % vertexCount], color);
+		}
+	}
+
+	void DebugDraw::box(const glm::vec2& centre, const glm::vec2& halfExtents, float rotation, u32 color)
+	{
+		glm::vec2 axisX = glm::vec2(std::cos(rotation), std::sin(rotation)) * halfExtents.x;
+		glm::vec2 axisY = glm::vec2(-std::sin(rotation), std::cos(rotation)) * halfExtents.y;
+		const glm::vec2 corners[4] = { centre + axisX + axisY, centre + axisX - axisY, centre - axisX - axisY, centre - axisX + axisY };
+		polygon(corners, 4, color);
+	}
+
+	void DebugDraw::aabb(const glm::vec2& min, const glm::vec2& max, u32 color)
+	{
+		const glm::vec2 corners[4] = { min, glm::vec2(max.x, min.y), max, glm::vec2(min.x, max.y) };
+		polygon(corners, 4, color);
+	}
+
+	void DebugDraw::circle(const glm::vec2& centre, float radius, u32 color)
+	{
+		const glm::vec2* directions = unitCircle();
+		for (int i = 0; i < CIRCLE_SEGMENTS; i++)
+		{
+			line(centre + directions[i] * radius, centre + directions[(i + 1) % CIRCLE_SEGMENTS] * radius, color);
+		}
+	}
+
+	void DebugDraw::point(const glm::vec2& position, float size, u32 color)
+	{
+		float half = size * 0.5f;
+		line(position - glm::vec2(half, 0.0f), position + glm::vec2(half, 0.0f), color);
+		line(position - glm::vec2(0.0f, half), position + glm::vec2(0.0f, half), color);
+	}
+}
@@ -0,0 +1,140 @@
+//------- GPU Timer ---------
+//Per-Pass GPU Timings
+//For The Sol Core Engine
+//---------------------------
+
+#include "util/GpuTimer.h"
+
+namespace EngineMetrics
+{
+	GpuTimer::GpuTimer()
+	{
+		for (std::size_t pass = 0; pass < GPU_PASS_COUNT; pass++)
+		{
+			m_latestMs[pass].store(0.0f, std::memory_order_relaxed);
+		}
+	}
+
+	void GpuTimer::create()
+	{
+		for (FrameQueries& frame : m_frames)
+		{
+			glGenQueries(GPU_PASS_COUNT, frame.begin);
+			glGenQueries(GPU_PASS_COUNT, frame.end);
+		}
+		m_created = true;
+	}
+
+	void GpuTimer::destroy()
+	{
+		if (!m_created)
+		{
+			return;
+		}
+		for (FrameQueries& frame : m_frames)
+		{
+			glDeleteQueries(GPU_PASS_COUNT, frame.begin);
+			glDeleteQueries(GPU_PASS_COUNT, frame.end);
+			frame = FrameQueries();
+		}
+		m_frameIndex = 0;
+		m_frameActive = false;
+		for (bool& open : m_passOpen)
+		{
+			open = false;
+		}
+		m_created = false;
+	}
+
+	bool GpuTimer::beginFrame(float tag)
+	{
+		if (!m_created)
+		{
+			return false;
+		}
+		//A pass left open is closed with the frame, so its timing covers up to here
+		for (std::size_t pass = 0; pass < GPU_PASS_COUNT; pass++)
+		{
+			endPass(static_cast<GpuPass>(pass));
+		}
+		if (m_frameActive)
+		{
+			m_frames[m_frameIndex].pending = true;
+			m_frameIndex = (m_frameIndex + 1) % GPU_TIMER_FRAMES;
+		}
+
+		//The oldest frame's queries are reused for this frame once read back, otherwise this frame isn't timed rather than waiting
+		FrameQueries& frame = m_frames[m_frameIndex];
+		bool readBackFrame = frame.pending && readBack(frame);
+		m_frameActive = !frame.pending;
+		if (m_frameActive)
+		{
+			for (bool& timed : frame.timed)
+			{
+				timed = false;
+			}
+			frame.tag = tag;
+		}
+		return readBackFrame;
+	}
+
+	void GpuTimer::beginPass(GpuPass pass)
+	{
+		std::size_t index = static_cast<std::size_t>(pass);
+		FrameQueries& frame = m_frames[m_frameIndex];
+		if (!m_frameActive || frame.timed[index])
+		{
+			return;
+		}
+		glQueryCounter(frame.begin[index], GL_TIMESTAMP);
+		frame.timed[index] = true;
+		m_passOpen[index] = true;
+	}
+
+	void GpuTimer::endPass(GpuPass pass)
+	{
+		std::size_t index = static_cast<std::size_t>(pass);
+		if (!m_passOpen[index])
+		{
+			return;
+		}
+		glQueryCounter(m_frames[m_frameIndex].end[index], GL_TIMESTAMP);
+		m_passOpen[index] = false;
+	}
+
+	bool GpuTimer::readBack(FrameQueries& frame)
+	{
+		for (std::size_t pass = 0; pass < GPU_PASS_COUNT; pass++)
+		{
+			if (!frame.timed[pass])
+			{
+				continue;
+			}
+			GLint beginAvailable = 0;
+			GLint endAvailable = 0;
+			glGetQueryObjectiv(frame.begin[pass], GL_QUERY_RESULT_AVAILABLE, &beginAvailable);
+			glGetQueryObjectiv(frame.end[pass], GL_QUERY_RESULT_AVAILABLE, &endAvailable);
+			if (!beginAvailable || !endAvailable)
+			{
+				return false;
+			}
+		}
+
+		for (std::size_t pass = 0; pass < GPU_PASS_COUNT; pass++)
+		{
+			float elapsedMs = 0.0f;
+			if (frame.timed[pass])
+			{
+				GLuint64 beginNs = 0;
+				GLuint64 endNs = 0;
+				glGetQueryObjectui64v(frame.begin[pass], GL_QUERY_RESULT, &beginNs);
+				glGetQueryObjectui64v(frame.end[pass], GL_QUERY_RESULT, &endNs);
+				elapsedMs = endNs > beginNs ? static_cast<float>((endNs - beginNs) / 1.0e6) : 0.0f;
+			}
+			m_latestMs[pass].store(elapsedMs, std::memory_order_relaxed);
+		}
+		m_latestTag = frame.tag;
+		frame.pending = false;
+		return true;
+	}
+}
@@ -0,0 +1,313 @@
+//------- Input Log ---------
+//Input Recording And Replay
+//For The Sol Core Engine
+//---------------------------
+
+#include "util/InputLog.h"
+
+//C++ libraries
+#include <cstring>
+
+namespace EngineReplay
+{
+	namespace
+	{
+		const char INPUT_LOG_MAGIC[8] = { 'S', 'O', 'L', 'I', 'N', 'P', 'U', 'T' };
+		const u32 INPUT_LOG_VERSION = 1;
+
+		//Event types as stored in the log, only keyboard input is fed to the simulation so only keyboard input is recorded
+		enum class RecordedEventType : u8
+		{
+			KeyDown = 0,
+			KeyUp = 1
+		};
+
+		void writeBytes(FILE* file, const void* data, size_t size)
+		{
+			std::fwrite(data, 1, size, file);
+		}
+
+		void writeU8(FILE* file, u8 value)
+		{
+			std::fputc(value, file);
+		}
+
+		void writeFixed(FILE* file, u64 value, int bytes)
+		{
+			for (int i = 0; i < bytes; i++)
+			{
+				writeU8(file, static_cast<u8>(value >> (8 * i)));
+			}
+		}
+
+		void writeVarint(FILE* file, u64 value)
+		{
+			while (value >= 0x80)
+			{
+				writeU8(file, static_cast<u8>(value | 0x80));
+				value >>= 7;
+			}
+			writeU8(file, static_cast<u8>(value));
+		}
+
+		void writeString(FILE* file, const std::string& str)
+		{
+			writeVarint(file, str.size());
+			writeBytes(file, str.data(), str.size());
+		}
+
+		bool readU8(FILE* file, u8& value)
+		{
+			int c = std::fgetc(file);
+			if (c == EOF)
+			{
+				return false;
+			}
+			value = static_cast<u8>(c);
+			return true;
+		}
+
+		bool readFixed(FILE* file, u64& value, int bytes)
+		{
+			value = 0;
+			for (int i = 0; i < bytes; i++)
+			{
+				u8 byte;
+				if (!readU8(file, byte))
+				{
+					return false;
+				}
+				value |= static_cast<u64>(byte) << (8 * i);
+			}
+			return true;
+		}
+
+		bool readVarint(FILE* file, u64& value)
+		{
+			value = 0;
+			for (int shift = 0; shift < 64; shift += 7)
+			{
+				u8 byte;
+				if (!readU8(file, byte))
+				{
+					return false;
+				}
+				value |= static_cast<u64>(byte & 0x7F) << shift;
+				if (!(byte & 0x80))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool readString(FILE* file, std::string& str)
+		{
+			u64 length;
+			if (!readVarint(file, length) || length > 4096)
+			{
+				return false;
+			}
+			str.resize(static_cast<size_t>(length));
+			return length == 0 || std::fread(&str[0], 1, static_cast<size_t>(length), file) == length;
+		}
+
+		//Zigzag encoding so that negative keycodes stay small as varints
+		u64 zigzagEncode(i32 value)
+		{
+			return static_cast<u64>((static_cast<u32>(value) << 1) ^ static_cast<u32>(value >> 31));
+		}
+
+		i32 zigzagDecode(u64 value)
+		{
+			u32 v = static_cast<u32>(value);
+			return static_cast<i32>((v >> 1) ^ (~(v & 1) + 1));
+		}
+	}
+
+	InputLogWriter::~InputLogWriter()
+	{
+		if (m_file)
+		{
+			close(m_lastRecordTick);
+		}
+	}
+
+	bool InputLogWriter::open(const std::string& filePath, const std::string& initialScene, double fixedTimestep)
+	{
+		if (m_file)
+		{
+			close(m_lastRecordTick);
+		}
+		m_file = std::fopen(filePath.c_str(), "wb");
+		if (!m_file)
+		{
+			return false;
+		}
+		m_lastRecordTick = 0;
+		m_lastSceneRunning = false;
+
+		writeBytes(m_file, INPUT_LOG_MAGIC, sizeof(INPUT_LOG_MAGIC));
+		writeFixed(m_file, INPUT_LOG_VERSION, 4);
+		u64 timestepBits;
+		std::memcpy(&timestepBits, &fixedTimestep, sizeof(timestepBits));
+		writeFixed(m_file, timestepBits, 8);
+		writeString(m_file, initialScene);
+		return true;
+	}
+
+	void InputLogWriter::writeTick(u64 tick, bool sceneRunning, const std::string& loadedScene, const std::vector<SDL_Event>& events)
+	{
+		if (!m_file)
+		{
+			return;
+		}
+
+		//Count only the events that are recorded, so the count always matches what follows
+		u64 eventCount = 0;
+		for (const auto& event : events)
+		{
+			if (event.type == SDL_KEYDOWN || event.type == SDL_KEYUP)
+			{
+				eventCount++;
+			}
+		}
+		//Ticks where nothing happened and nothing changed are implied by the gap between records
+		if (eventCount == 0 && loadedScene.empty() && sceneRunning == m_lastSceneRunning)
+		{
+			return;
+		}
+
+		u8 flags = 0;
+		if (sceneRunning) { flags |= INPUT_RECORD_SCENE_RUNNING; }
+		if (!loadedScene.empty()) { flags |= INPUT_RECORD_SCENE_LOADED; }
+
+		writeVarint(m_file, tick - m_lastRecordTick);
+		writeU8(m_file, flags);
+		if (!loadedScene.empty())
+		{
+			writeString(m_file, loadedScene);
+		}
+		writeVarint(m_file, eventCount);
+		for (const auto& event : events)
+		{
+			if (event.type != SDL_KEYDOWN && event.type != SDL_KEYUP)
+			{
+				continue;
+			}
+			writeU8(m_file, static_cast<u8>(event.type == SDL_KEYDOWN ? RecordedEventType::KeyDown : RecordedEventType::KeyUp));
+			writeVarint(m_file, zigzagEncode(event.key.keysym.sym));
+			writeVarint(m_file, static_cast<u64>(event.key.keysym.scancode));
+			writeFixed(m_file, event.key.keysym.mod, 2);
+			writeU8(m_file, event.key.repeat);
+		}
+
+		m_lastRecordTick = tick;
+		m_lastSceneRunning = sceneRunning;
+	}
+
+	void InputLogWriter::close(u64 finalTick)
+	{
+		if (!m_file)
+		{
+			return;
+		}
+		writeVarint(m_file, finalTick >= m_lastRecordTick ? finalTick - m_lastRecordTick : 0);
+		writeU8(m_file, INPUT_RECORD_END | (m_lastSceneRunning ? INPUT_RECORD_SCENE_RUNNING : 0));
+		writeVarint(m_file, 0);
+		std::fclose(m_file);
+		m_file = nullptr;
+	}
+
+	InputLogReader::~InputLogReader()
+	{
+		close();
+	}
+
+	bool InputLogReader::open(const std::string& filePath)
+	{
+		close();
+		m_file = std::fopen(filePath.c_str(), "rb");
+		if (!m_file)
+		{
+			return false;
+		}
+
+		char magic[sizeof(INPUT_LOG_MAGIC)];
+		u64 version = 0;
+		u64 timestepBits = 0;
+		if (std::fread(magic, 1, sizeof(magic), m_file) != sizeof(magic) || std::memcmp(magic, INPUT_LOG_MAGIC, sizeof(magic)) != 0
+			|| !readFixed(m_file, version, 4) || version != INPUT_LOG_VERSION
+			|| !readFixed(m_file, timestepBits, 8) || !readString(m_file, m_initialScene))
+		{
+			close();
+			return false;
+		}
+		std::memcpy(&m_fixedTimestep, &timestepBits, sizeof(m_fixedTimestep));
+		m_lastRecordTick = 0;
+		return true;
+	}
+
+	void InputLogReader::close()
+	{
+		if (m_file)
+		{
+			std::fclose(m_file);
+			m_file = nullptr;
+		}
+	}
+
+	bool InputLogReader::readRecord(InputRecord& record)
+	{
+		if (!m_file)
+		{
+			return false;
+		}
+
+		u64 tickDelta;
+		u8 flags;
+		if (!readVarint(m_file, tickDelta) || !readU8(m_file, flags))
+		{
+			return false;
+		}
+		record.tick = m_lastRecordTick + tickDelta;
+		record.flags = flags;
+		record.loadedScene.clear();
+		record.events.clear();
+		if ((flags & INPUT_RECORD_SCENE_LOADED) && !readString(m_file, record.loadedScene))
+		{
+			return false;
+		}
+
+		u64 eventCount;
+		if (!readVarint(m_file, eventCount))
+		{
+			return false;
+		}
+		for (u64 i = 0; i < eventCount; i++)
+		{
+			u8 type;
+			u64 keycode, scancode, mod;
+			u8 repeat;
+			if (!readU8(m_file, type) || !readVarint(m_file, keycode) || !readVarint(m_file, scancode)
+				|| !readFixed(m_file, mod, 2) || !readU8(m_file, repeat))
+			{
+				return false;
+			}
+			SDL_Event event;
+			std::memset(&event, 0, sizeof(event));
+			bool keyDown = type == static_cast<u8>(RecordedEventType::KeyDown);
+			event.type = keyDown ? SDL_KEYDOWN : SDL_KEYUP;
+			event.key.type = event.type;
+			event.key.state = keyDown ? SDL_PRESSED : SDL_RELEASED;
+			event.key.repeat = repeat;
+			event.key.keysym.sym = zigzagDecode(keycode);
+			event.key.keysym.scancode = static_cast<SDL_Scancode>(scancode);
+			event.key.keysym.mod = static_cast<Uint16>(mod);
+			record.events.push_back(event);
+		}
+
+		m_lastRecordTick = record.tick;
+		return true;
+	}
+}
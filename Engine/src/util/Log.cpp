@@ -0,0 +1,426 @@
+//------- Log ---------------
+//Asynchronous Log Pipeline
+//For The Sol Core Engine
+//---------------------------
+
+#include "util/Log.h"
+#include "util/BinaryLog.h"
+#include "util/MemoryTracker.h"
+
+//C++ libraries
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace EngineLog
+{
+	namespace
+	{
+		//How often the background thread drains the buffers, producers never signal it so logging stays free of system calls
+		const int LOG_DRAIN_INTERVAL_MS = 10;
+
+		//Reported through the log itself, so its format is a string literal like any other
+		const char* const DROPPED_MESSAGES_FORMAT = "[Log] Dropped %llu Messages: Log Buffer Full";
+
+		struct LogMessage
+		{
+			u64 timestampNs = 0;
+			//Set when the message was captured for the binary log, in which case text holds the captured arguments rather than the formatted message
+			const char* format = nullptr;
+			u32 threadID = 0;
+			LogLevel level = LogLevel::Info;
+			u16 length = 0;
+			bool continued = false; //The message continues in the next record, which has the same timestamp
+			char text[LOG_MESSAGE_SIZE];
+		};
+
+		//Single-producer single-consumer ring buffer, written only by its thread and read only by the background thread
+		//A buffer outlives its thread, once released (and drained) it is reused by the next thread to log
+		struct ThreadLogBuffer
+		{
+			std::unique_ptr<LogMessage[]> messages{ new LogMessage[LOG_THREAD_BUFFER_MESSAGES] };
+			std::atomic<u64> head{ 0 }; //Next message to write, advanced by the producer
+			std::atomic<u64> tail{ 0 }; //Next message to read, advanced by the background thread
+			std::atomic<bool> released{ false }; //The owning thread has exited
+		};
+
+		//Registration of thread buffers is locked, and happens once per thread
+		std::mutex s_registryMutex;
+		std::vector<std::unique_ptr<ThreadLogBuffer>> s_buffers;
+
+		std::atomic<u64> s_droppedCount{ 0 };
+		std::atomic<u32> s_nextThreadID{ 1 };
+		thread_local u32 t_threadID = 0;
+		//Messages longer than one record are formatted (or captured) here, then split over records
+		thread_local char t_longMessage[LOG_MAX_MESSAGE_SIZE];
+		u64 s_reportedDroppedCount = 0; //Guarded by s_sinkMutex
+
+		//Background thread state
+		std::mutex s_sinkMutex; //Guards the sink, and the console when no sink is started
+		std::condition_variable s_drainRequested;
+		std::condition_variable s_drainCompleted;
+		LogSink s_sink;
+		BinaryLogWriter s_binaryWriter; //Open whilst the background thread writes a binary log, guarded by s_sinkMutex
+		std::atomic<bool> s_captureArguments{ false }; //Producers capture arguments (for the binary log) rather than formatting messages
+		//Heap allocated so that a process exiting without stopping the Logger doesn't destroy a joinable std::thread (which would terminate)
+		std::thread* s_drainThread = nullptr;
+		std::atomic<bool> s_running{ false }; //Read without the lock by producers, so the hot path never touches the mutex
+		bool s_stopRequested = false;
+		u64 s_drainRequests = 0;
+		u64 s_drainsCompleted = 0;
+
+		//Marks the calling thread's buffer as released when the thread exits
+		struct ThreadBufferHandle
+		{
+			ThreadLogBuffer* buffer = nullptr;
+			~ThreadBufferHandle()
+			{
+				if (buffer)
+				{
+					buffer->released.store(true, std::memory_order_release);
+				}
+			}
+		};
+		thread_local ThreadBufferHandle t_handle;
+
+		//Get (or lazily acquire) the calling thread's buffer, reusing a drained buffer released by an exited thread if there is one
+		ThreadLogBuffer* getThreadBuffer()
+		{
+			if (!t_handle.buffer)
+			{
+				std::lock_guard<std::mutex> lock(s_registryMutex);
+				for (auto& buffer : s_buffers)
+				{
+					if (buffer->released.load(std::memory_order_acquire)
+						&& buffer->tail.load(std::memory_order_acquire) == buffer->head.load(std::memory_order_relaxed))
+					{
+						buffer->released.store(false, std::memory_order_relaxed);
+						t_handle.buffer = buffer.get();
+						return t_handle.buffer;
+					}
+				}
+				s_buffers.push_back(std::unique_ptr<ThreadLogBuffer>(new ThreadLogBuffer()));
+				t_handle.buffer = s_buffers.back().get();
+			}
+			return t_handle.buffer;
+		}
+
+		u64 systemTimeNs()
+		{
+			return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::system_clock::now().time_since_epoch()).count());
+		}
+
+		//Without a sink, messages go to the console, errors to stderr
+		void writeToConsole(LogLevel level, const char* message, std::size_t length)
+		{
+			FILE* stream = level == LogLevel::Error ? stderr : stdout;
+			std::fwrite(message, 1, length, stream);
+			std::fputc('\n', stream);
+		}
+
+		//Write a message to the binary log if it is open, otherwise to the sink (or console), formatting any captured arguments first
+		void writeMessage(LogLevel level, u64 timestampNs, u32 threadID, const char* format, const char* text, std::size_t length)
+		{
+			if (format && s_binaryWriter.isOpen())
+			{
+				s_binaryWriter.writeMessage(format, level, timestampNs, threadID, text, length);
+				return;
+			}
+			char formatted[LOG_MAX_MESSAGE_SIZE];
+			if (format)
+			{
+				//Captured just before the binary log was stopped
+				length = formatArguments(format, text, length, formatted, sizeof(formatted));
+				text = formatted;
+			}
+			if (s_sink) { s_sink(level, timestampNs, text, length); }
+			else { writeToConsole(level, text, length); }
+		}
+
+		//Capture arguments for a message written by the background thread itself
+		std::size_t captureMessage(char* payload, std::size_t capacity, const char* format, ...)
+		{
+			va_list args;
+			va_start(args, format);
+			std::size_t length = captureArguments(format, args, payload, capacity);
+			va_end(args);
+			return length;
+		}
+
+		//Write every buffered message to the sink (or console), in timestamp order across threads
+		//Called with s_sinkMutex held, only ever by one thread at a time
+		void drainBuffers(std::vector<std::pair<ThreadLogBuffer*, u64>>& pending, std::vector<const LogMessage*>& ordered)
+		{
+			pending.clear();
+			ordered.clear();
+			{
+				std::lock_guard<std::mutex> lock(s_registryMutex);
+				for (auto& buffer : s_buffers)
+				{
+					u64 tail = buffer->tail.load(std::memory_order_relaxed);
+					u64 head = buffer->head.load(std::memory_order_acquire);
+					if (head == tail)
+					{
+						continue;
+					}
+					pending.emplace_back(buffer.get(), head);
+					for (u64 i = tail; i < head; i++)
+					{
+						ordered.push_back(&buffer->messages[i % LOG_THREAD_BUFFER_MESSAGES]);
+					}
+				}
+			}
+			//Each thread's messages are already in order, a stable sort keeps them so when timestamps tie
+			//A long message's records share a timestamp and are published together, so they stay next to each other
+			std::stable_sort(ordered.begin(), ordered.end(), [](const LogMessage* a, const LogMessage* b) { return a->timestampNs < b->timestampNs; });
+			char assembled[LOG_MAX_MESSAGE_SIZE + 1];
+			std::size_t assembledLength = 0;
+			for (const LogMessage* message : ordered)
+			{
+				if (!message->continued && assembledLength == 0)
+				{
+					writeMessage(message->level, message->timestampNs, message->threadID, message->format, message->text, message->length);
+					continue;
+				}
+				std::size_t length = std::min<std::size_t>(message->length, LOG_MAX_MESSAGE_SIZE - assembledLength);
+				std::memcpy(assembled + assembledLength, message->text, length);
+				assembledLength += length;
+				if (!message->continued)
+				{
+					assembled[assembledLength] = '\0';
+					writeMessage(message->level, message->timestampNs, message->threadID, message->format, assembled, assembledLength);
+					assembledLength = 0;
+				}
+			}
+			//Only now can the producers reuse the slots
+			for (auto& entry : pending)
+			{
+				entry.first->tail.store(entry.second, std::memory_order_release);
+			}
+
+			u64 droppedCount = s_droppedCount.load(std::memory_order_relaxed);
+			u64 dropped = droppedCount - s_reportedDroppedCount;
+			s_reportedDroppedCount = droppedCount;
+			if (dropped > 0)
+			{
+				char payload[16];
+				std::size_t length = captureMessage(payload, sizeof(payload), DROPPED_MESSAGES_FORMAT, static_cast<unsigned long long>(dropped));
+				writeMessage(LogLevel::Warn, systemTimeNs(), 0, DROPPED_MESSAGES_FORMAT, payload, length);
+			}
+			if (!ordered.empty() || dropped > 0)
+			{
+				s_binaryWriter.flush();
+			}
+		}
+
+		void drainThreadMain()
+		{
+			SOL_MEMORY_TAG(EngineMemory::MemoryTag::Log);
+			//Reused between drains, so draining only allocates whilst these grow
+			std::vector<std::pair<ThreadLogBuffer*, u64>> pending;
+			std::vector<const LogMessage*> ordered;
+			std::unique_lock<std::mutex> lock(s_sinkMutex);
+			while (true)
+			{
+				s_drainRequested.wait_for(lock, std::chrono::milliseconds(LOG_DRAIN_INTERVAL_MS));
+				u64 requests = s_drainRequests;
+				bool stopping = s_stopRequested;
+				drainBuffers(pending, ordered);
+				s_drainsCompleted = requests;
+				s_drainCompleted.notify_all();
+				if (stopping)
+				{
+					break;
+				}
+			}
+		}
+	}
+
+	void Logger::write(LogLevel level, const char* format, ...)
+	{
+		ThreadLogBuffer* buffer = getThreadBuffer();
+		u64 head = buffer->head.load(std::memory_order_relaxed);
+		u64 freeRecords = LOG_THREAD_BUFFER_MESSAGES - (head - buffer->tail.load(std::memory_order_acquire));
+		if (freeRecords == 0)
+		{
+			s_droppedCount.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		if (t_threadID == 0)
+		{
+			t_threadID = s_nextThreadID.fetch_add(1, std::memory_order_relaxed);
+		}
+		LogMessage& message = buffer->messages[head % LOG_THREAD_BUFFER_MESSAGES];
+		message.timestampNs = systemTimeNs();
+		message.threadID = t_threadID;
+		message.level = level;
+		message.continued = false;
+		//Formatted (or captured) straight into the record, only a message that doesn't fit is formatted again into the long message buffer
+		const char* text = message.text;
+		std::size_t length = 0;
+		va_list args;
+		va_start(args, format);
+		if (s_captureArguments.load(std::memory_order_relaxed))
+		{
+			//Capturing the arguments is far cheaper than formatting them, the decoder formats them later
+			//Captured into the long message buffer, as a string argument only stops at the end of the space it is given
+			message.format = format;
+			length = captureArguments(format, args, t_longMessage, LOG_MAX_MESSAGE_SIZE);
+			text = t_longMessage;
+		}
+		else
+		{
+			va_list retryArgs;
+			va_copy(retryArgs, args);
+			message.format = nullptr;
+			int formattedLength = std::vsnprintf(message.text, LOG_MESSAGE_SIZE, format, args);
+			length = formattedLength < 0 ? 0 : static_cast<std::size_t>(formattedLength);
+			if (length >= LOG_MESSAGE_SIZE)
+			{
+				std::vsnprintf(t_longMessage, LOG_MAX_MESSAGE_SIZE, format, retryArgs);
+				if (length >= LOG_MAX_MESSAGE_SIZE)
+				{
+					//Never cut short silently
+					std::size_t markerLength = std::strlen(LOG_TRUNCATED_MARKER);
+					length = LOG_MAX_MESSAGE_SIZE - 1;
+					std::memcpy(t_longMessage + length - markerLength, LOG_TRUNCATED_MARKER, markerLength);
+				}
+				text = t_longMessage;
+			}
+			va_end(retryArgs);
+		}
+		va_end(args);
+
+		//A message longer than one record continues over as many records as it needs, all of which must be free
+		u64 records = text == message.text ? 1 : std::max<u64>(1, (length + LOG_MESSAGE_SIZE - 1) / LOG_MESSAGE_SIZE);
+		if (records > freeRecords)
+		{
+			s_droppedCount.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		if (records == 1 && text == message.text)
+		{
+			message.length = static_cast<u16>(length);
+		}
+		else
+		{
+			for (u64 i = 0; i < records; i++)
+			{
+				LogMessage& record = buffer->messages[(head + i) % LOG_THREAD_BUFFER_MESSAGES];
+				record.timestampNs = message.timestampNs;
+				record.threadID = message.threadID;
+				record.level = level;
+				record.format = message.format;
+				std::size_t offset = static_cast<std::size_t>(i) * LOG_MESSAGE_SIZE;
+				record.length = static_cast<u16>(std::min(LOG_MESSAGE_SIZE, length - offset));
+				std::memcpy(record.text, text + offset, record.length);
+				record.continued = i + 1 < records;
+			}
+		}
+		//Every record of the message is published at once, so the background thread never sees part of one
+		buffer->head.store(head + records, std::memory_order_release);
+
+		//Without a background thread, drain straight away so nothing logged before the sink starts (or after it stops) is lost
+		if (s_running.load(std::memory_order_acquire))
+		{
+			return;
+		}
+		std::unique_lock<std::mutex> lock(s_sinkMutex, std::try_to_lock);
+		if (lock.owns_lock() && !s_running.load(std::memory_order_relaxed))
+		{
+			std::vector<std::pair<ThreadLogBuffer*, u64>> pending;
+			std::vector<const LogMessage*> ordered;
+			drainBuffers(pending, ordered);
+		}
+	}
+
+	void Logger::start(LogSink sink)
+	{
+		stop();
+		std::lock_guard<std::mutex> lock(s_sinkMutex);
+		s_sink = std::move(sink);
+		s_running = true;
+		s_stopRequested = false;
+		s_drainThread = new std::thread(drainThreadMain);
+	}
+
+	bool Logger::startBinary(const std::string& filePath)
+	{
+		stop();
+		std::lock_guard<std::mutex> lock(s_sinkMutex);
+		if (!s_binaryWriter.open(filePath))
+		{
+			return false;
+		}
+		s_captureArguments = true;
+		s_running = true;
+		s_stopRequested = false;
+		s_drainThread = new std::thread(drainThreadMain);
+		return true;
+	}
+
+	void Logger::stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(s_sinkMutex);
+			if (!s_running)
+			{
+				return;
+			}
+			s_stopRequested = true;
+			s_drainRequests++;
+			//Messages captured before this are still written to the binary log by the final drains below
+			s_captureArguments = false;
+		}
+		s_drainRequested.notify_all();
+		s_drainThread->join();
+		delete s_drainThread;
+		s_drainThread = nullptr;
+		std::lock_guard<std::mutex> lock(s_sinkMutex);
+		s_running = false;
+		//Anything logged whilst the background thread was finishing is written before the sink is released
+		std::vector<std::pair<ThreadLogBuffer*, u64>> pending;
+		std::vector<const LogMessage*> ordered;
+		drainBuffers(pending, ordered);
+		s_sink = nullptr;
+		s_binaryWriter.close();
+	}
+
+	void Logger::flush()
+	{
+		std::unique_lock<std::mutex> lock(s_sinkMutex);
+		if (!s_running)
+		{
+			return; //Messages are written as they are logged without a background thread
+		}
+		u64 request = ++s_drainRequests;
+		s_drainRequested.notify_all();
+		s_drainCompleted.wait(lock, [request]() { return s_drainsCompleted >= request; });
+	}
+
+	u64 Logger::getDroppedCount()
+	{
+		return s_droppedCount.load(std::memory_order_relaxed);
+	}
+
+	bool Logger::shouldLog(std::atomic<u64>& lastNs, u32 intervalMs)
+	{
+		u64 now = systemTimeNs();
+		u64 last = lastNs.load(std::memory_order_relaxed);
+		if (last != 0 && now - last < static_cast<u64>(intervalMs) * 1000000ull)
+		{
+			return false;
+		}
+		//Only one thread wins the call site's slot if several log at once
+		return lastNs.compare_exchange_strong(last, now, std::memory_order_relaxed);
+	}
+}
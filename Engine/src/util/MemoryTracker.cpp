@@ -0,0 +1,215 @@
+//------- Memory Tracker ----
+//Heap Allocation Tracking
+//For The Sol Core Engine
+//---------------------------
+
+#include "util/MemoryTracker.h"
+
+//C++ libraries
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <malloc.h>
+#include <new>
+
+namespace EngineMemory
+{
+	namespace
+	{
+		std::atomic<u64> s_allocationCount{ 0 };
+		std::atomic<u64> s_freeCount{ 0 };
+
+		struct TagCounters
+		{
+			std::atomic<u64> currentBytes{ 0 };
+			std::atomic<u64> peakBytes{ 0 };
+			std::atomic<u64> allocationCount{ 0 };
+			std::atomic<u64> freeCount{ 0 };
+		};
+		TagCounters s_tagCounters[MEMORY_TAG_COUNT];
+
+		thread_local MemoryTag t_currentTag = MemoryTag::Untagged;
+
+		const char* const TAG_NAMES[MEMORY_TAG_COUNT] = { "Untagged", "Core", "Log", "Render", "Gui", "Physics", "Event", "Resource", "Shader", "Ecs", "Scene" };
+
+		//Each block is allocated with a trailer after the requested bytes: a marker identifying the block as tracked, then the tag
+		//A trailer (rather than a header) means the pointer handed out is the one malloc returned, so memory allocated here
+		//can still be freed by another module's operator delete/free, as it could before allocations were tagged
+		//The size is recovered from the CRT heap with _msize when freeing
+		//The marker mixes in the block's size, so a block allocated by another module (whose last bytes are arbitrary) is almost never mistaken for a tracked one
+		const u32 TRACKED_BLOCK_MAGIC = 0x536F4C4Du;
+		const std::size_t TRAILER_SIZE = sizeof(u32) + 1;
+
+		u32 trailerMarker(std::size_t size)
+		{
+			return TRACKED_BLOCK_MAGIC ^ static_cast<u32>(size * 2654435761u);
+		}
+
+		//The requested size and tag of a block allocated by trackedAllocate, false if the block wasn't (e.g. it was allocated by another module)
+		bool readTrailer(void* ptr, std::size_t& size, u8& tagIndex)
+		{
+			std::size_t blockSize = _msize(ptr);
+			if (blockSize == static_cast<std::size_t>(-1) || blockSize < TRAILER_SIZE)
+			{
+				return false;
+			}
+			size = blockSize - TRAILER_SIZE;
+			const unsigned char* trailer = static_cast<const unsigned char*>(ptr) + size;
+			u32 marker;
+			std::memcpy(&marker, trailer, sizeof(marker));
+			tagIndex = trailer[sizeof(marker)];
+			return marker == trailerMarker(size) && tagIndex < MEMORY_TAG_COUNT;
+		}
+
+		void recordAllocation(std::size_t size, MemoryTag tag)
+		{
+			s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+			TagCounters& counters = s_tagCounters[static_cast<std::size_t>(tag)];
+			counters.allocationCount.fetch_add(1, std::memory_order_relaxed);
+			u64 current = counters.currentBytes.fetch_add(size, std::memory_order_relaxed) + size;
+			u64 peak = counters.peakBytes.load(std::memory_order_relaxed);
+			while (current > peak && !counters.peakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {}
+		}
+
+		void* trackedAllocate(std::size_t size, MemoryTag tag) noexcept
+		{
+			unsigned char* ptr = static_cast<unsigned char*>(std::malloc(size + TRAILER_SIZE)); //Also makes size 0 unique, as operator new requires
+			if (!ptr)
+			{
+				return nullptr;
+			}
+			u32 marker = trailerMarker(size);
+			std::memcpy(ptr + size, &marker, sizeof(marker));
+			ptr[size + sizeof(marker)] = static_cast<unsigned char>(tag);
+			recordAllocation(size, tag);
+			return ptr;
+		}
+
+		void trackedFree(void* ptr) noexcept
+		{
+			if (!ptr)
+			{
+				return;
+			}
+			std::size_t size;
+			u8 tagIndex;
+			//Memory allocated by another module was never counted, so it isn't counted as freed either
+			if (readTrailer(ptr, size, tagIndex))
+			{
+				TagCounters& counters = s_tagCounters[tagIndex];
+				counters.freeCount.fetch_add(1, std::memory_order_relaxed);
+				counters.currentBytes.fetch_sub(size, std::memory_order_relaxed);
+				s_freeCount.fetch_add(1, std::memory_order_relaxed);
+				//Cleared, so a block another module later gets from the same memory can't look tracked
+				std::memset(static_cast<unsigned char*>(ptr) + size, 0, TRAILER_SIZE);
+			}
+			std::free(ptr);
+		}
+	}
+
+	u64 MemoryTracker::getAllocationCount()
+	{
+		return s_allocationCount.load(std::memory_order_relaxed);
+	}
+
+	u64 MemoryTracker::getFreeCount()
+	{
+		return s_freeCount.load(std::memory_order_relaxed);
+	}
+
+	MemoryTagStats MemoryTracker::getTagStats(MemoryTag tag)
+	{
+		MemoryTagStats stats;
+		std::size_t index = static_cast<std::size_t>(tag);
+		if (index < MEMORY_TAG_COUNT)
+		{
+			const TagCounters& counters = s_tagCounters[index];
+			stats.currentBytes = counters.currentBytes.load(std::memory_order_relaxed);
+			stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+			stats.allocationCount = counters.allocationCount.load(std::memory_order_relaxed);
+			stats.freeCount = counters.freeCount.load(std::memory_order_relaxed);
+		}
+		return stats;
+	}
+
+	const char* MemoryTracker::getTagName(MemoryTag tag)
+	{
+		std::size_t index = static_cast<std::size_t>(tag);
+		return index < MEMORY_TAG_COUNT ? TAG_NAMES[index] : "Unknown";
+	}
+
+	MemoryTag MemoryTracker::getCurrentTag()
+	{
+		return t_currentTag;
+	}
+
+	void MemoryTracker::setCurrentTag(MemoryTag tag)
+	{
+		t_currentTag = tag;
+	}
+
+	void* MemoryTracker::allocate(std::size_t size, MemoryTag tag)
+	{
+		return trackedAllocate(size, tag);
+	}
+
+	void* MemoryTracker::reallocate(void* ptr, std::size_t size, MemoryTag tag)
+	{
+		if (!ptr)
+		{
+			return trackedAllocate(size, tag);
+		}
+		void* newPtr = trackedAllocate(size, tag);
+		if (newPtr)
+		{
+			std::size_t oldSize;
+			u8 tagIndex;
+			if (!readTrailer(ptr, oldSize, tagIndex))
+			{
+				oldSize = _msize(ptr);
+			}
+			std::memcpy(newPtr, ptr, oldSize < size ? oldSize : size);
+			trackedFree(ptr);
+		}
+		return newPtr;
+	}
+
+	void MemoryTracker::free(void* ptr)
+	{
+		trackedFree(ptr);
+	}
+}
+
+//Global replacements, every form of operator new/delete must be replaced together so allocations and frees always match
+
+void* operator new(std::size_t size)
+{
+	void* ptr = EngineMemory::trackedAllocate(size, EngineMemory::t_currentTag);
+	if (!ptr)
+	{
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+	return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	return EngineMemory::trackedAllocate(size, EngineMemory::t_currentTag);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return EngineMemory::trackedAllocate(size, EngineMemory::t_currentTag);
+}
+
+void operator delete(void* ptr) noexcept { EngineMemory::trackedFree(ptr); }
+void operator delete[](void* ptr) noexcept { EngineMemory::trackedFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { EngineMemory::trackedFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { EngineMemory::trackedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { EngineMemory::trackedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { EngineMemory::trackedFree(ptr); }
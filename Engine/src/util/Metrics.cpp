@@ -0,0 +1,71 @@
+//------- Metrics -----------
+//Per-Frame Performance Metrics
+//For The Sol Core Engine
+//---------------------------
+
+#include "util/Metrics.h"
+#include "util/MemoryTracker.h"
+
+namespace EngineMetrics
+{
+	void Metrics::beginFrame()
+	{
+		m_currentFrame = FrameCounters{};
+		m_allocationsAtFrameStart = EngineMemory::MemoryTracker::getAllocationCount();
+		for (std::size_t tag = 0; tag < EngineMemory::MEMORY_TAG_COUNT; tag++)
+		{
+			m_tagAllocationsAtFrameStart[tag] = EngineMemory::MemoryTracker::getTagStats(static_cast<EngineMemory::MemoryTag>(tag)).allocationCount;
+		}
+	}
+
+	void Metrics::endFrame(double frameTimeMs)
+	{
+		m_lastFrame = m_currentFrame;
+		m_frameTimeMs.push(static_cast<float>(frameTimeMs));
+		m_drawCalls.push(static_cast<float>(m_currentFrame.drawCalls));
+		for (std::size_t pass = 0; pass < GPU_PASS_COUNT; pass++)
+		{
+			m_gpuPassMs[pass].push(m_currentFrame.gpuPassMs[pass]);
+		}
+		m_allocationsPerFrame.push(static_cast<float>(EngineMemory::MemoryTracker::getAllocationCount() - m_allocationsAtFrameStart));
+		for (std::size_t tag = 0; tag < EngineMemory::MEMORY_TAG_COUNT; tag++)
+		{
+			u64 allocations = EngineMemory::MemoryTracker::getTagStats(static_cast<EngineMemory::MemoryTag>(tag)).allocationCount;
+			m_tagAllocationsPerFrame[tag].push(static_cast<float>(allocations - m_tagAllocationsAtFrameStart[tag]));
+		}
+	}
+
+	void Metrics::recordFixedTick(double tickTimeMs)
+	{
+		m_fixedTickMs.push(static_cast<float>(tickTimeMs));
+	}
+
+	void Metrics::recordPacingError(double pacingErrorMs)
+	{
+		m_pacingErrorMs.push(static_cast<float>(pacingErrorMs));
+	}
+
+	std::size_t Metrics::registerSystem(const std::string& name)
+	{
+		//Registering happens once per System at initialization, so this is the only place Metrics allocates
+		m_systems.emplace_back();
+		m_systems.back().name = name;
+		return m_systems.size() - 1;
+	}
+
+	void Metrics::recordSystemUpdate(std::size_t systemIndex, double updateMs)
+	{
+		if (systemIndex < m_systems.size())
+		{
+			m_systems[systemIndex].updateMs.push(static_cast<float>(updateMs));
+		}
+	}
+
+	void Metrics::recordSystemFixedUpdate(std::size_t systemIndex, double fixedUpdateMs)
+	{
+		if (systemIndex < m_systems.size())
+		{
+			m_systems[systemIndex].fixedUpdateMs.push(static_cast<float>(fixedUpdateMs));
+		}
+	}
+}
@@ -0,0 +1,204 @@
+//------- Profiler ----------
+//Frame Instrumentation
+//For The Sol Core Engine
+//---------------------------
+
+#include "util/Profiler.h"
+
+//C++ libraries
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+#include <algorithm>
+
+namespace EngineProfiler
+{
+	namespace
+	{
+		//Ring buffer owned by exactly one thread
+		//Only the owning thread writes, so a single atomic head index is enough to make it lock-free
+		//Readers copy a snapshot and discard anything the writer may have overwritten whilst copying
+		struct ThreadBuffer
+		{
+			std::unique_ptr<ZoneEvent[]> events{ new ZoneEvent[Profiler::THREAD_BUFFER_CAPACITY] };
+			std::atomic<u64> head{ 0 };
+			std::atomic<u64> clearedUpTo{ 0 }; //Zones below this index were discarded by clear()
+			u32 threadID = 0;
+			std::string threadName;
+		};
+
+		std::atomic<bool> s_enabled{ false };
+
+		//Registration of thread buffers is the only locked operation, and happens once per thread
+		std::mutex s_registryMutex;
+		std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+
+		thread_local ThreadBuffer* t_buffer = nullptr;
+
+		//Interned zone names, never removed (not even by clear()) since buffered zones may still point at them
+		//unordered_set's nodes don't move when it rehashes, so the pointers handed out stay valid
+		std::mutex s_internMutex;
+		std::unordered_set<std::string> s_internedNames;
+
+		//Get (or lazily create and register) the calling thread's buffer
+		ThreadBuffer* getThreadBuffer()
+		{
+			if (!t_buffer)
+			{
+				std::lock_guard<std::mutex> lock(s_registryMutex);
+				s_buffers.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer()));
+				t_buffer = s_buffers.back().get();
+				t_buffer->threadID = static_cast<u32>(s_buffers.size());
+			}
+			return t_buffer;
+		}
+
+		//Write a string as a JSON string literal, escaping anything that would break the trace file
+		void writeJsonString(FILE* file, const char* str)
+		{
+			std::fputc('"', file);
+			for (const char* c = str; *c; ++c)
+			{
+				if (*c == '"' || *c == '\\') { std::fputc('\\', file); }
+				if (static_cast<unsigned char>(*c) < 0x20) { continue; }
+				std::fputc(*c, file);
+			}
+			std::fputc('"', file);
+		}
+	}
+
+	void Profiler::setEnabled(bool enabled)
+	{
+		s_enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	bool Profiler::isEnabled()
+	{
+		return s_enabled.load(std::memory_order_relaxed);
+	}
+
+	void Profiler::setThreadName(const char* threadName)
+	{
+		ThreadBuffer* buffer = getThreadBuffer();
+		std::lock_guard<std::mutex> lock(s_registryMutex);
+		buffer->threadName = threadName;
+	}
+
+	u64 Profiler::now()
+	{
+		return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	void Profiler::recordZone(const char* name, u64 startNs, u64 endNs)
+	{
+		ThreadBuffer* buffer = getThreadBuffer();
+		u64 index = buffer->head.load(std::memory_order_relaxed);
+		buffer->events[index & (THREAD_BUFFER_CAPACITY - 1)] = ZoneEvent{ name, startNs, endNs };
+		//Release so that a reader who sees the new head also sees the event written above
+		buffer->head.store(index + 1, std::memory_order_release);
+	}
+
+	const char* Profiler::internName(const std::string& name)
+	{
+		std::lock_guard<std::mutex> lock(s_internMutex);
+		return s_internedNames.insert(name).first->c_str();
+	}
+
+	bool Profiler::dumpChromeTrace(const std::string& filePath, double lastSeconds)
+	{
+		FILE* file = std::fopen(filePath.c_str(), "w");
+		if (!file)
+		{
+			return false;
+		}
+
+		u64 cutoffNs = 0;
+		if (lastSeconds > 0.0)
+		{
+			u64 windowNs = static_cast<u64>(lastSeconds * 1e9);
+			u64 nowNs = now();
+			cutoffNs = nowNs > windowNs ? nowNs - windowNs : 0;
+		}
+
+		std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", file);
+		bool first = true;
+
+		std::lock_guard<std::mutex> lock(s_registryMutex);
+		std::vector<ZoneEvent> snapshot;
+		snapshot.reserve(THREAD_BUFFER_CAPACITY);
+		for (const auto& buffer : s_buffers)
+		{
+			//Thread name metadata so the trace viewer can label each track
+			if (!buffer->threadName.empty())
+			{
+				std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",\n", buffer->threadID);
+				writeJsonString(file, buffer->threadName.c_str());
+				std::fputs("}}", file);
+				first = false;
+			}
+
+			//Copy a snapshot of the ring, then re-read the head and drop anything that could have been overwritten during the copy
+			u64 headBefore = buffer->head.load(std::memory_order_acquire);
+			u64 begin = std::max(headBefore > THREAD_BUFFER_CAPACITY ? headBefore - THREAD_BUFFER_CAPACITY : 0, buffer->clearedUpTo.load(std::memory_order_relaxed));
+			snapshot.clear();
+			for (u64 i = begin; i < headBefore; i++)
+			{
+				snapshot.push_back(buffer->events[i & (THREAD_BUFFER_CAPACITY - 1)]);
+			}
+			u64 headAfter = buffer->head.load(std::memory_order_acquire);
+			u64 firstValid = headAfter > THREAD_BUFFER_CAPACITY ? headAfter - THREAD_BUFFER_CAPACITY : 0;
+			size_t skip = firstValid > begin ? static_cast<size_t>(firstValid - begin) : 0;
+
+			for (size_t i = skip; i < snapshot.size(); i++)
+			{
+				const ZoneEvent& zone = snapshot[i];
+				if (zone.endNs < cutoffNs)
+				{
+					continue;
+				}
+				//Chrome trace timestamps are in microseconds, fractional part keeps nanosecond precision
+				std::fprintf(file, "%s{\"name\":", first ? "" : ",\n");
+				writeJsonString(file, zone.name ? zone.name : "Unnamed");
+				std::fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+					buffer->threadID, zone.startNs / 1000.0, (zone.endNs - zone.startNs) / 1000.0);
+				first = false;
+			}
+		}
+
+		std::fputs("\n]}\n", file);
+		std::fclose(file);
+		return true;
+	}
+
+	void Profiler::clear()
+	{
+		//Zones are not actually erased, the read window is just moved past them so writers are never blocked
+		std::lock_guard<std::mutex> lock(s_registryMutex);
+		for (const auto& buffer : s_buffers)
+		{
+			buffer->clearedUpTo.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+		}
+	}
+
+	ScopedZone::ScopedZone(const char* name) : m_name(nullptr), m_startNs(0)
+	{
+		if (Profiler::isEnabled())
+		{
+			m_name = name;
+			m_startNs = Profiler::now();
+		}
+	}
+
+	ScopedZone::~ScopedZone()
+	{
+		if (m_name)
+		{
+			Profiler::recordZone(m_name, m_startNs, Profiler::now());
+		}
+	}
+}
@@ -0,0 +1,159 @@
+//------- Render Benchmark --
+//Sprite Submission Benchmark
+//For The Sol Core Engine
+//---------------------------
+
+#include "util/RenderBenchmark.h"
+
+#include "Core.h"
+#include "ecs/EcsElement.h"
+#include "systems/NullRenderDevice.h"
+#include "systems/RecordingRenderDevice.h"
+
+//C++ libraries
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
+
+namespace EngineBenchmark
+{
+	namespace
+	{
+		//Textures the sprites are spread across, so batches break on texture changes as they would in a scene
+		const int BENCHMARK_TEXTURES = 16;
+		const int BENCHMARK_TEXTURE_SIZE = 64;
+		//How far a dynamic sprite moves each frame, in pixels
+		const float BENCHMARK_MOVE_PIXELS = 2.0f;
+		//Fixed, so every run benchmarks the same sprites
+		const unsigned int BENCHMARK_SEED = 572;
+
+		double millisecondsSince(std::chrono::steady_clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+	}
+
+	bool runSpriteBenchmark(const std::vector<u32>& spriteCounts, u32 frames, const std::string& commandStreamPath, std::vector<SpriteBenchmarkResult>& results)
+	{
+		results.clear();
+
+		//Only the Resource Element (for the texture atlas) and the ECS Element with its Render System, so there is no window, no OpenGL, and no physics
+		auto core = std::make_shared<Sol::Core>();
+		core->attachElement("Resource");
+		core->attachElement("Ecs");
+		core->configureElement<CoreEcsElement::EcsElement>(true, false, false);
+		//The device is installed before the Render System is created, as it must be
+		EcsRenderSystem::NullRenderDevice* device = nullptr;
+		if (!commandStreamPath.empty())
+		{
+			auto recording = new EcsRenderSystem::RecordingRenderDevice(commandStreamPath);
+			device = recording;
+			core->setRenderDevice(std::unique_ptr<EcsRenderSystem::RenderDevice>(recording));
+			if (!recording->isOpen())
+			{
+				return false;
+			}
+		}
+		else
+		{
+			device = new EcsRenderSystem::NullRenderDevice();
+			core->setRenderDevice(std::unique_ptr<EcsRenderSystem::RenderDevice>(device));
+		}
+		if (!core->initialize())
+		{
+			core->terminate();
+			return false;
+		}
+		auto ecsElement = core->getEcsElement();
+		//Only sprites are timed, not debug lines
+		core->getDebugDraw().setFlags(0);
+
+		std::vector<u32> textures;
+		for (int i = 0; i < BENCHMARK_TEXTURES; i++)
+		{
+			textures.push_back(device->createTexture(BENCHMARK_TEXTURE_SIZE, BENCHMARK_TEXTURE_SIZE, 4, nullptr, EcsRenderSystem::RenderDevice::ALL_MIP_LEVELS));
+		}
+
+		std::mt19937 random(BENCHMARK_SEED);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+		//Spread over twice the screen's width and height about the camera, so roughly a quarter of the sprites are visible
+		const float halfWidth = ApplicationConfig::Config::screenWidth;
+		const float halfHeight = ApplicationConfig::Config::screenHeight;
+		std::vector<TransformComponent*> dynamicTransforms;
+		u32 sprites = 0;
+
+		for (u32 spriteCount : spriteCounts)
+		{
+			for (; sprites < spriteCount; sprites++)
+			{
+				Entity entity = ecsElement->createEntity();
+				TransformComponent transform(glm::vec3((unit(random) * 2.0f - 1.0f) * halfWidth, (unit(random) * 2.0f - 1.0f) * halfHeight, 0.0f), unit(random) * 360.0f, glm::vec3(1.0f));
+				ecsElement->addComponent<TransformComponent>(entity, transform);
+				SpriteComponent sprite;
+				sprite.textureID = textures[random() % textures.size()];
+				sprite.size = glm::vec2(16.0f + unit(random) * 32.0f);
+				sprite.color = glm::vec4(1.0f, 1.0f, 1.0f, 0.5f + unit(random) * 0.5f);
+				sprite.sortingLayer = static_cast<int>(random() % 4);
+				sprite.orderInLayer = static_cast<int>(random() % 100);
+				sprite.blendMode = static_cast<SpriteBlendMode>(random() % 3);
+				ecsElement->addComponent<SpriteComponent>(entity, sprite);
+				//Three quarters are dynamic, so are streamed every frame rather than kept in static chunks
+				if (sprites % 4 != 0)
+				{
+					ecsElement->addComponent<PhysicsBodyComponent>(entity, PhysicsBodyComponent(BodyType::Dynamic, b2Vec2(0.0f, 0.0f), nullptr, false));
+					dynamicTransforms.push_back(ecsElement->findComponent<TransformComponent>(entity));
+				}
+			}
+
+			SpriteBenchmarkResult result;
+			result.sprites = sprites;
+			result.frames = frames;
+			u64 invalidCallsBefore = device->getCounts().invalidCalls;
+			double totalMs = 0.0;
+			for (u32 frame = 0; frame <= frames; frame++)
+			{
+				//Moving the sprites isn't timed, only the Render System's update is
+				if (frame > 0)
+				{
+					float offset = BENCHMARK_MOVE_PIXELS * ((frame % 2) ? 1.0f : -1.0f);
+					for (TransformComponent* transform : dynamicTransforms)
+					{
+						transform->position.x += offset;
+					}
+				}
+				EngineMetrics::Metrics* metrics = core->getMetrics();
+				metrics->beginFrame();
+				auto start = std::chrono::steady_clock::now();
+				ecsElement->update(1.0 / 60.0);
+				double frameMs = millisecondsSince(start);
+				metrics->endFrame(frameMs);
+				core->getFrameArena().reset();
+				core->getDebugDraw().clear();
+				if (frame == 0)
+				{
+					result.firstFrameMs = frameMs;
+				}
+				else
+				{
+					totalMs += frameMs;
+				}
+			}
+
+			const EngineMetrics::FrameCounters& counters = core->getMetrics()->lastFrame();
+			result.msPerFrame = frames > 0 ? totalMs / frames : result.firstFrameMs;
+			result.spritesPerSecond = result.msPerFrame > 0.0 ? sprites / (result.msPerFrame / 1000.0) : 0.0;
+			result.spritesSubmitted = counters.spritesSubmitted;
+			result.spritesCulled = counters.spritesCulled;
+			result.drawCalls = counters.drawCalls;
+			result.invalidCalls = device->getCounts().invalidCalls - invalidCallsBefore;
+			results.push_back(result);
+			SOL_LOG_INFO("[Benchmark] %u Sprites: %.3f ms Per Frame (%.3f ms First Frame), %.2f Million Sprites/s, %u Submitted, %u Culled, %u Draw Calls, %llu Invalid Calls",
+				result.sprites, result.msPerFrame, result.firstFrameMs, result.spritesPerSecond / 1000000.0, result.spritesSubmitted, result.spritesCulled, result.drawCalls,
+				static_cast<unsigned long long>(result.invalidCalls));
+		}
+
+		core->terminate();
+		return true;
+	}
+}
@@ -17,6 +17,8 @@
 #include <fstream>
 #pragma warning(pop)
 
+#include "util/Log.h"
+
 namespace ApplicationConfig
 {
 	class Config {
@@ -47,7 +49,7 @@ namespace ApplicationConfig
             std::string configFilePath = projectPath + "/Config.txt";
             std::ofstream file(configFilePath);
             if (!file) {
-                std::cerr << "Error: Unable to open file for writing at " << configFilePath << std::endl;
+                SOL_LOG_ERROR("[Config] Unable to Open File for Writing at %s", configFilePath.c_str());
                 return;
             }
             file << "Project Name: " << projectName << std::endl;
@@ -62,7 +64,7 @@ namespace ApplicationConfig
             std::string configFilePath = projectPath + "/Config.txt";
             std::ifstream file(configFilePath);
             if (!file) {
-                std::cerr << "Error: Unable to open file for reading at " << configFilePath << std::endl;
+                SOL_LOG_ERROR("[Config] Unable to Open File for Reading at %s", configFilePath.c_str());
                 return;
             }
             std::string line;
@@ -11,49 +11,97 @@
 #include "EngineAPI.h"
 
 //C++ libraries
+#include <atomic>
 #include <memory>
 #include <iostream>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
-//All element headers, components header, and the config header
-#include "debuglog/LogElement.h"
-#include "render/RenderElement.h"
-#include "render/GuiElement.h"
-#include "physics/PhysicsElement.h"
-#include "event/EventElement.h"
-#include "resource/ResourceElement.h"
-#include "resource/ShaderElement.h"
-#include "ecs/EcsElement.h"
+//The Element base class, all built-in Element headers and their compile-time descriptions, components header, and the config header
+#include "Element.h"
+#include "ElementTraits.h"
 #include "ecs/Components.h"
-#include "scene/SceneElement.h"
 
 #include "Config.h"
 
+//Asynchronous logging through the SOL_LOG macros, to the Log Element's file once it is initialized, otherwise to the console
+#include "util/Log.h"
+//Frame instrumentation, zone macros compile out unless SOL_ENABLE_PROFILER is defined
+#include "util/Profiler.h"
+//Per-frame performance metrics, displayed by the Editor's Performance viewport
+#include "util/Metrics.h"
+//Input recording and replay
+#include "util/InputLog.h"
+//Frame and tick arenas for transient data
+#include "util/Arena.h"
+//Batched debug lines
+#include "util/DebugDraw.h"
+//The graphics API behind rendering, OpenGL once the Render Element is initialized, otherwise the null device
+#include "systems/RenderDevice.h"
+
 namespace Sol
 {
+	//When and where each phase of an Element's initialization ran, for the startup report
+	struct ElementStartupTiming
+	{
+		size_t index = 0;
+		u64 prepareStartNs = 0;
+		u64 prepareEndNs = 0;
+		u64 initializeStartNs = 0;
+		u64 initializeEndNs = 0;
+		bool initializedOnMainThread = true;
+	};
+
 	class Core : public std::enable_shared_from_this<Core>
 	{
 	public:
-		//Initialize pointers to Elements with new instances of Elements
+		//Register the built-in Elements, no Elements are attached until attachElement is called
 		ENGINE_API Core();
 		//Release resources associated with the Core instance
 		ENGINE_API ~Core();
 
 		//Attach an Element in application runtime
 		//elementName should only be in Capitalization case e.g. 'Render', and should not include 'Element'
+		//Any registered Element can be attached by name, including Elements registered by plugins
 		ENGINE_API bool attachElement(const std::string& elementName);
 
 		//Detach an Element, not normally used in application runtime however could be required outside of the Core's terminate function
 		//Calls the Element's terminate function and sets the Core's smart pointer to this Element as a nullptr to ensure memory deallocated
 		ENGINE_API bool detachElement(const std::string& elementName);
 
-		//Initialize Core
+		//Initialize Core, which initializes every attached Element (that is not already initialized) in dependency order
+		//Each Element is initialized with the parameters given to configureElement, or with its default parameters otherwise
+		//Independent Elements are initialized in parallel: every Element's prepare runs on a worker thread straight away, and Elements that
+		//don't need the main thread are initialized on worker threads as soon as their dependencies are, whilst the main thread initializes the rest
+		//Each phase is timed and a startup report is written to the log
 		//Return true/false to be handled by the application
 		ENGINE_API bool initialize();
 
+		//Set the parameters a built-in Element will be initialized with by initialize()
+		//e.g. appCore->configureElement<CoreLogElement::LogElement>(std::string("Sol-Editor.txt"));
+		template<typename T, typename... Args>
+		void configureElement(Args... args)
+		{
+			setElementInitializer(ElementTraits<T>::index, [args...](Element& element) { return static_cast<T&>(element).initialize(args...); });
+		}
+		//Set the initializer of any registered Element by name, e.g. an Element registered by a plugin
+		ENGINE_API bool configureElement(const std::string& elementName, ElementInitializer initializer);
+
 		//Update Core (which in turn updates all Elements appropriately)
 		ENGINE_API void run();
 
+		//Idle mode, for the Editor: whilst the scene isn't running and the GUI has no interaction in progress, run() blocks waiting for events
+		//rather than spinning, and only redraws on input, on window events, when the ECS is modified, or when a redraw is requested
+		ENGINE_API void setIdleEnabled(bool enabled);
+		//Redraw at least one frame even whilst idle, safe to call from any thread
+		ENGINE_API void requestRedraw();
+
+		//Cap the frame rate, independently of vsync, 0 for uncapped
+		//Each frame sleeps for most of the time left until its deadline then spins for the rest, so frame times stay within a fraction of a millisecond
+		ENGINE_API void setFrameRateCap(double framesPerSecond);
+		ENGINE_API double getFrameRateCap() const;
+
 		//Detach all Elements using detachElement function for each Element
 		ENGINE_API void terminate();
 
@@ -88,6 +136,74 @@ namespace Sol
 		//Return a pointer to the SceneElement instance managed by the Core
 		ENGINE_API CoreSceneElement::SceneElement* getSceneElement() const;
 
+		//Return a pointer to a built-in Element, or nullptr if not attached
+		//O(1), since every built-in Element's index is known at compile time
+		template<typename T>
+		T* get() const
+		{
+			return static_cast<T*>(m_elements[ElementTraits<T>::index].get());
+		}
+
+		//Return a pointer to any registered Element by name, or nullptr if not registered or not attached
+		ENGINE_API Element* getElement(const std::string& elementName) const;
+
+		//---
+
+		//Element registration and plugins
+
+		//Register a custom Element so it can be attached by name
+		//dependencies are the names of Elements that must be initialized before this one (if attached), the Log Element is always implied
+		//Registered Elements are updated by the Core every frame and every fixed timestep tick through Element's update and fixedUpdate
+		//Set mainThread to false only if initialize is safe to run on a worker thread (i.e. it uses no SDL video, OpenGL, or Dear ImGui)
+		ENGINE_API bool registerElement(const std::string& elementName, const std::vector<std::string>& dependencies, ElementFactory create, ElementInitializer initialize, bool mainThread = true);
+
+		//Load a plugin shared library and call its solRegisterPlugin function, which registers (and usually attaches) its Elements
+		//Plugins stay loaded until the Core is destroyed, after every Element has been released
+		ENGINE_API bool loadPlugin(const std::string& filePath);
+
+		//---
+
+		//Return a pointer to the performance metrics recorded by the Core, the ECS Element, and the Systems
+		ENGINE_API EngineMetrics::Metrics* getMetrics();
+
+		//Arenas for transient data, e.g. the containers Systems rebuild every frame or tick, so that steady-state frames don't touch the heap
+		//The frame arena is reset at the end of every frame, and the tick arena at the end of every fixed timestep tick
+		//Only use them from the main thread, and never keep anything allocated from them beyond the frame or tick
+		ENGINE_API EngineMemory::LinearArena& getFrameArena();
+		ENGINE_API EngineMemory::LinearArena& getTickArena();
+
+		//Debug lines from any System or Element, drawn by the Render System with one draw call per frame
+		//Cleared at the end of every frame, so lines must be added again every frame they should be seen
+		ENGINE_API EngineDebugDraw::DebugDraw& getDebugDraw();
+
+		//Make the OpenGL context current on the main thread, waiting for the Render Element's render thread if it has the context
+		//Anything using OpenGL on the main thread outside the GUI must call this first whilst the render thread is enabled, see RenderElement::setRenderThreadEnabled
+		//Does nothing if the context is already on the main thread, or there is no Render Element
+		ENGINE_API void acquireGLContext();
+
+		//The device the Render System, the Resource Element, and the Shader Element create resources and draw through
+		//The null device (which only counts and checks calls) until the Render Element installs the OpenGL device, so a Core without one can still run the Render System
+		ENGINE_API EcsRenderSystem::RenderDevice& getRenderDevice();
+		//Replace the device, nullptr restores the null device
+		//Only whilst nothing has created resources through the current device, i.e. before the ECS Element is initialized or after it is terminated
+		ENGINE_API void setRenderDevice(std::unique_ptr<EcsRenderSystem::RenderDevice> device);
+
+		//---
+
+		//Input recording and replay, for deterministic reproduction of bugs and performance spikes, and for benchmark workloads
+
+		//Record the input fed to the simulation on every fixed timestep tick, starting from the current scene, into a compact binary log
+		//The current scene is saved and reloaded first so the recording starts from exactly the state a replay will start from
+		ENGINE_API bool startRecording(const std::string& filePath);
+		ENGINE_API void stopRecording();
+		ENGINE_API bool isRecording() const;
+
+		//Replay a recorded log from its initial scene, running one tick per frame as fast as possible
+		//If headless, rendering and the GUI are skipped entirely and the application quits once the replay finishes
+		ENGINE_API bool startReplay(const std::string& filePath, bool headless);
+		ENGINE_API void stopReplay();
+		ENGINE_API bool isReplaying() const;
+
 		//---
 
 	private:
@@ -96,17 +212,59 @@ namespace Sol
 		//Additionally, if an exception is thrown during the initialization of Core, Element objects automatically deleted
 		//This ensures no memory leaks there
 		
-		//Smart pointer(s) for an instance of the each Element (unique for most, shared for ECS to allow Systems to own the ECS and therefore ensure its lifetime until they are complete and no longer in use)
+		//Element storage, indexed by ElementTraits<T>::index for built-in Elements, with registered Elements after them
+		//shared_ptr rather than unique_ptr so the ECS Element can be shared with the Systems, ensuring its lifetime until they are complete
 		//--- 
-		std::unique_ptr<CoreLogElement::LogElement> m_logElement;
-		std::unique_ptr<CoreRenderElement::RenderElement> m_renderElement;
-		std::unique_ptr<CoreGuiElement::GuiElement> m_guiElement;
-		std::unique_ptr<CoreEventElement::EventElement> m_eventElement;
-		std::unique_ptr<CorePhysicsElement::PhysicsElement> m_physicsElement;
-		std::unique_ptr<CoreResourceElement::ResourceElement> m_resourceElement;
-		std::unique_ptr<CoreShaderElement::ShaderElement> m_shaderElement;
-		std::shared_ptr<CoreEcsElement::EcsElement> m_ecsElement;
-		std::unique_ptr<CoreSceneElement::SceneElement> m_sceneElement;
+		std::vector<std::shared_ptr<Element>> m_elements;
+		std::vector<ElementRegistration> m_registrations; //Indexed the same as m_elements
+		std::unordered_map<std::string, size_t> m_elementIndices; //Element name to index
+		std::vector<void*> m_pluginHandles;
 		//---
+
+		//Exported, as the inline configureElement<T> calls it from outside the Engine DLL
+		ENGINE_API void setElementInitializer(size_t index, ElementInitializer initializer);
+		//Order attached Elements so that every Element comes after its attached dependencies, returns false if dependencies are circular
+		bool resolveInitializationOrder(std::vector<size_t>& order) const;
+		//Write the timings of each Element's prepare and initialize phases to the log, ordered by when they started
+		void logStartupReport(const std::vector<ElementStartupTiming>& timings, u64 startNs, u64 endNs) const;
+		//Return the attached Element at index, logging an error naming the Element if it is not attached
+		Element* getAttachedElement(size_t index) const;
+
+		//Performance metrics, fixed-size so recording them costs almost nothing
+		EngineMetrics::Metrics m_metrics;
+
+		EngineMemory::LinearArena m_frameArena;
+		EngineMemory::LinearArena m_tickArena;
+		EngineDebugDraw::DebugDraw m_debugDraw;
+		std::unique_ptr<EcsRenderSystem::RenderDevice> m_renderDevice;
+		//Events polled each tick, reused so polling doesn't allocate
+		std::vector<SDL_Event> m_polledEvents;
+
+		const double m_fixedTimestep = 1.0 / 60.0; //60 updates per second
+
+		//Write this tick's input to the recording
+		void recordTick();
+		//Feed this tick's recorded input back in, returns false once the replay has finished (and the tick should not be simulated)
+		bool replayTick();
+
+		EngineReplay::InputLogWriter m_inputRecorder;
+		EngineReplay::InputLogReader m_inputReplayer;
+		EngineReplay::InputRecord m_nextReplayRecord; //Next record to be replayed, read one record ahead
+		bool m_replayHeadless = false;
+		bool m_replaySceneRunning = false;
+		u64 m_inputTick = 0; //Ticks since the recording or replay started
+		u32 m_lastSceneLoadCount = 0;
+		Uint64 m_replayStartTime = 0;
+
+		//Whether nothing can change on screen, so run() can wait for events rather than drawing another frame
+		bool canIdle(CoreEcsElement::EcsElement* ecsElement, CoreGuiElement::GuiElement* guiElement);
+		bool m_idleEnabled = false;
+		//Wait until the current frame's deadline, and record how far the measured frame time was from the target
+		void paceFrame();
+		double m_frameRateCap = 0.0;
+		Uint64 m_nextFrameDeadline = 0; //Performance counter value the current frame should end at, 0 if pacing is not started
+		Uint64 m_lastPacedFrameEnd = 0;
+		std::atomic<bool> m_redrawRequested{ false };
+		Uint64 m_lastActivityTime = 0; //When input, a window event, an ECS modification, or a redraw request last happened
 	};
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+//------- Element -----------
+//The Base Of Every Element
+//For The Sol Core Engine
+//---------------------------
+
+//Every Element derives from Sol::Element so that the Core can store, initialize, update, and terminate Elements generically
+//Built-in Elements are described at compile time by an ElementTraits specialization (see ElementTraits.h), giving each a fixed index for O(1) lookup
+//Custom Elements can be registered at runtime, including from plugin shared libraries loaded by the Core
+
+#pragma once
+
+#include "EngineAPI.h"
+
+//C++ libraries
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "util/MemoryTracker.h"
+
+namespace Sol
+{
+	class Core;
+
+	class Element
+	{
+	public:
+		virtual ~Element() {}
+
+		//CPU-only work that needs no other Element (e.g. building a font atlas), run on a worker thread by Core's initialize
+		//concurrently with the initialization of other Elements, and always finished before this Element's initialize is called
+		virtual bool prepare() { return true; }
+
+		//Release the Element's resources, called by the Core when the Element is detached
+		virtual void terminate() {}
+
+		//Called by the Core every frame and every fixed timestep tick for registered (e.g. plugin) Elements
+		//Built-in Elements are updated explicitly by the Core, in the order the main loop requires
+		virtual void update(double deltaTime) {}
+		virtual void fixedUpdate(double fixedTimestep) {}
+	};
+
+	//Compile-time description of a built-in Element, specialized for every built-in Element in ElementTraits.h
+	//Provides: static const size_t index, static const bool mainThread, static const EngineMemory::MemoryTag memoryTag, static const char* name(),
+	//static std::vector<std::string> dependencies(), and static bool initialize(T& element) which initializes the Element with default parameters
+	template<typename T>
+	struct ElementTraits;
+
+	//Creates an instance of an Element, given the Core that will own it
+	using ElementFactory = std::function<std::shared_ptr<Element>(std::shared_ptr<Core>)>;
+	//Initializes an attached Element, returning false on failure
+	using ElementInitializer = std::function<bool(Element&)>;
+
+	//Everything the Core needs to know to attach, initialize, and detach an Element by name
+	struct ElementRegistration
+	{
+		std::string name;
+		//Names of the Elements that must be initialized before this one (if they are attached)
+		std::vector<std::string> dependencies;
+		//Whether initialize must run on the main thread (e.g. it uses SDL video, OpenGL, or Dear ImGui)
+		//Otherwise Core's initialize runs it on a worker thread as soon as its dependencies are initialized
+		bool mainThread = true;
+		//The tag the Element's heap allocations are attributed to whilst it is prepared, initialized, and updated by the Core
+		EngineMemory::MemoryTag memoryTag = EngineMemory::MemoryTag::Untagged;
+		ElementFactory create;
+		//Default initializer, replaced by Core's configureElement
+		ElementInitializer initialize;
+		bool initialized = false;
+	};
+}
+
+//Plugin entry point
+//A plugin shared library must export a function of this name, e.g.
+//	SOL_PLUGIN_EXPORT void solRegisterPlugin(Sol::Core* core) { core->registerElement(...); core->attachElement(...); }
+#define SOL_PLUGIN_ENTRY_POINT "solRegisterPlugin"
+#define SOL_PLUGIN_EXPORT extern "C" __declspec(dllexport)
+using SolRegisterPluginFunction = void(*)(Sol::Core* core);
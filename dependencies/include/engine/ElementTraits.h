@@ -0,0 +1,150 @@
+//------- Element Traits ----
+//Built-In Element Registry
+//For The Sol Core Engine
+//---------------------------
+
+//Compile-time descriptions of the built-in Elements
+//Each built-in Element has a fixed index into the Core's Element storage, so Core's get<T>() is a single array access
+//Dependencies drive the order Core's initialize() initializes attached Elements in (and the reverse order they are terminated in)
+//Elements that don't need the main thread are initialized on worker threads, in parallel with any Elements they don't depend upon
+//The Log Element is an implicit dependency of every other Element, so that every Element can log from initialization onwards
+
+#pragma once
+
+#include "Element.h"
+
+//All built-in Element headers
+#include "debuglog/LogElement.h"
+#include "render/RenderElement.h"
+#include "render/GuiElement.h"
+#include "physics/PhysicsElement.h"
+#include "event/EventElement.h"
+#include "resource/ResourceElement.h"
+#include "resource/ShaderElement.h"
+#include "ecs/EcsElement.h"
+#include "scene/SceneElement.h"
+
+namespace Sol
+{
+	//Indices of the built-in Elements, registered (e.g. plugin) Elements are stored after these
+	enum BuiltInElementIndex : size_t
+	{
+		LOG_ELEMENT_INDEX = 0,
+		SHADER_ELEMENT_INDEX,
+		RESOURCE_ELEMENT_INDEX,
+		RENDER_ELEMENT_INDEX,
+		GUI_ELEMENT_INDEX,
+		PHYSICS_ELEMENT_INDEX,
+		EVENT_ELEMENT_INDEX,
+		ECS_ELEMENT_INDEX,
+		SCENE_ELEMENT_INDEX,
+		BUILT_IN_ELEMENT_COUNT
+	};
+
+	template<>
+	struct ElementTraits<CoreLogElement::LogElement>
+	{
+		static const size_t index = LOG_ELEMENT_INDEX;
+		static const bool mainThread = false;
+		static const EngineMemory::MemoryTag memoryTag = EngineMemory::MemoryTag::Log;
+		static const char* name() { return "Log"; }
+		static std::vector<std::string> dependencies() { return {}; }
+		static bool initialize(CoreLogElement::LogElement& element) { return element.initialize("Sol-Log.txt"); }
+	};
+
+	template<>
+	struct ElementTraits<CoreShaderElement::ShaderElement>
+	{
+		static const size_t index = SHADER_ELEMENT_INDEX;
+		static const bool mainThread = false;
+		static const EngineMemory::MemoryTag memoryTag = EngineMemory::MemoryTag::Shader;
+		static const char* name() { return "Shader"; }
+		static std::vector<std::string> dependencies() { return { "Log" }; }
+		static bool initialize(CoreShaderElement::ShaderElement& element) { return element.initialize(); }
+	};
+
+	template<>
+	struct ElementTraits<CoreResourceElement::ResourceElement>
+	{
+		static const size_t index = RESOURCE_ELEMENT_INDEX;
+		static const bool mainThread = false;
+		static const EngineMemory::MemoryTag memoryTag = EngineMemory::MemoryTag::Resource;
+		static const char* name() { return "Resource"; }
+		//Textures are created through OpenGL, so the Render Element's context must exist first (and outlive the Resource Element)
+		static std::vector<std::string> dependencies() { return { "Log", "Render" }; }
+		static bool initialize(CoreResourceElement::ResourceElement& element) { return element.initialize(); }
+	};
+
+	template<>
+	struct ElementTraits<CoreRenderElement::RenderElement>
+	{
+		static const size_t index = RENDER_ELEMENT_INDEX;
+		//SDL video and the OpenGL context must be created on the thread that renders
+		static const bool mainThread = true;
+		static const EngineMemory::MemoryTag memoryTag = EngineMemory::MemoryTag::Render;
+		static const char* name() { return "Render"; }
+		static std::vector<std::string> dependencies() { return { "Log" }; }
+		static bool initialize(CoreRenderElement::RenderElement& element)
+		{
+			return element.initialize("Sol Engine", 800, 600, (SDL_WindowFlags)(SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI), 0);
+		}
+	};
+
+	template<>
+	struct ElementTraits<CoreGuiElement::GuiElement>
+	{
+		static const size_t index = GUI_ELEMENT_INDEX;
+		//Dear ImGui's backends use the SDL window and the OpenGL context
+		static const bool mainThread = true;
+		static const EngineMemory::MemoryTag memoryTag = EngineMemory::MemoryTag::Gui;
+		static const char* name() { return "Gui"; }
+		static std::vector<std::string> dependencies() { return { "Log", "Render" }; }
+		static bool initialize(CoreGuiElement::GuiElement& element) { return element.initialize(false); }
+	};
+
+	template<>
+	struct ElementTraits<CorePhysicsElement::PhysicsElement>
+	{
+		static const size_t index = PHYSICS_ELEMENT_INDEX;
+		static const bool mainThread = false;
+		static const EngineMemory::MemoryTag memoryTag = EngineMemory::MemoryTag::Physics;
+		static const char* name() { return "Physics"; }
+		static std::vector<std::string> dependencies() { return { "Log" }; }
+		static bool initialize(CorePhysicsElement::PhysicsElement& element) { return element.initialize(); }
+	};
+
+	template<>
+	struct ElementTraits<CoreEventElement::EventElement>
+	{
+		static const size_t index = EVENT_ELEMENT_INDEX;
+		static const bool mainThread = false;
+		static const EngineMemory::MemoryTag memoryTag = EngineMemory::MemoryTag::Event;
+		static const char* name() { return "Event"; }
+		static std::vector<std::string> dependencies() { return { "Log", "Render" }; }
+		static bool initialize(CoreEventElement::EventElement& element) { return element.initialize(); }
+	};
+
+	template<>
+	struct ElementTraits<CoreEcsElement::EcsElement>
+	{
+		static const size_t index = ECS_ELEMENT_INDEX;
+		//The Render System creates its shaders and buffers through OpenGL
+		static const bool mainThread = true;
+		static const EngineMemory::MemoryTag memoryTag = EngineMemory::MemoryTag::Ecs;
+		static const char* name() { return "Ecs"; }
+		//The Systems use all of these Elements
+		static std::vector<std::string> dependencies() { return { "Log", "Render", "Physics", "Event", "Resource", "Shader" }; }
+		static bool initialize(CoreEcsElement::EcsElement& element) { return element.initialize(true, true, true); }
+	};
+
+	template<>
+	struct ElementTraits<CoreSceneElement::SceneElement>
+	{
+		static const size_t index = SCENE_ELEMENT_INDEX;
+		static const bool mainThread = false;
+		static const EngineMemory::MemoryTag memoryTag = EngineMemory::MemoryTag::Scene;
+		static const char* name() { return "Scene"; }
+		static std::vector<std::string> dependencies() { return { "Log", "Ecs", "Physics", "Resource" }; }
+		static bool initialize(CoreSceneElement::SceneElement& element) { return element.initialize(); }
+	};
+}
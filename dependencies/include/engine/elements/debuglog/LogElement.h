@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EngineAPI.h"
+#include "Element.h"
 
 //C++ libraries
 #include <memory>
@@ -15,6 +16,9 @@
 #include <spdlog/sinks/basic_file_sink.h>
 #pragma warning(pop)
 
+//The asynchronous log pipeline, which this Element directs to its log file
+#include "util/Log.h"
+
 //Forward declaration of Core class
 //Essentially, telling compiler Sol::Core exists, but not providing full definition
 //This means pointers to Core class can be used without including Core.h
@@ -26,8 +30,8 @@ namespace Sol {
 namespace CoreLogElement
 {
 	//Represents the element responsible for managing the logging operations in the Sol Engine
-	//Logs will be output to a file
-	class LogElement
+	//Logs will be output to a file, by the log pipeline's background thread (see util/Log.h)
+	class LogElement : public Sol::Element
 	{
 	public:
 		LogElement(std::shared_ptr<Sol::Core> core);
@@ -37,14 +41,16 @@ namespace CoreLogElement
 		//Set flush frequency/level
 		//Create and register logger
 		//Takes custom logfileName e.g. 'Sol-Log.txt'
-		ENGINE_API bool initialize(const std::string& logfileName);
+		//If binary, writes a structured binary log instead, e.g. for long soak runs (decode with EngineLog::decodeBinaryLog, see util/BinaryLog.h)
+		ENGINE_API bool initialize(const std::string& logfileName, bool binary = false);
 
-		//Use logger to log messages (info or error)
+		//Log messages (info or error) through the log pipeline
+		//Prefer the SOL_LOG macros, which format without building a std::string
 		void logInfo(const std::string& msg);
 		void logError(const std::string& msg);
 
-		//Use spdlog's shutdown function on the logger to clean up logger resources
-		void terminate();
+		//Stop the log pipeline's background thread (writing any remaining messages), then use spdlog's shutdown function to clean up logger resources
+		void terminate() override;
 
 	private:
 		//Pointer to core
@@ -145,20 +145,50 @@ struct PhysicsBodyComponent {
         : type(rbType), position(pos), body(rbBody), rotationLock(rotatable) {}
 };
 
+//How a sprite's pixels are combined with what is behind them, which decides the render pass it is drawn in
+enum class SpriteBlendMode {
+    Translucent, //Alpha blended, drawn back to front after every opaque sprite
+    Opaque, //Alpha ignored, drawn front to back writing depth so hidden pixels are rejected before shading
+    AlphaTested //Pixels below half alpha are discarded and the rest drawn as opaque
+};
 //Sprite Component
-//Holds the texture ID to be used by rendering, a texture filepath which is useful when loading/unloading a scene, size and colour, and a shader program ID (currently unusued but useful for the furthering of the Shader Element)
+//Holds the texture ID to be used by rendering, a texture filepath which is useful when loading/unloading a scene, size and colour, and a shader program ID
+//A non-zero shader program (e.g. from the Shader Element) is used to draw the sprite instead of the default program, and must provide the default single draw program's uniforms
+//Sprites are layered by sorting layer and then order in layer, higher values drawn in front, the transform's z isn't used for layering
 struct SpriteComponent {
     unsigned int textureID;
     std::string textureFilePath;  //Path to texture for serialization/deserialization
     glm::vec2 size;
     glm::vec4 color;
     unsigned int shaderProgram;
+    int sortingLayer; //0 to 31
+    int orderInLayer; //-32768 to 32767, orders sprites within a sorting layer
+    SpriteBlendMode blendMode;
 
     SpriteComponent()
-        : textureID(0), textureFilePath(""), size(1.0f), color(1.0f), shaderProgram(0) {}
+        : textureID(0), textureFilePath(""), size(1.0f), color(1.0f), shaderProgram(0),
+        sortingLayer(0), orderInLayer(0), blendMode(SpriteBlendMode::Translucent) {}
 
     SpriteComponent(unsigned int texID, const std::string& filePath, const glm::vec2& spriteSize,
-        const glm::vec4& spriteColor, unsigned int programID)
+        const glm::vec4& spriteColor, unsigned int programID, int layer = 0, int order = 0,
+        SpriteBlendMode blend = SpriteBlendMode::Translucent)
         : textureID(texID), textureFilePath(filePath), size(spriteSize),
-        color(spriteColor), shaderProgram(programID) {}
+        color(spriteColor), shaderProgram(programID), sortingLayer(layer), orderInLayer(order), blendMode(blend) {}
+};
+
+//Camera Component
+//The scene is viewed through the primary camera, which is positioned and rotated by its Entity's TransformComponent (so panning is moving the transform)
+//Holds the zoom, and optionally an Entity for the camera to follow whilst the scene is running
+struct CameraComponent {
+    bool isPrimary; //The Render System views the scene through the primary camera, the one with the lowest Entity if several are primary
+    float zoom; //Greater than 1 zooms in, less than 1 zooms out
+    bool follow; //Whether the camera follows the target Entity
+    std::uint32_t targetEntity; //Entity whose TransformComponent the camera follows
+    float followSpeed; //How quickly the camera closes the distance to its target (per second), 0 keeps it locked to the target
+
+    CameraComponent()
+        : isPrimary(true), zoom(1.0f), follow(false), targetEntity(0), followSpeed(5.0f) {}
+
+    CameraComponent(bool primary, float cameraZoom, bool followTarget, std::uint32_t target, float speed)
+        : isPrimary(primary), zoom(cameraZoom), follow(followTarget), targetEntity(target), followSpeed(speed) {}
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EngineAPI.h"
+#include "Element.h"
 
 //C++ libraries
 #include <unordered_set>
@@ -16,6 +17,8 @@
 #include "physics/PhysicsElement.h"
 #include "event/EventElement.h"
 #include "ecs/Components.h"
+#include "util/Arena.h"
+#include "util/types.h"
 
 //The only usage of global scope, used for project settings primarily
 //However rendering and physics require the main viewport size, and the project path for browsing resources
@@ -38,16 +41,16 @@ namespace CoreEcsElement
     //Represents the Element responsible for managing the Entity-Component-System operations in the Sol Engine
     //This includes Entity and Component management
     //Additionally includes the management and updating of the Systems (both variable delta timestep, and fixed timestep)
-    class EcsElement : public std::enable_shared_from_this<EcsElement> { //Allows the ECS Element to be owned by the Core and by the Systems
+    class EcsElement : public Sol::Element, public std::enable_shared_from_this<EcsElement> { //Allows the ECS Element to be owned by the Core and by the Systems
     public:
         EcsElement(std::shared_ptr<Sol::Core> core);
         ~EcsElement();
 
         ENGINE_API bool initialize(bool renderSys, bool physSys, bool eventSys);
-        void update(double deltaTime);
-        void fixedUpdate(double fixedTimestep);
+        void update(double deltaTime) override;
+        void fixedUpdate(double fixedTimestep) override;
         //Call terminate to deallocate all of the ECS's resources
-        void terminate();
+        void terminate() override;
 
         std::shared_ptr<Sol::Core> getCore();
 
@@ -63,6 +66,8 @@ namespace CoreEcsElement
 
             //Add the Entity and Component pointer to the componentEntityMap
             m_componentEntityMap[componentTypeIndex].push_back({ entity, m_entityComponentMap[entity][componentTypeIndex] });
+            m_dirty = true;
+            m_structureVersion++;
         }
 
         template<typename T>
@@ -75,6 +80,8 @@ namespace CoreEcsElement
             componentEntityList.erase(std::remove_if(componentEntityList.begin(), componentEntityList.end(),
                 [&](const auto& pair) { return pair.first == entity; }),
                 componentEntityList.end());
+            m_dirty = true;
+            m_structureVersion++;
         }
 
         //Return the Component of the specified type associated with the given Entity
@@ -84,6 +91,21 @@ namespace CoreEcsElement
             return *std::static_pointer_cast<T>(m_entityComponentMap[entity][componentTypeIndex]);
         }
 
+        //Return the Component of the specified type associated with the given Entity, or nullptr if it has none
+        //Unlike getComponent, nothing is inserted for a missing Entity or Component
+        template<typename T>
+        T* findComponent(Entity entity) {
+            auto entityIter = m_entityComponentMap.find(entity);
+            if (entityIter == m_entityComponentMap.end()) {
+                return nullptr;
+            }
+            auto componentIter = entityIter->second.find(std::type_index(typeid(T)));
+            if (componentIter == entityIter->second.end()) {
+                return nullptr;
+            }
+            return static_cast<T*>(componentIter->second.get());
+        }
+
         //Return the map of all Components of the specified type
         template <typename T>
         std::unordered_map<Entity, std::shared_ptr<T>> getAllComponentsOfType() {
@@ -96,27 +118,46 @@ namespace CoreEcsElement
 
             return components;
         }
+        //The same, allocating the map from an arena (e.g. the Core's frame or tick arena), for Systems that rebuild it every frame or tick
+        template <typename T>
+        EngineMemory::ArenaUnorderedMap<Entity, std::shared_ptr<T>> getAllComponentsOfType(EngineMemory::LinearArena& arena) {
+            std::type_index componentTypeIndex(typeid(T));
+            const auto& componentEntityList = m_componentEntityMap[componentTypeIndex];
+            EngineMemory::ArenaUnorderedMap<Entity, std::shared_ptr<T>> components(componentEntityList.size(),
+                EngineMemory::ArenaAllocator<std::pair<const Entity, std::shared_ptr<T>>>(arena));
+
+            for (const auto& pair : componentEntityList) {
+                components.emplace(pair.first, std::static_pointer_cast<T>(pair.second));
+            }
+
+            return components;
+        }
 
         //System management functions
         template<typename T, typename... Args>
         void registerSystem(Args&&... args)
         {
-            //Wrap the system in a lambda that casts the generic shared_ptr to the correct type
+            //Wrap the system in lambdas that hold the correctly typed shared_ptr
             //Minor workaround, but both an update and a fixedUpdate function are checked and added for each System
             //However, dependent on the System type, only one function should be populated in the System
             auto system = std::make_shared<T>(std::forward<Args>(args)...);
-            m_systems[std::type_index(typeid(T))] = [system](double deltaTime) {
-                system->update(deltaTime);
-            };
-            m_fixedUpdateSystems[std::type_index(typeid(T))] = [system](double fixedTimestep) {
-                system->fixedUpdate(fixedTimestep);
-            };
+            RegisteredSystem registered;
+            registered.type = std::type_index(typeid(T));
+            registered.name = typeid(T).name();
+            registered.update = [system](double deltaTime) { system->update(deltaTime); };
+            registered.fixedUpdate = [system](double fixedTimestep) { system->fixedUpdate(fixedTimestep); };
+            addSystem(std::move(registered));
         }
 
         void updateSystems(double deltaTime);
         void fixedUpdateSystems(double fixedTimestep);
 
-        void setSceneRunning(bool runningState);
+        ENGINE_API void setSceneRunning(bool runningState);
+        bool isSceneRunning() const { return m_isSceneRunning; }
+        //Whether Entities or Components have been added or removed (or the scene started or stopped) since the last call, used by the Core's idle mode
+        bool consumeDirty() { bool dirty = m_dirty; m_dirty = false; return dirty; }
+        //Incremented whenever Entities or Components are added or removed, so Systems caching Components know when to gather them again
+        u32 getStructureVersion() const { return m_structureVersion; }
         std::unordered_map<Entity, std::unordered_map<std::type_index, std::shared_ptr<void>>> getEntityMap();
         void clear();
 
@@ -160,6 +201,14 @@ namespace CoreEcsElement
         void removeInput(Entity entity) { removeComponent<InputComponent>(entity); }
         InputComponent& getInput(Entity entity) { return getComponent<InputComponent>(entity); }
 
+        //Camera functions using the templated Component management functions
+        void addCamera(Entity entity) {
+            CameraComponent tmp = CameraComponent{};
+            addComponent<CameraComponent>(entity, tmp);
+        }
+        void removeCamera(Entity entity) { removeComponent<CameraComponent>(entity); }
+        CameraComponent& getCamera(Entity entity) { return getComponent<CameraComponent>(entity); }
+
     private:
         //Pointer to Core
         std::weak_ptr<Sol::Core> m_core;
@@ -172,15 +221,30 @@ namespace CoreEcsElement
         //An unordered map such that the key is the Component type, the value is a vector
         //This vector holds pairs such that the key of the pair is the Entity and the value is the pointer to the Component of the type held by the key of the unordered map
         std::unordered_map<std::type_index, std::vector<std::pair<Entity, std::shared_ptr<void>>>> m_componentEntityMap;
-        //Stores an unordered map such that the key is the type of the System, and the value is the update function (with parameter delta timestep) held by the System of that type
-        std::unordered_map<std::type_index, std::function<void(double)>> m_systems;
-        //Stores an unordered map such that the key is the type of the System, and the value is the update function (with parameter fixed timestep) held by the System of that type
-        std::unordered_map<std::type_index, std::function<void(double)>> m_fixedUpdateSystems;
+        //A registered System's update functions
+        //The name is used for profiler zones and the per-System costs shown in the Performance viewport
+        struct RegisteredSystem
+        {
+            std::type_index type = std::type_index(typeid(void));
+            const char* name = nullptr;
+            std::size_t metricsIndex = 0;
+            std::function<void(double)> update; //Update function with parameter delta timestep
+            std::function<void(double)> fixedUpdate; //Update function with parameter fixed timestep
+        };
+        //Add a System, or replace the System of the same type, and register it with the Core's Metrics
+        void addSystem(RegisteredSystem system);
+        //Stores the registered Systems in registration order, which is also the order they are updated in
+        std::vector<RegisteredSystem> m_systems;
 
         //Entity ID management, starting at 0
         Entity m_entityID = 0;
 
         //The running state of the scene and therefore the fixed update state of the ECS
         bool m_isSceneRunning = true;
+
+        //Set by any modification of the ECS's data structures, cleared by consumeDirty
+        bool m_dirty = false;
+        //Incremented by any addition or removal of Entities or Components, never reset
+        u32 m_structureVersion = 0;
     };
 }
\ No newline at end of file
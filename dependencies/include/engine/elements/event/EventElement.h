@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EngineAPI.h"
+#include "Element.h"
 
 //C++ libraries
 #include <memory>
@@ -12,6 +13,7 @@
 #include <imgui_impl_sdl2.h>
 
 #include "ecs/Components.h"
+#include "util/Arena.h"
 
 //Forward declaration of Core class
 //This tells compiler Sol::Core exists without providing full definition
@@ -26,9 +28,12 @@ using Entity = std::uint32_t;
 
 namespace CoreEventElement
 {
+	//The actions each Entity's Input Component maps the current input to, built by the Event System in the Core's tick arena every tick
+	using ActionsPerEntity = EngineMemory::ArenaUnorderedMap<Entity, EngineMemory::ArenaVector<ActionData>>;
+
 	//Represents the Element responsible for managing the Event operations in the Sol Engine
 	//Primarily keyboard/mouse input
-	class EventElement
+	class EventElement : public Sol::Element
 	{
 	public:
 		EventElement(std::shared_ptr<Sol::Core> core);
@@ -45,27 +50,35 @@ namespace CoreEventElement
 		//Process events
 		void processEvent(const SDL_Event& event);
 
+		//Add input events directly, bypassing ImGui, used by the Core to feed back replayed input
+		//Replayed events must not depend on the state of the Editor's GUI, otherwise replays would not be deterministic
+		void injectInputEvents(const std::vector<SDL_Event>& events);
+
+		//Signal the Core to quit, as if the window had been closed
+		void requestQuit();
+
 		//Get all input events
-		std::vector<SDL_Event> getInputEvents();
+		const std::vector<SDL_Event>& getInputEvents() const;
 
+		//Called by the Core at the end of every fixed timestep tick, also clearing the tick's actions before the tick arena is reset
 		void resetInputEvents();
 
 		//For use by the Physics System so forces/impulses/torques can be applied by key input
-		void setActionsForPhysics(const std::unordered_map<Entity, std::vector<ActionData>>& actionsPerEntity);
-		const std::unordered_map<Entity, std::vector<ActionData>>& getActionsForPhysics() const;
+		//The actions are allocated from the Core's tick arena, so are only valid until the end of the tick (nullptr if none were set this tick)
+		void setActionsForPhysics(const ActionsPerEntity* actionsPerEntity);
+		const ActionsPerEntity* getActionsForPhysics() const;
 
 		//Call terminate to deallocate any of Event Element's resources
-		void terminate();
+		void terminate() override;
 
 	private:
 		//Pointer to Core
 		std::weak_ptr<Sol::Core> m_core;
 		//Is LogElement present
-		bool m_logElementAttached{ false };
 		//Used by the Core to determine whether or not any SDL/ImGui quit events have been detected, and if so then the application cleanly quits
 		bool m_running;
 		//For use to determine and send any events required in-scene
 		std::vector<SDL_Event> m_inputEvents;
-		std::unordered_map<Entity, std::vector<ActionData>> m_actionsForPhysics;
+		const ActionsPerEntity* m_actionsForPhysics = nullptr;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#pragma warning(push)
+#pragma warning(disable: 26495) //Disable numerous Box2D warnings - warnings considered, Box2D fully functional and trusted, no need for these warnings
+
+//External library Box2D
+#include <Box2D/Box2D.h>
+#pragma warning(pop)
+
+#include "util/DebugDraw.h"
+
+namespace CorePhysicsElement
+{
+	//Box2D's debug drawing interface, forwarding everything Box2D draws into the Engine's batched debug draw
+	//Box2D works in metres about the centre of the screen, so every position is converted to pixels the same way the Physics System converts bodies' positions
+	//Solid shapes are drawn as outlines, since the debug draw only draws lines
+	class PhysicsDebugDraw : public b2Draw
+	{
+	public:
+		PhysicsDebugDraw(EngineDebugDraw::DebugDraw& debugDraw, float scalingFactor);
+
+		void DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color) override;
+		void DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color) override;
+		void DrawCircle(const b2Vec2& center, float radius, const b2Color& color) override;
+		void DrawSolidCircle(const b2Vec2& center, float radius, const b2Vec2& axis, const b2Color& color) override;
+		void DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color) override;
+		void DrawTransform(const b2Transform& xf) override;
+		void DrawPoint(const b2Vec2& p, float size, const b2Color& color) override;
+
+		//Convert a position in metres to pixels
+		glm::vec2 toPixels(const b2Vec2& position) const;
+
+	private:
+		//Convert a Box2D color to RGBA8
+		static u32 toColor(const b2Color& color);
+
+		EngineDebugDraw::DebugDraw& m_debugDraw;
+		float m_scalingFactor;
+		glm::vec2 m_offset;
+	};
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EngineAPI.h"
+#include "Element.h"
 
 #pragma warning(push)
 #pragma warning(disable: 26495) //Disable numerous Box2D warnings - warnings considered, Box2D fully functional and trusted, no need for these warnings
@@ -13,6 +14,8 @@
 #include <Box2D/Box2D.h>
 #pragma warning(pop)
 
+#include "util/DebugDraw.h"
+
 //Forward declaration of Core class
 //Essentially, telling compiler Sol::Core exists, but not providing full definition
 //This means pointers to Core class can be used without including Core.h
@@ -24,7 +27,7 @@ namespace Sol {
 namespace CorePhysicsElement
 {
 	//Represents the Element responsible for managing the physics (including collision detection and resolution, and force/impulse/torque applications) in the Sol Engine
-	class PhysicsElement
+	class PhysicsElement : public Sol::Element
 	{
 	public:
 		PhysicsElement(std::shared_ptr<Sol::Core> core);
@@ -33,7 +36,7 @@ namespace CorePhysicsElement
 		ENGINE_API bool initialize();
 
 		//Resources for physics managed by Box2D, but world cleared and pointer to world set to nullptr to be safe
-		void terminate();
+		void terminate() override;
 
 		//Return a pointer to the Box2D world managed by the PhysicsElement/PhysicsSystem
 		std::shared_ptr<b2World> getWorld() const;
@@ -41,11 +44,14 @@ namespace CorePhysicsElement
 		//Clear this world by removing all bodies and resetting the world
 		void clearWorld();
 
+		//Draw the world into the debug draw, as enabled by its DRAW_PHYSICS flags, converting metres to pixels by scalingFactor
+		//Shapes, joints, bounds and centres of mass are drawn by Box2D itself, through a PhysicsDebugDraw
+		ENGINE_API void drawDebug(EngineDebugDraw::DebugDraw& debugDraw, float scalingFactor);
+
 	private:
 		//Pointer to core
 		std::weak_ptr<Sol::Core> m_core;
 		//Is LogElement present
-		bool m_logElementAttached{ false };
 		//Physics world
 		std::shared_ptr<b2World> m_world;
 	};
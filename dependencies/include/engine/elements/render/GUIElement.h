@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EngineAPI.h"
+#include "Element.h"
 
 //C++ libraries
 #include <memory>
@@ -36,18 +37,24 @@ using Entity = std::uint32_t;
 namespace CoreGuiElement
 {
 	//Represents the Element responsible for managing the GUI operations in the Sol Engine and Editor
-	class GuiElement
+	class GuiElement : public Sol::Element
 	{
 	public:
 		GuiElement(std::shared_ptr<Sol::Core> core);
 		~GuiElement();
 
 		ENGINE_API bool initialize(bool debug);
+		//Build the Dear ImGui font atlas, which needs neither the OpenGL context nor the Dear ImGui context, so it can be built on a worker thread
+		bool prepare() override;
 
-		void update(double deltaTime);
+		void update(double deltaTime) override;
+
+		//Whether Dear ImGui has an interaction in progress (e.g. a held mouse button, an active widget, or text input)
+		//that needs frames to keep coming even without new input, used by the Core's idle mode
+		bool isInteracting() const;
 
 		//Call terminate to deallocate any of GUI Element's resources
-		void terminate();
+		void terminate() override;
 
 		//Popup window upon starting the Editor
 		void startUpDialog();
@@ -63,11 +70,17 @@ namespace CoreGuiElement
 		void handleLoadScenePopup();
 		void handleSaveScenePopup();
 		void handleProjectSettingsPopup();
+		//Save the Profiler's recorded zones as a Chrome/Perfetto trace, optionally only the last few seconds
+		void saveProfilerTrace(double lastSeconds);
 		//All other viewports to be handled by editorViewports, all dockable inside the main dockable viewport
 		void sceneHierarchyViewport();
 		void renderSceneHierarchy();
 		void inspectorViewport();
 		void resourceBrowserViewport();
+		//Live performance metrics recorded by the Core, the ECS Element, and the Systems
+		void performanceViewport();
+		//The game view, rendered by the Render Element at its internal resolution
+		void gameViewport();
 		//Auxiliary functions to be used primarily by the resource browser to view directories and files by directory
 		void displayDirectories();
 		void displayFilesInDirectory();
@@ -76,7 +89,6 @@ namespace CoreGuiElement
 		//Pointer to Core
 		std::weak_ptr<Sol::Core> m_core;
 		//Is LogElement present
-		bool m_logElementAttached{ false };
 
 		//Booleans to manage whether a popup should be visible or not
 		bool m_openNewScenePopup = false;
@@ -97,5 +109,8 @@ namespace CoreGuiElement
 
 		//If the application is in debug mode, i.e. the Editor should be visible not just a current loaded scene
 		bool m_debugMode;
+
+		//Font atlas built by prepare and shared with the Dear ImGui context, which does not take ownership of it
+		std::unique_ptr<ImFontAtlas> m_fontAtlas;
 	};
 }
\ No newline at end of file
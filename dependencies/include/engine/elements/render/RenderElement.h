@@ -1,19 +1,28 @@
 #pragma once
 
 #include "EngineAPI.h"
+#include "Element.h"
 
 #pragma warning(push)
 #pragma warning(disable: 4018)
 
 //C++ libraries
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 //External libraries GLAD and SDL2
 #include <glad.h>
 #include <SDL.h>
 #pragma warning(pop)
 
+#include "util/GpuTimer.h"
+
 //Forward declaration of Core class
 //Essentially, telling compiler Sol::Core exists, but not providing full definition
 //This means pointers to Core class can be used without including Core.h
@@ -24,9 +33,21 @@ namespace Sol {
 
 namespace CoreRenderElement
 {
+	//What the game view was last rendered at, for presenting it and for display in the Editor
+	struct GameViewInfo
+	{
+		GLuint texture = 0; //Color texture the game view is rendered into, 0 if the game view couldn't be created
+		int width = 0; //Internal resolution rendered at, a region of the texture from its origin
+		int height = 0;
+		float u = 1.0f; //Fraction of the texture's width and height the region covers
+		float v = 1.0f;
+		float resolutionScale = 1.0f; //Internal resolution as a fraction of the screen size, the render scale lowered by dynamic resolution
+		float gpuFrameMs = 0.0f; //GPU time of the latest game view's sprite pass whose timing has been read back, a few frames old
+	};
+
 	//Represents the Element responsible for managing the rendering operations in the Sol Engine
 	//This includes SDL window management and OpenGL context management
-	class RenderElement
+	class RenderElement : public Sol::Element
 	{
 	public:
 		RenderElement(std::shared_ptr<Sol::Core> core);
@@ -37,6 +58,51 @@ namespace CoreRenderElement
 
 		//Clear the screen, useful as otherwise OpenGL will render the next frame over the last
 		void clearScreen();
+
+		//The scene is rendered into the game view, an offscreen framebuffer at an internal resolution that may be lower than the screen's
+		//It is then upscaled to the window, or shown in the Editor's Game window instead
+		//Bind and clear the game view, resizing it if the screen size or render scale changed, call before anything in the scene is rendered
+		//Does nothing with the render thread, which begins the game view itself
+		void beginGameView();
+		//Finish the game view, present it to the window unless setPresentGameView(false) was called, and leave the window's framebuffer bound and cleared for the GUI
+		//With the render thread, waits for it to finish the last frame's game view and presents that instead
+		void endGameView();
+		//Whether endGameView upscales the game view to the window, the Editor presents it in its Game window instead
+		ENGINE_API void setPresentGameView(bool present);
+		ENGINE_API const GameViewInfo& getGameView() const;
+
+		//Internal resolution as a fraction of the screen size (Config's screenWidth and screenHeight), from MIN_RENDER_SCALE to 1
+		ENGINE_API void setRenderScale(float scale);
+		ENGINE_API float getRenderScale() const;
+		//Dynamic resolution lowers the internal resolution below the render scale whilst the GPU takes longer than the target to draw the game view's sprites
+		//and raises it back once there is headroom, so weak machines trade resolution for frame rate
+		ENGINE_API void setDynamicResolution(bool enabled);
+		ENGINE_API bool isDynamicResolutionEnabled() const;
+		ENGINE_API void setTargetGpuFrameMs(float targetMs);
+		ENGINE_API float getTargetGpuFrameMs() const;
+
+		//Lowest render scale, and lowest fraction of the render scale dynamic resolution goes down to
+		static constexpr float MIN_RENDER_SCALE = 0.25f;
+		static constexpr float MIN_DYNAMIC_SCALE = 0.5f;
+
+		//The render thread renders the game view from what the main thread submitted for it, whilst the main thread simulates and records the next frame
+		//The OpenGL context moves to the render thread once a frame's buffers are swapped, and back to the main thread when it is needed there
+		//so the game view is presented a frame after it was recorded
+		//Off by default, changes take effect at the end of the frame
+		ENGINE_API void setRenderThreadEnabled(bool enabled);
+		ENGINE_API bool isRenderThreadEnabled() const;
+		//Render the game view with job, straight away without the render thread, otherwise on the render thread once this frame's buffers are swapped
+		//With the render thread the main thread moves on whilst job runs, so job must only use what nothing else modifies until it has finished
+		void submitGameView(std::function<void()> job);
+		//Wait for the render thread to finish and make the OpenGL context current on the main thread
+		//Call before using OpenGL on the main thread between the end of a frame and endGameView, see Core::acquireGLContext
+		ENGINE_API void acquireContext();
+		//Drop any game view submitted this frame rather than rendering it, and acquire the context, for when what it renders is being destroyed
+		void discardGameView();
+		
+		//Times the game view, sprite, debug line, and GUI passes on the GPU, only use whilst the OpenGL context is current apart from getLatestMs
+		//A frame of timings begins with each game view
+		EngineMetrics::GpuTimer& getGpuTimer() { return m_gpuTimer; }
 		
 		//Swap frame buffers, useful as OpenGL renders the next frame in the background while displaying the current frame, swap to make this next frame visible
 		void swapBuffers();
@@ -45,7 +111,7 @@ namespace CoreRenderElement
 		void setWindowSize(float width, float height);
 
 		//Terminate Render Element by destroying the SDL window and the OpenGL context
-		void terminate();
+		void terminate() override;
 
 		//Return a pointer to the SDL window instance managed by the Render Element
 		SDL_Window* getWindow() const;
@@ -56,10 +122,59 @@ namespace CoreRenderElement
 		//Pointer to Core
 		std::weak_ptr<Sol::Core> m_core;
 		//Is LogElement present
-		bool m_logElementAttached{ false };
 		//A pointer to the SDL window instanced managed by the Render Element
 		SDL_Window* m_sdlWindow;
 		//An OpenGL context handle managed by the Render Element
 		SDL_GLContext m_glContext;
+
+		//The game view's framebuffer, with a color texture and a depth and stencil renderbuffer
+		//Sized for the render scale, dynamic resolution only renders to a smaller region of it so lowering the resolution never reallocates
+		GLuint m_gameFramebuffer = 0;
+		GLuint m_gameColorTexture = 0;
+		GLuint m_gameDepthStencil = 0;
+		int m_gameTextureWidth = 0;
+		int m_gameTextureHeight = 0;
+		GameViewInfo m_gameView;
+		bool m_presentGameView = true;
+		//(Re)create the game view's attachments, returning false (and leaving the scene to render to the window) if the framebuffer is incomplete
+		bool createGameView(int width, int height);
+		void destroyGameView();
+
+		//Set from the main thread and read when the game view is started, possibly on the render thread
+		std::atomic<float> m_renderScale{ 1.0f };
+		std::atomic<bool> m_dynamicResolution{ false };
+		std::atomic<float> m_targetGpuFrameMs{ 12.0f };
+		//Fraction of the render scale currently rendered at, only below 1 with dynamic resolution
+		float m_dynamicScale = 1.0f;
+		//Adjust the dynamic scale for a game view rendered at renderedScale whose sprite pass took gpuMs on the GPU
+		void updateDynamicResolution(float gpuMs, float renderedScale);
+
+		//Begin the game view and its frame of GPU timings, and present it, split so the render thread does the first and the main thread the second
+		void startGameView();
+		void presentGameView();
+
+		//Per-pass GPU timings, each frame is tagged with the dynamic scale its game view was rendered at
+		EngineMetrics::GpuTimer m_gpuTimer;
+
+		//Render thread, see setRenderThreadEnabled
+		std::thread m_renderThread;
+		std::mutex m_renderMutex;
+		std::condition_variable m_renderCondition;
+		//Jobs submitted this frame, handed to the render thread once the buffers are swapped (main thread only)
+		std::vector<std::function<void()>> m_pendingJobs;
+		//Jobs handed to the render thread, only touched by the main thread whilst none are in flight
+		std::vector<std::function<void()>> m_renderJobs;
+		//Guarded by m_renderMutex
+		bool m_renderJobsInFlight = false;
+		bool m_stopRenderThread = false;
+		//Main thread only
+		bool m_renderThreadRequested = false;
+		bool m_renderThreadRunning = false;
+		bool m_contextOnRenderThread = false;
+		void renderThreadLoop();
+		//Start or stop the render thread to match m_renderThreadRequested, called at the end of a frame
+		void applyRenderThreadSetting();
+		//Hand this frame's jobs and the OpenGL context to the render thread
+		void dispatchGameView();
 	};
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EngineAPI.h"
+#include "Element.h"
 
 //C++ libraries
 #include <memory>
@@ -10,6 +11,8 @@
 //External library GLAD
 #include <glad.h>
 
+#include "resource/TextureAtlas.h"
+
 //The main resource currently being used is Texture Resource for sprite rendering
 
 //Forward declaration of Core class
@@ -58,7 +61,7 @@ struct ShaderResource : public Resource {
 namespace CoreResourceElement
 {
 	//Represents the Element responsible for managing the Resource operations in the Sol Engine
-	class ResourceElement
+	class ResourceElement : public Sol::Element
 	{
 	public:
 		ResourceElement(std::shared_ptr<Sol::Core> core);
@@ -82,17 +85,25 @@ namespace CoreResourceElement
 		//Clear resource cache, clear the entire resource cache and release all resources
 		void clearCache();
 
+		//Estimated GPU memory used by all cached textures in bytes, including their mipmap chains
+		size_t getTextureMemoryBytes() const;
+		//Number of cached textures
+		size_t getTextureCount() const;
+
+		//Atlas every sufficiently small loaded texture is also packed into, so the Render System can batch sprites with different textures
+		const TextureAtlas& getTextureAtlas() const { return m_textureAtlas; }
+
 		ENGINE_API bool initialize();
 
 		//Call terminate to deallocate any of Resource Element's resources
-		void terminate();
+		void terminate() override;
 
 	private:
 		//Pointer to Core
 		std::weak_ptr<Sol::Core> m_core;
 		//Is LogElement present
-		bool m_logElementAttached{ false };
 		//Resource cache where the string associated with the resource is the key and the shared pointer to the resource is the value
 		std::unordered_map<std::string, std::shared_ptr<Resource>> m_resourceCache;
+		TextureAtlas m_textureAtlas;
 	};
 } 
\ No newline at end of file
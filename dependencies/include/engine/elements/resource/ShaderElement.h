@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EngineAPI.h"
+#include "Element.h"
 
 //C++ libraries
 #include <memory>
@@ -24,7 +25,7 @@ namespace CoreShaderElement
 {
 	//Represents the element responsible for managing the Shader creation operation in the Sol Engine
 	//More of a utility class than an Element, however its functionality may be expanded in the future
-	class ShaderElement
+	class ShaderElement : public Sol::Element
 	{
 	public:
 		ShaderElement(std::shared_ptr<Sol::Core> core);
@@ -32,19 +33,15 @@ namespace CoreShaderElement
 
 		ENGINE_API bool initialize();
 
-		//Returns program ID of Vert-Frag Shader program
+		//Returns program ID of Vert-Frag Shader program, created through the Core's render device
+		//Throws if the files can't be read or the program can't be compiled and linked
 		unsigned int createShaderProgram(const std::string& vertexPath, const std::string& fragmentPath);
 
-		//Auxilliary functions to check any shader compilation or linking errors
-		void checkShaderCompilationErrors(unsigned int shader, const std::string& type);
-		void checkProgramLinkErrors(unsigned int program);
-
 		//No terminate function since Shader Element is more of a utility class and has no particular resources of its own
 
 	private:
 		//Pointer to Core
 		std::weak_ptr<Sol::Core> m_core;
 		//Is LogElement present
-		bool m_logElementAttached{ false };
 	};
 }
\ No newline at end of file
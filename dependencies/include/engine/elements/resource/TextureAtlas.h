@@ -0,0 +1,98 @@
+#pragma once
+
+//C++ libraries
+#include <unordered_map>
+#include <vector>
+
+#include "util/types.h"
+
+namespace EcsRenderSystem
+{
+	class RenderDevice;
+}
+
+//Packs small textures into shared atlas pages so that sprites with different textures can be drawn by the same instanced draw call
+//Every texture the Resource Element loads that is small enough is also copied into a page (the original texture is kept, e.g. for the Editor's previews)
+//Pages are packed with a skyline (bottom-left) packer, and each packed texture gets a UV rect in a table shared by every page
+//Rect 0 is always the whole texture, used by textures that are not in the atlas
+namespace CoreResourceElement
+{
+	//UV rect of a texture within its atlas page
+	struct AtlasRect
+	{
+		float u0, v0, u1, v1;
+	};
+
+	//Where a texture was packed
+	struct AtlasRegion
+	{
+		u32 pageTexture; //Render device texture of the page the texture was packed into
+		u16 rectIndex; //Index of the texture's UV rect in getRects()
+	};
+
+	class TextureAtlas
+	{
+	public:
+		//Size of each (square) page in texels
+		static const int PAGE_SIZE = 2048;
+		//Textures larger than this in either dimension are never packed
+		static const int MAX_PACKED_SIZE = 512;
+		//Most pages the atlas will create, textures that don't fit in any page are not packed
+		static const int MAX_PAGES = 4;
+		//Transparent texels left around every packed texture, so filtering (down to the last mip level) never samples a neighbour
+		static const int PADDING = 4;
+
+		TextureAtlas();
+		~TextureAtlas();
+
+		//Pack a texture's pixels (as loaded, with 3 or 4 channels) into a page created and updated through device, on the thread the device is used from
+		//Returns false if the texture is too large or there is no room, in which case it is simply drawn from its own texture
+		bool add(EcsRenderSystem::RenderDevice& device, u32 textureID, const unsigned char* pixels, int width, int height, int channels);
+		//Forget a texture, its space is reclaimed only when the atlas is cleared
+		void remove(u32 textureID);
+		//Delete every page through the device they were created through
+		void clear(EcsRenderSystem::RenderDevice& device);
+
+		//Where a texture was packed, or nullptr if it is not in the atlas
+		const AtlasRegion* find(u32 textureID) const
+		{
+			auto it = m_regions.find(textureID);
+			return it != m_regions.end() ? &it->second : nullptr;
+		}
+
+		//Every UV rect, indexed by AtlasRegion::rectIndex
+		const std::vector<AtlasRect>& getRects() const { return m_rects; }
+		//Incremented whenever the rects change, so renderers know when to upload them again
+		u32 getVersion() const { return m_version; }
+
+		size_t getPageCount() const { return m_pages.size(); }
+		size_t getPackedCount() const { return m_regions.size(); }
+
+	private:
+		//Top edge of the packed area over a horizontal span of the page
+		struct SkylineNode
+		{
+			int x, y, width;
+		};
+
+		struct Page
+		{
+			u32 texture = 0;
+			std::vector<SkylineNode> skyline;
+		};
+
+		//Find the lowest (then narrowest) position for a width x height rectangle, returns the skyline node it starts at or -1
+		static int findPosition(const Page& page, int width, int height, int& x, int& y);
+		//Lowest y a width x height rectangle can be placed at starting at skyline node index, or -1 if it doesn't fit there
+		static int fitAt(const Page& page, size_t index, int width, int height);
+		//Raise the skyline over a newly placed rectangle
+		static void placeAt(Page& page, size_t index, int x, int y, int width, int height);
+
+		static u32 createPageTexture(EcsRenderSystem::RenderDevice& device);
+
+		std::vector<Page> m_pages;
+		std::unordered_map<u32, AtlasRegion> m_regions;
+		std::vector<AtlasRect> m_rects;
+		u32 m_version = 0;
+	};
+}
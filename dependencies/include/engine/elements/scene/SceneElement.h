@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EngineAPI.h"
+#include "Element.h"
 
 #pragma warning(push)
 #pragma warning(disable: 6001 28020 26495) //Disable numerous JSON for Modern C++ warnings - warnings considered, JSON for Modern C++ fully functional and trusted, no need for these warnings
@@ -13,6 +14,7 @@
 #include <vector>
 
 #include "ecs/Components.h"
+#include "util/types.h"
 
 //External library JSON for Modern C++
 #include <nlohmann/json.hpp>
@@ -34,7 +36,7 @@ namespace CoreSceneElement
 {
 	//Represents the Element responsible for managing the scene operations in the Sol Engine
 	//This includes serialisation/deserialisation, scene loading/unloading, and scene ordering
-	class SceneElement
+	class SceneElement : public Sol::Element
 	{
 	public:
 		SceneElement(std::shared_ptr<Sol::Core> core);
@@ -57,16 +59,22 @@ namespace CoreSceneElement
 			return m_currentScene;
 		}
 
+		//Number of times a scene has been loaded, used by the Core to detect scene (re)loads whilst recording input
+		u32 getLoadCount() const
+		{
+			return m_loadCount;
+		}
+
 		//Terminate SceneElement
-		void terminate();
+		void terminate() override;
 
 	private:
 		//Pointer to core
 		std::weak_ptr<Sol::Core> m_core;
 		//Is LogElement present
-		bool m_logElementAttached{ false };
 
 		std::string m_currentScene; //Current loaded scene in the Editor
+		u32 m_loadCount = 0;
 
 		//Helper functions for serialisation of components
 		json serializeTransform(const TransformComponent& component);
@@ -74,6 +82,7 @@ namespace CoreSceneElement
 		json serializeCollider(const ColliderComponent& component);
 		json serializePhysicsBody(const PhysicsBodyComponent& component);
 		json serializeSprite(const SpriteComponent& component);
+		json serializeCamera(const CameraComponent& component);
 
 		//Helper functions for deserialisation of components
 		TransformComponent deserializeTransform(const json& j);
@@ -81,5 +90,6 @@ namespace CoreSceneElement
 		ColliderComponent deserializeCollider(const json& j);
 		PhysicsBodyComponent deserializePhysicsBody(const json& j);
 		SpriteComponent deserializeSprite(const json& j);
+		CameraComponent deserializeCamera(const json& j);
 	};
 }
\ No newline at end of file
@@ -38,7 +38,5 @@ namespace EcsEventSystem
 
     private:
         std::shared_ptr<CoreEcsElement::EcsElement> m_ecsElement; //Shared pointer of the ECS Element to allow the Event System to manage the ECS's lifetime otherwise the ECS may terminate before the events are finished
-
-        std::vector<SDL_Event> m_inputEvents; //All events currently being input by the user
     };
 }
\ No newline at end of file
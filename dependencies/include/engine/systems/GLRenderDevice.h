@@ -0,0 +1,157 @@
+#pragma once
+
+//C++ libraries
+#include <unordered_map>
+#include <vector>
+
+//External libraries GLAD and GLM
+#include <glad.h>
+#include <glm/glm.hpp>
+
+#include "util/DebugDraw.h"
+#include "util/GpuTimer.h"
+#include "systems/RenderDevice.h"
+#include "systems/InstanceRingBuffer.h"
+#include "systems/SpriteDraw.h"
+#include "systems/GLStateCache.h"
+#include "resource/TextureAtlas.h"
+
+//The OpenGL 3.3 device, created by the Render Element once its context exists and destroyed before the context is
+//Owns the sprite and debug line programs and buffers, and replays command lists with them
+//Every method requires the OpenGL context to be current on the calling thread
+namespace EcsRenderSystem
+{
+    class GLRenderDevice : public RenderDevice
+    {
+    public:
+        //The sprite and debug line passes of every command list are timed with gpuTimer, if given
+        GLRenderDevice(EngineMetrics::GpuTimer* gpuTimer = nullptr);
+        ~GLRenderDevice();
+
+        u32 createTexture(int width, int height, int channels, const unsigned char* pixels, int maxMipLevel) override;
+        void updateTexture(u32 texture, int x, int y, int width, int height, int channels, const unsigned char* pixels) override;
+        void deleteTexture(u32 texture) override;
+
+        u32 createProgram(const char* vertexSource, const char* fragmentSource) override;
+        void deleteProgram(u32 program) override;
+
+        void execute(RenderCommandList& commands) override;
+        void discardRetained() override;
+
+        const char* getName() const override { return "OpenGL"; }
+
+        //Look up a uniform's location, logging a warning if the program has no such active uniform
+        static GLint getUniformLocation(GLuint program, const char* name);
+        //Bind a program's uniform block to a binding point, logging a warning if the program has no such block
+        static void bindUniformBlock(GLuint program, const char* name, GLuint bindingPoint);
+
+        //The model matrix the instanced vertex shader builds from an instance, for drawing the sprite singly
+        static glm::mat4 unpackModelMatrix(const SpriteInstance& instance);
+        //The z a depth rank is drawn at, in the projection's [-1, 1] with greater ranks nearer
+        static float depthRankToZ(u32 depthRank);
+
+    private:
+        //Compile one stage of a program, returning 0 (having logged why) if it doesn't compile
+        static GLuint compileShader(GLenum type, const char* source);
+
+        //Draw a batch of a static sprite chunk from the chunk's own buffer, with one instanced call
+        void drawStaticBatch(u32 chunk, u32 first, u32 count);
+        //Set the blend and depth state and the alpha cutoff for a render pass's sprites
+        void beginPass(u32 pass);
+
+        //Single drawing will be used if the number of sprites to be rendered with the same texture is less than the minimum number of sprites required to make batch (instanced) rendering worthwile
+        //It is also used for every sprite with its own shader program
+        void singleDraw(GLuint program, u32 first, u32 count);
+        //Multi drawing is in essence batch (instanced) rendering, so renders all sprites with the same texture in one draw call if there are enough sprites to make this worthwhile
+        void multiDraw(u32 first, u32 count);
+        //Draw debug lines with one draw call, over everything drawn before them
+        void drawDebugLines(const EngineDebugDraw::DebugVertex* vertices, size_t vertexCount);
+
+        //VAO for managing VBOs
+        //VBO as data container for vertex or instance attributes
+        //EBO for indices to process vertices
+
+        //Main VAO and quad VBO/EBO
+        unsigned int m_mainVAO = 0;
+        unsigned int m_quadVBO = 0;
+        unsigned int m_quadEBO = 0;
+
+        //Streams the sprite instances to the GPU, each instanced batch draws from its offset into the chunk of instances holding it
+        //A frame's instances are normally one chunk, written by the first instanced batch, frames larger than the buffer's largest region take several
+        InstanceRingBuffer m_instanceBuffer;
+        //The command list's streamed sprite instances, in the order the sprites are drawn
+        const SpriteInstance* m_streamedInstances = nullptr;
+        size_t m_streamedInstanceCount = 0;
+        //The chunk of the streamed instances last written to the instance buffer, its first instance, number of instances, and byte offset
+        size_t m_instanceChunkFirst = 0;
+        size_t m_instanceChunkCount = 0;
+        GLintptr m_instanceChunkOffset = -1;
+        //Write the chunk of instances starting at first, as many as fit in a region, returning false if they couldn't be written
+        bool writeInstanceChunk(size_t first);
+        //Point the instance attributes of the main VAO (which must be bound) at the sprite instances starting at offset in buffer
+        void setInstanceAttributes(GLuint buffer, GLintptr offset);
+        //Upload a range of a command list's data to its target
+        void uploadRange(const RenderCommandList& commands, const UploadRangeCommand& upload);
+
+        //Each static sprite chunk's buffer, by chunk index, 0 if the chunk has none
+        std::vector<GLuint> m_staticChunkBuffers;
+
+        //Texture buffer of the atlas's UV rects, read by the instanced vertex shader, and a copy of them for singly drawn sprites
+        unsigned int m_uvRectBuffer = 0;
+        unsigned int m_uvRectTexture = 0;
+        std::vector<CoreResourceElement::AtlasRect> m_uvRects;
+
+        //Program, VAO, and VBO for the debug draw's lines, the VBO is filled again every frame with the frame's lines
+        unsigned int m_debugLineShaderID = 0;
+        unsigned int m_debugLineVAO = 0;
+        unsigned int m_debugLineVBO = 0;
+
+        //Shader program ID's for default rendering of a sprite
+        //One for if the draw call is per sprite, one for if the draw call is for a batch to be drawn via instancing
+        unsigned int m_defaultShaderID = 0;
+        unsigned int m_defaultInstanceShaderID = 0;
+
+        //Uniform locations of the single draw program, resolved once after it is linked
+        struct SingleDrawUniforms
+        {
+            GLint modelMatrix = -1;
+            GLint spriteColor = -1;
+            GLint uvRect = -1;
+            GLint alphaCutoff = -1;
+            float alphaCutoffValue = 0.0f; //Value last set, uniforms start at 0 when a program is linked
+        };
+        SingleDrawUniforms m_singleDrawUniforms;
+        //The instanced program's alpha cutoff uniform, and the value last set
+        GLint m_instanceAlphaCutoff = -1;
+        float m_instanceAlphaCutoffValue = 0.0f;
+
+        //Alpha below which the alpha tested pass discards pixels
+        const float m_ALPHA_TEST_CUTOFF = 0.5f;
+        //This pass's alpha cutoff, 0 discards nothing
+        float m_alphaCutoff = 0.0f;
+        //Program single draws use, 0 for the default single draw program
+        GLuint m_pipelineProgram = 0;
+        //Set a program's alpha cutoff uniform to this pass's if the value last set differs, the program must be in use
+        void applyAlphaCutoff(GLint location, float& value);
+
+        //A sprite's own shader program (SpriteComponent::shaderProgram) has its uniform locations resolved when it is first drawn, and forgotten when it is deleted
+        std::unordered_map<GLuint, SingleDrawUniforms> m_customProgramUniforms;
+        SingleDrawUniforms& getCustomProgramUniforms(GLuint program);
+
+        //Binding point of the Camera uniform block, which holds the view and projection matrices shared by both programs
+        static const GLuint CAMERA_BINDING = 0;
+        //Uniform buffer backing the Camera block
+        unsigned int m_cameraUBO = 0;
+
+        //Skips redundant state changes, invalidated at the start of every command list's replay
+        GLStateCache m_glState;
+        //Draw calls of the command list being replayed
+        ReplayStats m_replayStats;
+        //The Render Element's GPU timer, may be nullptr
+        EngineMetrics::GpuTimer* m_gpuTimer = nullptr;
+
+        //Sprite instances each region of the instance buffer starts with, and the most it grows to (chunks larger frames are split into)
+        const size_t m_INITIAL_INSTANCES = 1024;
+        const size_t m_MAX_INSTANCES_PER_CHUNK = 262144;
+    };
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+//External library GLAD
+#include <glad.h>
+
+#include "util/types.h"
+
+//Shadows the OpenGL state the Render System changes, so that setting state that is already set costs no driver call
+//Covers the program, the texture bound to each texture unit, the VAO, the array buffer, and blend and depth state
+//Only changes made through the cache are tracked, so invalidate() must be called after any code may have changed state directly (e.g. at the start of every frame, since the GUI and the Resource Element bind their own state)
+namespace EcsRenderSystem
+{
+    class GLStateCache
+    {
+    public:
+        //Texture units whose bindings are tracked, binding to higher units is always issued
+        static const int TEXTURE_UNITS = 4;
+
+        GLStateCache();
+
+        //Forget all shadowed state, so the next change to each is always issued
+        void invalidate();
+
+        void useProgram(GLuint program);
+        //Bind texture to target on unit, only GL_TEXTURE_2D and GL_TEXTURE_BUFFER bindings are tracked
+        void bindTexture(GLuint unit, GLenum target, GLuint texture);
+        void bindVertexArray(GLuint vertexArray);
+        void bindArrayBuffer(GLuint buffer);
+        void setBlend(bool enabled);
+        void setBlendFunc(GLenum sourceFactor, GLenum destinationFactor);
+        void setDepthTest(bool enabled);
+        void setDepthWrite(bool enabled);
+        void setDepthFunc(GLenum function);
+
+        //Calls issued to the driver and calls skipped as redundant since the counts were last reset
+        u32 getCallsIssued() const { return m_callsIssued; }
+        u32 getCallsSkipped() const { return m_callsSkipped; }
+        void resetCallCounts() { m_callsIssued = 0; m_callsSkipped = 0; }
+
+    private:
+        //Shadowed value meaning the real state is unknown, so it is never equal to a requested value
+        static const GLuint UNKNOWN = 0xFFFFFFFF;
+
+        //Count a requested change, returning true if it must be issued (and recording the new value)
+        bool change(GLuint& shadowed, GLuint requested);
+
+        GLuint m_program;
+        GLuint m_activeTextureUnit;
+        GLuint m_texture2D[TEXTURE_UNITS];
+        GLuint m_textureBuffer[TEXTURE_UNITS];
+        GLuint m_vertexArray;
+        GLuint m_arrayBuffer;
+        GLuint m_blend;
+        GLuint m_blendSourceFactor;
+        GLuint m_blendDestinationFactor;
+        GLuint m_depthTest;
+        GLuint m_depthWrite;
+        GLuint m_depthFunc;
+
+        u32 m_callsIssued = 0;
+        u32 m_callsSkipped = 0;
+    };
+}
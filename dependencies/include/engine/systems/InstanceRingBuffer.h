@@ -0,0 +1,65 @@
+#pragma once
+
+//External library GLAD
+#include <glad.h>
+
+//Streams per-instance data (e.g. model matrices) to the GPU without stalling on draws still reading the buffer
+//The buffer is split into FRAME_REGIONS regions, one per frame in flight, each guarded by a fence placed after the draws from it
+//A frame writes its instance data into its own region, then each batch draws from its offset into that region
+//Regions start small and double (up to a maximum) whenever a frame needs more, so small scenes reserve little memory
+//A frame needing more than the largest region writes in chunks, a chunk that doesn't fit moves on to the next region, waiting for the GPU if it is still reading it
+//Uses a persistently mapped buffer (ARB_buffer_storage) where the driver supports it, otherwise unsynchronized mapping of the region
+namespace EcsRenderSystem
+{
+    class InstanceRingBuffer
+    {
+    public:
+        //Number of frames that may be in flight at once
+        static const int FRAME_REGIONS = 3;
+
+        InstanceRingBuffer();
+        ~InstanceRingBuffer();
+
+        //Create the buffer with room for regionSize bytes per frame, growing to at most maxRegionSize, requires a current OpenGL context
+        void initialize(GLsizeiptr regionSize, GLsizeiptr maxRegionSize);
+        //Unmap and delete the buffer and any fences
+        void terminate();
+
+        //Grow the regions if frameSize bytes don't fit in one (and it can grow), then move to the next region
+        //Waits only if the GPU is still reading that region from FRAME_REGIONS regions ago
+        void beginFrame(GLsizeiptr frameSize);
+        //Copy size bytes into the current region, moving to the next region if they don't fit in what is left of it
+        //Returns their byte offset into the buffer, or -1 if they are larger than a region (or the region couldn't be mapped)
+        GLintptr write(const void* data, GLsizeiptr size);
+        //Fence the current region, call after the frame's last draw from the buffer
+        void endFrame();
+
+        GLuint getBuffer() const { return m_buffer; }
+        GLsizeiptr getRegionSize() const { return m_regionSize; }
+        bool isPersistentlyMapped() const { return m_persistentData != nullptr; }
+
+        //Bytes written this frame, the most written in any frame, and the size of the whole buffer
+        GLsizeiptr getFrameBytes() const { return m_frameBytes; }
+        GLsizeiptr getPeakFrameBytes() const { return m_peakFrameBytes; }
+        GLsizeiptr getAllocatedBytes() const { return m_regionSize * FRAME_REGIONS; }
+
+    private:
+        //Create the buffer (and its mapping) with regions of regionSize bytes
+        void allocate(GLsizeiptr regionSize);
+        //Fence the current region if it isn't already, then move to the next region once the GPU has finished reading it
+        void nextRegion();
+
+        GLuint m_buffer = 0;
+        GLsizeiptr m_regionSize = 0;
+        GLsizeiptr m_maxRegionSize = 0;
+        //Persistent mapping of the whole buffer, or nullptr if mapping each write instead
+        char* m_persistentData = nullptr;
+
+        int m_region = 0;
+        GLsizeiptr m_regionUsed = 0;
+        GLsync m_fences[FRAME_REGIONS] = {};
+
+        GLsizeiptr m_frameBytes = 0;
+        GLsizeiptr m_peakFrameBytes = 0;
+    };
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+//C++ libraries
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "systems/RenderDevice.h"
+
+//A device that draws nothing, for running the Engine without a GPU (e.g. the sprite submission benchmark, or a Core without a Render Element)
+//Every call is counted, and checked as the OpenGL device would need it to be: a pipeline and texture are set before any draw, draws stay within
+//the uploaded instances, uploads stay within their list's data, and textures and programs exist when they are used or deleted
+//Invalid calls are counted and logged (at most once every few seconds), never drawn around as the OpenGL device may have to
+namespace EcsRenderSystem
+{
+    //Totals since the device was created or resetCounts was last called
+    struct DeviceCallCounts
+    {
+        u64 commandLists = 0;
+        u64 commands = 0;
+        u64 pipelineChanges = 0;
+        u64 textureBinds = 0;
+        u64 uploads = 0;
+        u64 uploadBytes = 0;
+        u64 instancedDraws = 0;
+        u64 singleDraws = 0; //Each singly drawn sprite is a draw, as it is for the OpenGL device
+        u64 instancesDrawn = 0;
+        u64 lineDraws = 0;
+        u64 texturesCreated = 0;
+        u64 textureUpdates = 0;
+        u64 programsCreated = 0;
+        u64 invalidCalls = 0;
+    };
+
+    class NullRenderDevice : public RenderDevice
+    {
+    public:
+        u32 createTexture(int width, int height, int channels, const unsigned char* pixels, int maxMipLevel) override;
+        void updateTexture(u32 texture, int x, int y, int width, int height, int channels, const unsigned char* pixels) override;
+        void deleteTexture(u32 texture) override;
+
+        u32 createProgram(const char* vertexSource, const char* fragmentSource) override;
+        void deleteProgram(u32 program) override;
+
+        void execute(RenderCommandList& commands) override;
+        void discardRetained() override;
+
+        const char* getName() const override { return "Null"; }
+
+        const DeviceCallCounts& getCounts() const { return m_counts; }
+        void resetCounts() { m_counts = DeviceCallCounts(); }
+
+    protected:
+        //Count an invalid call and log what was wrong with it
+        void reportInvalid(const char* problem);
+
+    private:
+        struct TextureSize
+        {
+            int width;
+            int height;
+        };
+        //Live textures and programs by handle, handles are never reused
+        std::unordered_map<u32, TextureSize> m_textures;
+        std::unordered_set<u32> m_programs;
+        u32 m_nextHandle = 1;
+        //Instances uploaded to each static sprite chunk, by chunk index, 0 if the chunk has none
+        std::vector<u32> m_staticChunkInstances;
+
+        DeviceCallCounts m_counts;
+    };
+}
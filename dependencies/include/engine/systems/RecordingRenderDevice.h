@@ -0,0 +1,42 @@
+#pragma once
+
+//C++ libraries
+#include <fstream>
+#include <string>
+
+#include "systems/NullRenderDevice.h"
+
+//A null device that also writes every call, and every command of every command list it executes, to a text file
+//For reading exactly what the Render System recorded, or diffing two command streams (e.g. before and after a change to batching)
+//Calls are checked and counted as the null device does, and invalid calls are marked in the file where they happen
+namespace EcsRenderSystem
+{
+    class RecordingRenderDevice : public NullRenderDevice
+    {
+    public:
+        //Create (or truncate) the file at filePath, check isOpen to see if it could be
+        RecordingRenderDevice(const std::string& filePath);
+
+        u32 createTexture(int width, int height, int channels, const unsigned char* pixels, int maxMipLevel) override;
+        void updateTexture(u32 texture, int x, int y, int width, int height, int channels, const unsigned char* pixels) override;
+        void deleteTexture(u32 texture) override;
+
+        u32 createProgram(const char* vertexSource, const char* fragmentSource) override;
+        void deleteProgram(u32 program) override;
+
+        void execute(RenderCommandList& commands) override;
+        void discardRetained() override;
+
+        const char* getName() const override { return "Recording"; }
+
+        bool isOpen() const { return m_file.is_open(); }
+
+    private:
+        //Write one command of a list as a line of text
+        void writeCommand(const RenderCommand& command);
+
+        std::ofstream m_file;
+        u64 m_listsRecorded = 0;
+        u64 m_invalidCallsWritten = 0;
+    };
+}
@@ -0,0 +1,240 @@
+#pragma once
+
+//C++ libraries
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include "util/types.h"
+
+//A compact, API-agnostic list of a frame's rendering, recorded by the Render System and replayed by it afterwards
+//Recording culls, sorts, and packs the sprites into commands without touching the graphics API, replaying is the only part that does
+//so a list can be replayed on the Render Element's render thread whilst the next frame's list is recorded on the main thread
+//Commands are small fixed-size structs, anything larger (instances, matrices, vertices) is copied into the list's data, so a list stays valid after its frame
+//Textures and programs are the graphics API's handles, passed through unchanged
+namespace EcsRenderSystem
+{
+    enum class RenderCommandType : u8
+    {
+        SetPipeline, //Set a pass's blend and depth state and alpha cutoff, and the program single draws use
+        BindTexture, //Bind the texture sprites are drawn from
+        UploadRange, //Upload a range of the list's data to a target
+        DrawInstanced, //Draw a run of sprite instances with one instanced call
+        DrawSingle, //Draw a run of the streamed sprite instances one by one
+        DrawLines //Draw debug lines from a range of the list's data
+    };
+
+    //What an UploadRange command's data replaces
+    enum class UploadTarget : u8
+    {
+        Camera, //View then projection matrix
+        UVRects, //The texture atlas's UV rects
+        StreamedInstances, //This frame's streamed sprite instances, in the order they are drawn, uploaded once before any draw
+        StaticChunk //A static sprite chunk's instances, an empty range releases the chunk's buffer
+    };
+
+    //A range of a list's data, by byte offset
+    struct DataRange
+    {
+        u32 offset;
+        u32 size;
+    };
+
+    struct SetPipelineCommand
+    {
+        u32 pass; //One of the SortKey passes
+        u32 program; //A sprite's own program, 0 for the default programs
+    };
+
+    struct BindTextureCommand
+    {
+        u32 texture;
+    };
+
+    struct UploadRangeCommand
+    {
+        UploadTarget target;
+        u32 index; //The chunk, for StaticChunk
+        DataRange data;
+    };
+
+    struct DrawInstancedCommand
+    {
+        u32 chunk; //A static sprite chunk, or STREAMED_INSTANCES for this frame's streamed instances
+        u32 first; //First instance within the chunk (or the streamed instances)
+        u32 count;
+    };
+
+    struct DrawSingleCommand
+    {
+        u32 first; //First of the streamed instances
+        u32 count;
+    };
+
+    struct DrawLinesCommand
+    {
+        DataRange vertices; //EngineDebugDraw::DebugVertex pairs
+    };
+
+    struct RenderCommand
+    {
+        RenderCommandType type;
+        union
+        {
+            SetPipelineCommand setPipeline;
+            BindTextureCommand bindTexture;
+            UploadRangeCommand uploadRange;
+            DrawInstancedCommand drawInstanced;
+            DrawSingleCommand drawSingle;
+            DrawLinesCommand drawLines;
+        };
+    };
+
+    //Counters only known once a list has been replayed, kept with the list so the main thread can read them once the render thread is done with it
+    //See EngineMetrics::FrameCounters
+    struct ReplayStats
+    {
+        u32 drawCalls = 0;
+        u32 instancedDrawCalls = 0;
+        u32 singleDrawCalls = 0;
+        u32 glCallsIssued = 0;
+        u32 glCallsSkipped = 0;
+        u32 instanceBufferBytes = 0;
+        u32 instanceBufferPeakBytes = 0;
+        u32 instanceBufferAllocatedBytes = 0;
+    };
+
+    class RenderCommandList
+    {
+    public:
+        //Drawn instances come from this frame's streamed instances rather than a static chunk
+        static const u32 STREAMED_INSTANCES = 0xFFFFFFFF;
+
+        //Start recording again, the commands' and data's memory is kept so recording steady-state frames doesn't allocate
+        void clear()
+        {
+            m_commands.clear();
+            m_data.clear();
+            m_pass = NO_STATE;
+            m_program = NO_STATE;
+            m_texture = NO_STATE;
+            m_replayed.store(false, std::memory_order_relaxed);
+            m_statsPublished = false;
+        }
+
+        //Pipelines and textures are only recorded when they differ from the last recorded
+        void setPipeline(u32 pass, u32 program)
+        {
+            if (pass == m_pass && program == m_program)
+            {
+                return;
+            }
+            RenderCommand command;
+            command.type = RenderCommandType::SetPipeline;
+            command.setPipeline = SetPipelineCommand{ pass, program };
+            m_commands.push_back(command);
+            m_pass = pass;
+            m_program = program;
+        }
+
+        void bindTexture(u32 texture)
+        {
+            if (texture == m_texture)
+            {
+                return;
+            }
+            RenderCommand command;
+            command.type = RenderCommandType::BindTexture;
+            command.bindTexture = BindTextureCommand{ texture };
+            m_commands.push_back(command);
+            m_texture = texture;
+        }
+
+        //Reserve size bytes of the list's data to be uploaded to target, returning where to write them (valid until the list's data next grows)
+        void* uploadRange(UploadTarget target, u32 index, size_t size)
+        {
+            RenderCommand command;
+            command.type = RenderCommandType::UploadRange;
+            command.uploadRange = UploadRangeCommand{ target, index, allocateData(size) };
+            m_commands.push_back(command);
+            return m_data.data() + command.uploadRange.data.offset;
+        }
+
+        //Copy size bytes into the list's data to be uploaded to target
+        void uploadRange(UploadTarget target, u32 index, const void* data, size_t size)
+        {
+            if (size > 0)
+            {
+                std::memcpy(uploadRange(target, index, size), data, size);
+            }
+            else
+            {
+                uploadRange(target, index, 0);
+            }
+        }
+
+        void drawInstanced(u32 chunk, u32 first, u32 count)
+        {
+            RenderCommand command;
+            command.type = RenderCommandType::DrawInstanced;
+            command.drawInstanced = DrawInstancedCommand{ chunk, first, count };
+            m_commands.push_back(command);
+        }
+
+        void drawSingle(u32 first, u32 count)
+        {
+            RenderCommand command;
+            command.type = RenderCommandType::DrawSingle;
+            command.drawSingle = DrawSingleCommand{ first, count };
+            m_commands.push_back(command);
+        }
+
+        //Copy size bytes of line vertices into the list's data to be drawn
+        void drawLines(const void* vertices, size_t size)
+        {
+            RenderCommand command;
+            command.type = RenderCommandType::DrawLines;
+            command.drawLines = DrawLinesCommand{ allocateData(size) };
+            std::memcpy(m_data.data() + command.drawLines.vertices.offset, vertices, size);
+            m_commands.push_back(command);
+        }
+
+        const std::vector<RenderCommand>& getCommands() const { return m_commands; }
+        const u8* getData(const DataRange& range) const { return m_data.data() + range.offset; }
+        size_t getDataBytes() const { return m_data.size(); }
+
+        //Set by the replay once it is finished with the list, read by the recording thread
+        void markReplayed(const ReplayStats& stats)
+        {
+            m_stats = stats;
+            m_replayed.store(true, std::memory_order_release);
+        }
+        bool isReplayed() const { return m_replayed.load(std::memory_order_acquire); }
+        const ReplayStats& getStats() const { return m_stats; }
+        //Whether the recording thread has already counted the list's replay stats, so a list's stats are only counted once
+        bool areStatsPublished() const { return m_statsPublished; }
+        void setStatsPublished() { m_statsPublished = true; }
+
+    private:
+        static const u32 NO_STATE = 0xFFFFFFFF;
+
+        //Ranges start 16 byte aligned, so any data can be read in place
+        DataRange allocateData(size_t size)
+        {
+            size_t offset = (m_data.size() + 15) & ~static_cast<size_t>(15);
+            m_data.resize(offset + size);
+            return DataRange{ static_cast<u32>(offset), static_cast<u32>(size) };
+        }
+
+        std::vector<RenderCommand> m_commands;
+        std::vector<u8> m_data;
+        //The last recorded pipeline and texture
+        u32 m_pass = NO_STATE;
+        u32 m_program = NO_STATE;
+        u32 m_texture = NO_STATE;
+
+        ReplayStats m_stats;
+        std::atomic<bool> m_replayed{ false };
+        bool m_statsPublished = false;
+    };
+}
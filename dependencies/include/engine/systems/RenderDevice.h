@@ -0,0 +1,41 @@
+#pragma once
+
+#include "util/types.h"
+#include "systems/RenderCommands.h"
+
+//The graphics API behind the Render System, the Resource Element, the texture atlas, and the Shader Element
+//Everything they create or draw goes through the Core's device, so the same recording can be replayed by OpenGL (GLRenderDevice),
+//checked and counted without a GPU (NullRenderDevice), or written out as text (RecordingRenderDevice)
+//Handles are the device's own, 0 is never a valid texture or program
+//Like OpenGL itself, a device is only used from one thread at a time: creating and deleting happen on the main thread (after Core::acquireGLContext),
+//executing wherever the Render Element replays the frame
+namespace EcsRenderSystem
+{
+    class RenderDevice
+    {
+    public:
+        //A texture's maximum mip level when every level down to 1x1 should be generated
+        static const int ALL_MIP_LEVELS = 1000;
+
+        virtual ~RenderDevice() {}
+
+        //Create a texture from tightly packed pixels (3 or 4 channels, rows bottom to top), with mipmaps up to maxMipLevel
+        //pixels may be nullptr, leaving the texture's contents undefined, returns 0 on failure
+        virtual u32 createTexture(int width, int height, int channels, const unsigned char* pixels, int maxMipLevel) = 0;
+        //Replace a rectangle of a texture's base level with tightly packed pixels, then regenerate its mipmaps
+        virtual void updateTexture(u32 texture, int x, int y, int width, int height, int channels, const unsigned char* pixels) = 0;
+        virtual void deleteTexture(u32 texture) = 0;
+
+        //Compile and link a program from vertex and fragment shader sources, logging why if it can't be, returns 0 on failure
+        virtual u32 createProgram(const char* vertexSource, const char* fragmentSource) = 0;
+        virtual void deleteProgram(u32 program) = 0;
+
+        //Replay a recorded command list, then mark it replayed with its stats
+        virtual void execute(RenderCommandList& commands) = 0;
+        //Release everything kept between command lists (the static sprite chunks), for when their recorder is destroyed
+        virtual void discardRetained() = 0;
+
+        //Name logged when the device is installed
+        virtual const char* getName() const = 0;
+    };
+}
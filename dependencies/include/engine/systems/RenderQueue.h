@@ -0,0 +1,74 @@
+#pragma once
+
+//C++ libraries
+#include <vector>
+
+#include "util/types.h"
+
+//Draws are queued as plain items of a 64 bit sort key and the index of the draw's data, then radix sorted by key
+//Sorting by key orders draws by everything that matters at once (pass, depth, shader, then texture), without comparing through pointers
+//The top 2 bits are the pass, so the opaque pass is drawn first, then the alpha tested pass, then the translucent pass
+//The rest of the key depends on the pass, from most to least significant:
+//  Opaque and alpha tested: shader 12 bits, texture 20 bits, then depth 21 bits descending so each shader and texture's draws go front to back
+//  Translucent: depth 21 bits ascending so draws go back to front, shader 12 bits, then texture 20 bits
+//  Depth is the rank of the sorting layer and order in layer, shader is an index of the program rather than its OpenGL name, texture is the OpenGL texture name
+//  9 spare bits
+namespace EcsRenderSystem
+{
+    //A queued draw, index is into whatever array holds the draws' data
+    struct DrawItem
+    {
+        u64 key;
+        u32 index;
+    };
+
+    namespace SortKey
+    {
+        //Passes, in the order they are drawn
+        const u32 OPAQUE_PASS = 0;
+        const u32 ALPHA_TESTED_PASS = 1;
+        const u32 TRANSLUCENT_PASS = 2;
+
+        const int PASS_SHIFT = 62;
+        const int DEPTH_BITS = 21;
+
+        const int MAX_LAYER = 31;
+        const int MIN_ORDER = -32768;
+        const int MAX_ORDER = 32767;
+        const u32 MAX_SHADER = 0xFFF;
+        const u32 MAX_TEXTURE = 0xFFFFF;
+
+        //Rank of a sorting layer and order in layer (both clamped), greater ranks are in front, less than 2^DEPTH_BITS
+        u32 depthRank(int layer, int order);
+        //Pack a key, the shader is clamped and the texture wrapped, which only costs batching
+        u64 make(u32 pass, u32 depthRank, u32 shader, u32 texture);
+        inline u32 getPass(u64 key) { return static_cast<u32>(key >> PASS_SHIFT); }
+    }
+
+    class RenderQueue
+    {
+    public:
+        //Queues at least this long are sorted on several threads
+        static const size_t PARALLEL_THRESHOLD = 65536;
+        //Most threads a parallel sort uses, including the calling thread
+        static const unsigned int MAX_SORT_THREADS = 8;
+
+        void clear() { m_items.clear(); }
+        void reserve(size_t count) { m_items.reserve(count); }
+        void push(u64 key, u32 index) { m_items.push_back(DrawItem{ key, index }); }
+
+        //Stable LSD radix sort by key, 8 bits per pass, skipping every pass whose digit is the same for all items
+        void sort();
+
+        const std::vector<DrawItem>& getItems() const { return m_items; }
+        size_t size() const { return m_items.size(); }
+
+    private:
+        //The items, and scratch space for the passes to scatter into, both kept between frames so sorting doesn't allocate
+        std::vector<DrawItem> m_items;
+        std::vector<DrawItem> m_scratch;
+        //Per-thread digit counts for every pass, and per-thread scatter offsets for the current pass
+        std::vector<size_t> m_counts;
+        std::vector<size_t> m_offsets;
+    };
+}
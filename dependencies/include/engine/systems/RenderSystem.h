@@ -5,13 +5,25 @@
 
 //C++ libraries
 #include <memory>
+#include <unordered_map>
 
-//External libraries GLAD and GLM
-#include <glad.h>
+//External library GLM
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <glm/packing.hpp>
+#include <glm/gtc/packing.hpp>
 
 #include "ecs/Components.h"
+#include "util/Metrics.h"
+#include "util/Arena.h"
+#include "util/DebugDraw.h"
+#include "systems/SpriteDraw.h"
+#include "systems/StaticSpriteCache.h"
+#include "systems/SpatialGrid.h"
+#include "systems/RenderQueue.h"
+#include "systems/RenderCommands.h"
+#include "systems/RenderDevice.h"
+#include "resource/TextureAtlas.h"
 #pragma warning(pop)
 
 //The definition of an Entity (i.e. an Entity exists as an integer)
@@ -26,6 +38,10 @@ namespace Sol {
     class Core;
 }
 
+namespace CoreRenderElement {
+    class RenderElement;
+}
+
 namespace ApplicationConfig
 {
     class Config;
@@ -35,6 +51,9 @@ struct SpriteComponent;
 
 namespace EcsRenderSystem
 {
+    //Every frame is recorded into a command list, then replayed by the Render Element, on its render thread if enabled
+    //Recording (gathering, culling, sorting, and batching sprites) only runs on the main thread and never touches the graphics API
+    //Replaying is done by the Core's render device (see RenderDevice), wherever the OpenGL context is, so recording the next frame can overlap replaying this one
     class RenderSystem
     {
     public:
@@ -50,59 +69,104 @@ namespace EcsRenderSystem
         //Fixed update is not used since rendering is dependent upon a variable delta timesep
         void fixedUpdate(double fixedTimestep);
 
-        //A function to create the default shader
-        //There is a Shader Element, however this isn't used since a default shader is preferable in-code as opposed to loading from two separate viles
-        unsigned int createShader(const char* vertexShaderSource, const char* fragmentShaderSource);
-
-        //Determines whether single draw or multi draw should be called 
-        void renderSprites(std::vector<std::pair<std::shared_ptr<SpriteComponent>, std::shared_ptr<TransformComponent>>> tmpSpriteTransformPairs);
+        //Sprites to be rendered this frame, allocated from the Core's frame arena
+        using SpriteDraws = EngineMemory::ArenaVector<SpriteDraw>;
 
-        //Single drawing will be used if the number of sprites to be rendered with the same texture is less than the minimum number of sprites required to make batch (instanced) rendering worthwile
-        void singleDraw(int currentTexture, GLsizei numSpritesByTexture, size_t numSpritesRenderedBeforeThisBatch);
-        //Multi drawing is in essence batch (instanced) rendering, so renders all sprites with the same texture in one draw call if there are enough sprites to make this worthwhile
-        void multiDraw(int currentTexture, GLsizei numSpritesByTexture, size_t numSpritesRenderedBeforeThisBatch);
+        //A batch of a static sprite chunk to be drawn this frame, before the sprite draw at position in the sorted sprite draws
+        struct StaticBatchDraw
+        {
+            size_t position;
+            u32 chunk;
+            u32 batch;
+        };
+        using StaticBatchDraws = EngineMemory::ArenaVector<StaticBatchDraw>;
 
-        //To render box or circle wireframes of the collider component (made to be only possible through the Editor)
-        void renderWireframe(const TransformComponent& transform, const ColliderComponent& collider, bool isCircle);
+        //Determines whether single draw or multi draw should be recorded, and records the static batches in order between them
+        void renderSprites(RenderCommandList& commands, const SpriteDraws& spriteDraws, const StaticBatchDraws& staticBatchDraws);
+        //Add the outline of every collider set to be visible (made to be only possible through the Editor) to the debug draw
+        void drawColliders(EngineDebugDraw::DebugDraw& debugDraw);
 
         //Auxilliary function to set the projection matrix, useful in case the aspect ratio changes (i.e. if the window changes size)
         void setProjectionMatrix();
+        //Move the primary camera towards its target if it follows one, then set the view matrix and the visible rectangle from it
+        //Without a primary camera the view is the identity, centred on the origin
+        void updateCamera(double deltaTime);
+        //Gather the sprites again if the ECS's Entities or Components have changed, then update every sprite's bounds in the grid
+        void updateSpriteGrid();
+
+        //Axis-aligned bounds of a sprite, including its rotation
+        static void getSpriteBounds(const TransformComponent& transform, const SpriteComponent& sprite, glm::vec2& min, glm::vec2& max);
+
+        //Pack a sprite's transform, size, and color into its instance data
+        static SpriteInstance packSpriteInstance(const TransformComponent& transform, const SpriteComponent& sprite);
 
     private:
         std::shared_ptr<CoreEcsElement::EcsElement> m_ecsElement; //Shared pointer of the ECS Element to allow the Render System to manage the ECS's lifetime otherwise the ECS may terminate before the rendering is finished
         //Pointer to Core
         std::weak_ptr<Sol::Core> m_core;
-
-        //VAO for managing VBOs
-        //VBO as data container for vertex or instance attributes
-        //EBO for indices to process vertices
-
-        //Main VAO, quad VBO/EBO, and model matrices' VBO
-        unsigned int m_mainVAO;
-        unsigned int m_quadVBO;
-        unsigned int m_quadEBO;
-        unsigned int m_modelVBO;
-
-        //VAOs and VBOs for wireframe of boc and circle
-        unsigned int m_wireframeSquareVAO;
-        unsigned int m_wireframeCircleVAO;
-        unsigned int m_wireframeSquareVBO;
-        unsigned int m_wireframeCircleVBO;
+        //The Render Element the command lists are submitted to, nullptr if there is none (the lists are then replayed straight away)
+        CoreRenderElement::RenderElement* m_renderElement = nullptr;
+        //The Core's device, which replays the command lists and keeps the static chunks they upload
+        //The device must not be changed once the Render System exists, since it retains what the Render System recorded
+        RenderDevice* m_device = nullptr;
+
+        //Double buffered, so the next frame is recorded whilst the render thread replays this one
+        //A list is only recorded into again once its replay has finished, which the Render Element ensures by finishing a frame's replay before the next frame is presented
+        RenderCommandList m_commandLists[2];
+        int m_recordIndex = 0;
+        //Add a replayed list's draw calls and buffer usage to this frame's counters, once per list
+        void publishReplayStats(RenderCommandList& commands);
+
+        //The Resource Element's texture atlas, nullptr if there is no Resource Element, and the atlas version last recorded
+        const CoreResourceElement::TextureAtlas* m_textureAtlas = nullptr;
+        u32 m_uvRectsVersion = 0;
+        //Record the atlas's UV rects if they have changed since they were last recorded
+        void updateUVRects(RenderCommandList& commands);
 
         //Calculate model an view matrices
         glm::mat4 m_viewMatrix = glm::mat4(1.0f);
         glm::mat4 m_projectionMatrix = glm::mat4(1.0f);
 
-        //Shader program ID's for default rendering of a sprite
-        //One for if the draw call is per sprite, one for if the draw call is for a batch to be drawn via instancing
-        unsigned int m_defaultShaderID;
-        unsigned int m_defaultInstanceShaderID;
-
-        //Max number of spites that can be drawn total
-        const int m_MAX_SPRITES = 100000;
-
-        //Cache for the calculated modelMatrices
-        std::vector<glm::mat4> m_modelMatricesCache;
+        //Rectangle of the scene visible through the camera this frame, sprites outside it are culled
+        glm::vec2 m_viewMin = glm::vec2(0.0f);
+        glm::vec2 m_viewMax = glm::vec2(0.0f);
+
+        //Every sprite that has a transform, indexed by its item in the sprite grid
+        //Gathered again only when the ECS's structure version changes, rather than every frame
+        struct CullableSprite
+        {
+            std::shared_ptr<TransformComponent> transform;
+            std::shared_ptr<SpriteComponent> sprite;
+            std::shared_ptr<PhysicsBodyComponent> body; //nullptr if the Entity has no physics body
+            u32 staticSlot; //Item in the static sprite cache, kept by the Entity across gathers
+        };
+        std::vector<CullableSprite> m_cullableSprites;
+        u32 m_cullableSpritesVersion = 0;
+        bool m_cullableSpritesGathered = false;
+        //Grid of the streamed sprites' bounds, queried with the visible rectangle so only visible sprites are packed, sorted, and uploaded
+        SpatialGrid m_spriteGrid;
+        //Static sprites (those without a physics body or with a static one, drawn by the default programs) are kept in retained chunks instead of the grid
+        StaticSpriteCache m_staticSprites;
+        //Each gathered Entity's item in the static sprite cache, kept whilst the Entity has a sprite and a transform, freed slots are reused
+        //Items can't be the index in m_cullableSprites, as gathering again may reorder them, which would change (and so rebuild) every chunk
+        std::unordered_map<Entity, u32> m_staticSpriteSlots;
+        std::vector<u32> m_freeStaticSpriteSlots;
+        u32 getStaticSpriteSlot(Entity entity);
+        static bool isStatic(const CullableSprite& cullable);
+        //Pack a sprite's draw, with its texture's atlas page and UV rect if it is in the atlas
+        SpriteDraw makeSpriteDraw(const CullableSprite& cullable);
+        //Set on the index of a static batch queued in the render queue, to tell it from the index of a sprite draw
+        static const u32 STATIC_BATCH_BIT = 0x80000000;
+
+        //A sprite's own shader program (SpriteComponent::shaderProgram) has its index in sort keys assigned when it is first recorded
+        std::unordered_map<u32, u32> m_customProgramSortIndices;
+        u32 getCustomProgramSortIndex(u32 program);
+
+        //This frame's sprite draws by sort key, kept between frames so queuing and sorting don't allocate
+        RenderQueue m_renderQueue;
+
+        //The view and projection matrices are recorded only when either changes
+        bool m_cameraChanged = true;
 
         //Minimum number of sprites required for batch (instanced) rendering to be used instead of individual draw calls
         const unsigned int m_MIN_SPRITES_FOR_INSTANCING = 10;
@@ -111,5 +175,9 @@ namespace EcsRenderSystem
         const float m_scalingFactor = 100.0f; //100 pixels per metre
 
         float m_aspect = 0.0f; //Aspect ratio to be used to set the projection matrix appropriately
+
+        //This frame's counters in the Core's Metrics, sprites and chunks are counted into these for the Performance viewport
+        //Draw calls are counted into the command list's replay stats, and added to these once the list has been replayed
+        EngineMetrics::FrameCounters* m_frameCounters = nullptr;
     };
 }
\ No newline at end of file
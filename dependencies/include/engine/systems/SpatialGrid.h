@@ -0,0 +1,65 @@
+#pragma once
+
+//C++ libraries
+#include <unordered_map>
+#include <vector>
+
+//External library GLM
+#include <glm/glm.hpp>
+
+#include "util/types.h"
+#include "util/Arena.h"
+
+//Uniform grid over the scene for finding the items (e.g. sprites) whose bounds overlap a rectangle, such as the camera's view
+//Items are identified by a dense index chosen by the caller, and each is stored in every cell its bounds touch
+//Updating an item that stays within the same cells only stores its new bounds, so only items crossing cell boundaries move between cells
+//Cells are created on demand, so the scene can be any size
+namespace EcsRenderSystem
+{
+    class SpatialGrid
+    {
+    public:
+        //Side of each (square) cell in pixels
+        static const int CELL_SIZE = 256;
+        //Items spanning more cells than this in either axis are kept in a separate list tested by every query, rather than filling many cells
+        static const int MAX_ITEM_CELLS = 8;
+
+        //Set the bounds of an item, inserting it if it isn't in the grid
+        void update(u32 item, const glm::vec2& min, const glm::vec2& max);
+        //Remove an item, if it is in the grid
+        void remove(u32 item);
+        //Remove every item
+        void clear();
+
+        //Append every item whose bounds overlap the rectangle to items, each once
+        void query(const glm::vec2& min, const glm::vec2& max, EngineMemory::ArenaVector<u32>& items);
+
+        size_t getCellCount() const { return m_cells.size(); }
+
+    private:
+        struct Item
+        {
+            glm::vec2 min = glm::vec2(0.0f);
+            glm::vec2 max = glm::vec2(0.0f);
+            //Inclusive range of cells the item is stored in
+            int cellMinX = 0, cellMinY = 0, cellMaxX = -1, cellMaxY = -1;
+            bool present = false;
+            bool large = false;
+            //Query the item was last appended by, so items in several cells are appended once
+            u32 queryStamp = 0;
+        };
+
+        static int cellCoordinate(float position);
+        static u64 cellKey(int x, int y);
+
+        void insertIntoCells(u32 item);
+        void removeFromCells(u32 item);
+        //Append item to items if its bounds overlap the rectangle and it hasn't been appended by this query
+        void test(u32 item, const glm::vec2& min, const glm::vec2& max, EngineMemory::ArenaVector<u32>& items);
+
+        std::vector<Item> m_items;
+        std::unordered_map<u64, std::vector<u32>> m_cells;
+        std::vector<u32> m_largeItems;
+        u32 m_queryStamp = 0;
+    };
+}
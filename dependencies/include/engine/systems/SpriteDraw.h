@@ -0,0 +1,32 @@
+#pragma once
+
+//External library GLM
+#include <glm/glm.hpp>
+
+#include "util/types.h"
+
+//The data the Render System draws a sprite from, packed from its TransformComponent and SpriteComponent
+namespace EcsRenderSystem
+{
+    //Per-instance data of a sprite drawn by instancing, 24 bytes rather than a 64 byte model matrix
+    //The instanced vertex shader builds the transformation from these, so only a third of the data is uploaded per sprite
+    struct SpriteInstance
+    {
+        glm::vec2 position; //Position of the sprite's centre in pixels
+        u32 scale; //Transform scale multiplied by sprite size, as two half floats (x, y)
+        u32 tint; //Sprite color as RGBA8, multiplied with the texture
+        u32 depth; //Rank of the sprite's sorting layer and order in layer (see SortKey::depthRank), for the depth test
+        u16 rotation; //Rotation in 65536ths of a full turn
+        u16 uvRect = 0; //Index of the sprite's UV rect in the texture atlas, 0 (the whole texture) if its texture isn't in the atlas
+    };
+    static_assert(sizeof(SpriteInstance) == 24, "SpriteInstance must stay tightly packed");
+
+    //A sprite to be drawn this frame, with the texture it is drawn from (its atlas page if its texture is in the atlas)
+    struct SpriteDraw
+    {
+        u32 texture;
+        u32 program; //The sprite's own shader program, 0 for the default programs
+        u32 pass; //The render pass the sprite is drawn in, one of the SortKey passes
+        SpriteInstance instance;
+    };
+}
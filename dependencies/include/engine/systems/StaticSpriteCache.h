@@ -0,0 +1,91 @@
+#pragma once
+
+//C++ libraries
+#include <unordered_map>
+#include <vector>
+
+//External library GLM
+#include <glm/glm.hpp>
+
+#include "util/types.h"
+#include "util/Arena.h"
+#include "systems/SpriteDraw.h"
+#include "systems/RenderCommands.h"
+
+//Retained instance data for static sprites (those no physics body moves), so they aren't packed into the frame's draws, sorted, or uploaded every frame
+//Static sprites are grouped by their centre into square chunks of the scene, and each chunk's instances are kept in its own buffer
+//A chunk is rebuilt only when one of its sprites is added, removed, or changed, its instances are then recorded as an upload to the chunk's buffer
+//The buffers themselves are owned by whatever replays the recorded commands, so the cache never touches the graphics API
+//Each chunk's instances are sorted into batches of the same pass and texture (and depth rank, for translucent sprites), each drawn with one instanced call
+//Items are identified by a dense index chosen by the caller, as for the SpatialGrid
+namespace EcsRenderSystem
+{
+    class StaticSpriteCache
+    {
+    public:
+        //Side of each (square) chunk in pixels
+        static const int CHUNK_SIZE = 1024;
+
+        //A run of a chunk's instances drawn with one instanced call
+        struct Batch
+        {
+            u64 key; //Sort key the batch is queued with, so it is drawn in order with the streamed sprites
+            u32 texture;
+            u32 pass;
+            u32 first;
+            u32 count;
+        };
+
+        struct Chunk
+        {
+            //Bounds of every sprite in the chunk, empty (min greater than max) if it has none
+            glm::vec2 min = glm::vec2(1.0f);
+            glm::vec2 max = glm::vec2(-1.0f);
+            std::vector<u32> members;
+            std::vector<Batch> batches;
+            bool dirty = false;
+        };
+
+        //Set a static sprite's draw and bounds, adding it if it isn't cached, its chunk is marked for rebuilding if either changed
+        void update(u32 item, const SpriteDraw& draw, const glm::vec2& min, const glm::vec2& max);
+        //Remove a sprite, if it is cached
+        void remove(u32 item);
+        //Remove every sprite and every chunk, recording the release of every chunk's buffer
+        void clear(RenderCommandList& commands);
+
+        //Rebuild every chunk marked since the last call, recording the upload of its instances (or the release of its buffer, if it is empty)
+        //Returns the number rebuilt
+        u32 rebuild(RenderCommandList& commands);
+
+        //Append the index of every chunk whose bounds overlap the rectangle
+        void query(const glm::vec2& min, const glm::vec2& max, EngineMemory::ArenaVector<u32>& chunks) const;
+
+        const Chunk& getChunk(u32 chunk) const { return m_chunks[chunk]; }
+        size_t getSpriteCount() const { return m_spriteCount; }
+
+    private:
+        struct Item
+        {
+            SpriteDraw draw;
+            glm::vec2 min = glm::vec2(0.0f);
+            glm::vec2 max = glm::vec2(0.0f);
+            u32 chunk = 0;
+            bool present = false;
+        };
+
+        static u64 chunkKey(const glm::vec2& position);
+        void markDirty(u32 chunk);
+        void rebuildChunk(u32 index, RenderCommandList& commands);
+
+        std::vector<Item> m_items;
+        //Chunks are never removed, so indices stay valid, an emptied chunk keeps its slot for when a sprite returns to it
+        std::vector<Chunk> m_chunks;
+        std::unordered_map<u64, u32> m_chunksByKey;
+        std::vector<u32> m_dirtyChunks;
+        size_t m_spriteCount = 0;
+
+        //Reused by every rebuild, so rebuilding doesn't allocate once they have grown
+        std::vector<std::pair<u64, u32>> m_sortScratch;
+        std::vector<SpriteInstance> m_instanceScratch;
+    };
+}
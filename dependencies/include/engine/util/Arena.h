@@ -0,0 +1,111 @@
+//------- Arena -------------
+//Linear Arena Allocation
+//For The Sol Core Engine
+//---------------------------
+
+//A linear (bump) arena for transient data, such as the containers the Systems build every frame or every fixed timestep tick
+//Allocating is a pointer bump, nothing is freed individually, and reset() releases everything at once
+//The Core owns a frame arena (reset at the end of every frame) and a tick arena (reset at the end of every fixed timestep tick)
+//Once an arena has grown to its peak usage it stays as one block, so in the steady state allocating from it never touches the heap
+//ArenaAllocator adapts an arena for the standard containers, e.g. ArenaVector<int> values{ ArenaAllocator<int>(core->getFrameArena()) };
+//Containers (and anything else) allocated from an arena must not be used after the arena is reset, and their destructors never need to run
+
+#pragma once
+
+#include "EngineAPI.h"
+
+//C++ libraries
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace EngineMemory
+{
+	class LinearArena
+	{
+	public:
+		explicit LinearArena(std::size_t initialCapacity = 0);
+
+		//Allocate size bytes aligned to alignment (a power of two)
+		void* allocate(std::size_t size, std::size_t alignment)
+		{
+			std::uintptr_t current = reinterpret_cast<std::uintptr_t>(m_current);
+			std::uintptr_t aligned = (current + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+			if (m_current && aligned + size <= reinterpret_cast<std::uintptr_t>(m_end))
+			{
+				m_current = reinterpret_cast<char*>(aligned + size);
+				return reinterpret_cast<void*>(aligned);
+			}
+			return allocateFromNewBlock(size, alignment);
+		}
+
+		//Construct an object in the arena, its destructor is never called
+		template<typename T, typename... Args>
+		T* create(Args&&... args)
+		{
+			return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		}
+
+		//Release everything allocated from the arena
+		//If the arena needed more than one block since the last reset, the blocks are replaced by a single block large enough for all of them
+		ENGINE_API void reset();
+
+		//Bytes allocated since the last reset (including alignment padding), and the most allocated between any two resets
+		ENGINE_API std::size_t getUsed() const;
+		std::size_t getPeak() const { return m_peak; }
+		//Total bytes of the arena's blocks
+		ENGINE_API std::size_t getCapacity() const;
+
+	private:
+		ENGINE_API void* allocateFromNewBlock(std::size_t size, std::size_t alignment);
+
+		struct Block
+		{
+			std::unique_ptr<char[]> memory;
+			std::size_t size = 0;
+		};
+		//Blocks in the order they were allocated, the last is the one currently allocated from
+		std::vector<Block> m_blocks;
+		char* m_current = nullptr;
+		char* m_end = nullptr;
+		//Bytes used by the blocks before the current one
+		std::size_t m_usedInFullBlocks = 0;
+		std::size_t m_peak = 0;
+	};
+
+	//Standard allocator that allocates from a LinearArena, deallocation does nothing
+	template<typename T>
+	class ArenaAllocator
+	{
+	public:
+		using value_type = T;
+
+		ArenaAllocator(LinearArena& arena) : m_arena(&arena) {}
+		template<typename U>
+		ArenaAllocator(const ArenaAllocator<U>& other) : m_arena(other.getArena()) {}
+
+		T* allocate(std::size_t count) { return static_cast<T*>(m_arena->allocate(count * sizeof(T), alignof(T))); }
+		void deallocate(T*, std::size_t) {} //Released all at once when the arena is reset
+
+		LinearArena* getArena() const { return m_arena; }
+
+	private:
+		LinearArena* m_arena;
+	};
+
+	template<typename T, typename U>
+	bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.getArena() == b.getArena(); }
+	template<typename T, typename U>
+	bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.getArena() != b.getArena(); }
+
+	//Containers allocating from an arena
+	template<typename T>
+	using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+	template<typename Key, typename Value>
+	using ArenaUnorderedMap = std::unordered_map<Key, Value, std::hash<Key>, std::equal_to<Key>, ArenaAllocator<std::pair<const Key, Value>>>;
+}
@@ -0,0 +1,57 @@
+//------- Binary Log --------
+//Structured Binary Logging
+//For The Sol Core Engine
+//---------------------------
+
+//The binary log format written by the log pipeline when started with Logger::startBinary (see util/Log.h)
+//Rather than formatting each message, the pipeline captures a message's printf arguments, and the binary log stores each format string once
+//(the first time it is logged) then only the format's ID, the level, the timestamp, the thread ID, and the captured arguments per message
+//decodeBinaryLog turns a binary log back into text, e.g. through the Editor's --decode-log command line argument
+
+#pragma once
+
+#include "EngineAPI.h"
+
+//C++ libraries
+#include <cstdarg>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+
+#include "util/types.h"
+
+namespace EngineLog
+{
+	enum class LogLevel : u8;
+
+	//Capture the arguments of a printf-style format into payload, without formatting them
+	//Integers are stored as varints, floating point as doubles, and strings by value (truncated if the payload runs out of space)
+	//Returns the length of the payload
+	std::size_t captureArguments(const char* format, va_list args, char* payload, std::size_t capacity);
+	//Format captured arguments with the format they were captured with, returns the length of the text (always null terminated)
+	std::size_t formatArguments(const char* format, const char* payload, std::size_t payloadLength, char* text, std::size_t capacity);
+
+	//Writes a binary log file, only ever used by one thread at a time (the log pipeline's background thread)
+	class BinaryLogWriter
+	{
+	public:
+		~BinaryLogWriter();
+
+		bool open(const std::string& filePath);
+		void close();
+		bool isOpen() const { return m_file != nullptr; }
+
+		//Format strings are interned by address, so a format must outlive the writer (string literals, as used by the SOL_LOG macros)
+		void writeMessage(const char* format, LogLevel level, u64 timestampNs, u32 threadID, const char* payload, std::size_t payloadLength);
+		void flush();
+
+	private:
+		FILE* m_file = nullptr;
+		std::unordered_map<const char*, u32> m_formatIDs;
+		u64 m_lastTimestampNs = 0;
+	};
+
+	//Decode a binary log written by the log pipeline into a text log, one message per line
+	ENGINE_API bool decodeBinaryLog(const std::string& binaryPath, const std::string& textPath);
+}
@@ -0,0 +1,76 @@
+//------- Debug Draw --------
+//Batched Debug Lines
+//For The Sol Core Engine
+//---------------------------
+
+//Accumulates debug lines (and shapes made of lines) from anywhere in the Engine or Editor into a single vertex stream
+//Owned by the Core and cleared at the end of every frame, the Render System draws everything accumulated with one draw call per frame
+//Positions are in pixels (the same space as TransformComponent positions), and colors are RGBA8, see DebugDraw::color
+//Only use from the main thread
+
+#pragma once
+
+#include "EngineAPI.h"
+
+//C++ libraries
+#include <vector>
+
+//External library GLM
+#include <glm/glm.hpp>
+
+#include "util/types.h"
+
+namespace EngineDebugDraw
+{
+	//What the Render System and the Physics Element draw into the debug draw, toggled by the Editor
+	enum DebugDrawFlags : u32
+	{
+		DRAW_COLLIDERS = 1 << 0, //Colliders whose Show Collision Box is ticked, drawn by the Render System
+		DRAW_PHYSICS_SHAPES = 1 << 1, //Every Box2D fixture
+		DRAW_PHYSICS_JOINTS = 1 << 2,
+		DRAW_PHYSICS_AABBS = 1 << 3, //Box2D broad-phase bounds
+		DRAW_PHYSICS_CENTRES_OF_MASS = 1 << 4,
+		DRAW_PHYSICS_CONTACTS = 1 << 5, //Contact points and normals of touching contacts
+		DRAW_PHYSICS = DRAW_PHYSICS_SHAPES | DRAW_PHYSICS_JOINTS | DRAW_PHYSICS_AABBS | DRAW_PHYSICS_CENTRES_OF_MASS | DRAW_PHYSICS_CONTACTS
+	};
+
+	//A line's end, two make a line
+	struct DebugVertex
+	{
+		glm::vec2 position;
+		u32 color;
+	};
+
+	class DebugDraw
+	{
+	public:
+		//Pack a color into RGBA8
+		ENGINE_API static u32 color(float r, float g, float b, float a = 1.0f);
+
+		ENGINE_API void line(const glm::vec2& from, const glm::vec2& to, u32 color);
+		//Closed outline through the vertices
+		ENGINE_API void polygon(const glm::vec2* vertices, int vertexCount, u32 color);
+		//Box about its centre, rotated by rotation (in radians)
+		ENGINE_API void box(const glm::vec2& centre, const glm::vec2& halfExtents, float rotation, u32 color);
+		//Axis-aligned box from its corners
+		ENGINE_API void aabb(const glm::vec2& min, const glm::vec2& max, u32 color);
+		ENGINE_API void circle(const glm::vec2& centre, float radius, u32 color);
+		//Small cross of size pixels
+		ENGINE_API void point(const glm::vec2& position, float size, u32 color);
+
+		//Remove every line, called by the Core at the end of every frame
+		void clear() { m_vertices.clear(); }
+
+		const std::vector<DebugVertex>& getVertices() const { return m_vertices; }
+		size_t getLineCount() const { return m_vertices.size() / 2; }
+
+		u32 getFlags() const { return m_flags; }
+		void setFlags(u32 flags) { m_flags = flags; }
+		bool isEnabled(u32 flag) const { return (m_flags & flag) != 0; }
+
+	private:
+		//Kept between frames, so once grown accumulating lines doesn't allocate
+		std::vector<DebugVertex> m_vertices;
+		u32 m_flags = DRAW_COLLIDERS;
+	};
+}
@@ -0,0 +1,72 @@
+//------- GPU Timer ---------
+//Per-Pass GPU Timings
+//For The Sol Core Engine
+//---------------------------
+
+//Times the game view's clear, sprite, debug line, and GUI passes on the GPU, owned by the Render Element
+//Each pass is a pair of GL_TIMESTAMP queries rather than a GL_TIME_ELAPSED query, so passes may be nested or overlap, which elapsed time queries can't
+//A frame's queries are read back GPU_TIMER_FRAMES frames later if the GPU has finished with them, otherwise that frame isn't timed, so nothing ever waits for the GPU
+//A frame runs from one beginFrame to the next, which is started with the game view so every pass of a frame is in the order the GPU runs them
+//Only use from the thread the OpenGL context is current on, apart from getLatestMs
+
+#pragma once
+
+//C++ libraries
+#include <atomic>
+
+//External library GLAD
+#include <glad.h>
+
+#include "util/Metrics.h"
+
+namespace EngineMetrics
+{
+	class GpuTimer
+	{
+	public:
+		GpuTimer();
+
+		//Frames of queries in flight, a frame's timings are read back as the frame GPU_TIMER_FRAMES frames after it begins
+		static const int GPU_TIMER_FRAMES = 3;
+
+		//Create and delete the queries, whilst the OpenGL context is current
+		void create();
+		void destroy();
+
+		//Finish the current frame and begin timing the next, first reading back the oldest frame if the GPU has finished with it
+		//tag is kept with the frame's timings and given back with them, e.g. the resolution the frame was rendered at
+		//Returns true if a frame was read back, its timings are then given by getLatestMs and its tag by getLatestTag
+		bool beginFrame(float tag = 0.0f);
+		//Time a pass, each pass is timed at most once per frame and not at all whilst the frame isn't being timed
+		void beginPass(GpuPass pass);
+		//Does nothing if the pass isn't being timed
+		void endPass(GpuPass pass);
+
+		//GPU time of a pass in the latest frame read back, 0 if the pass wasn't drawn in that frame
+		//Safe to call from any thread
+		float getLatestMs(GpuPass pass) const { return m_latestMs[static_cast<std::size_t>(pass)].load(std::memory_order_relaxed); }
+		float getLatestTag() const { return m_latestTag; }
+
+	private:
+		//Begin and end timestamps of each pass, and whether the pass was timed this frame
+		struct FrameQueries
+		{
+			GLuint begin[GPU_PASS_COUNT] = {};
+			GLuint end[GPU_PASS_COUNT] = {};
+			bool timed[GPU_PASS_COUNT] = {};
+			bool pending = false; //Waiting to be read back
+			float tag = 0.0f;
+		};
+		//Read back a pending frame's timings if every query is available, returning false without waiting otherwise
+		bool readBack(FrameQueries& frame);
+
+		FrameQueries m_frames[GPU_TIMER_FRAMES];
+		int m_frameIndex = 0;
+		bool m_frameActive = false; //Whether the frame at m_frameIndex is being timed
+		bool m_passOpen[GPU_PASS_COUNT] = {};
+		bool m_created = false;
+
+		std::atomic<float> m_latestMs[GPU_PASS_COUNT];
+		float m_latestTag = 0.0f;
+	};
+}
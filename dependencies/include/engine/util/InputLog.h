@@ -0,0 +1,85 @@
+//------- Input Log ---------
+//Input Recording And Replay
+//For The Sol Core Engine
+//---------------------------
+
+//A compact binary log of the input fed to the simulation on each fixed timestep tick
+//Used by the Core to record sessions and replay them deterministically (optionally headless and at maximum speed)
+//
+//File layout, all integers little-endian, "varint" being LEB128 (7 bits per byte, high bit set if more bytes follow):
+//	Header:	"SOLINPUT" | u32 version | f64 fixed timestep | varint length + bytes of the initial scene path
+//	Records: varint ticks since the previous record | u8 flags | [varint length + bytes of the loaded scene path] | varint event count | events
+//	Events:	u8 type | varint zigzag keycode | varint scancode | u16 key modifiers | u8 repeat
+//Ticks with no input and no state change write no record at all, and the log always ends with a record flagged END
+
+#pragma once
+
+//C++ libraries
+#include <cstdio>
+#include <string>
+#include <vector>
+
+//External library SDL2
+#include <SDL.h>
+
+#include "util/types.h"
+
+namespace EngineReplay
+{
+	//Record flags
+	const u8 INPUT_RECORD_SCENE_RUNNING = 1 << 0; //The ECS's scene was running (i.e. fixed updates were executed) on this tick
+	const u8 INPUT_RECORD_SCENE_LOADED = 1 << 1; //A scene was (re)loaded before this tick, the record holds its path
+	const u8 INPUT_RECORD_END = 1 << 2; //Last record of the log, marks the tick the recording stopped on
+
+	//The input and state changes for one fixed timestep tick
+	struct InputRecord
+	{
+		u64 tick = 0; //Tick number counted from the start of the recording
+		u8 flags = 0;
+		std::string loadedScene;
+		std::vector<SDL_Event> events;
+	};
+
+	class InputLogWriter
+	{
+	public:
+		~InputLogWriter();
+
+		//Begin a new log, overwriting any existing file
+		bool open(const std::string& filePath, const std::string& initialScene, double fixedTimestep);
+		bool isOpen() const { return m_file != nullptr; }
+
+		//Write a tick's record, nothing is written for ticks with no input and no state change
+		void writeTick(u64 tick, bool sceneRunning, const std::string& loadedScene, const std::vector<SDL_Event>& events);
+
+		//Write the END record and close the file
+		void close(u64 finalTick);
+
+	private:
+		FILE* m_file = nullptr;
+		u64 m_lastRecordTick = 0;
+		bool m_lastSceneRunning = false;
+	};
+
+	class InputLogReader
+	{
+	public:
+		~InputLogReader();
+
+		bool open(const std::string& filePath);
+		bool isOpen() const { return m_file != nullptr; }
+		void close();
+
+		const std::string& getInitialScene() const { return m_initialScene; }
+		double getFixedTimestep() const { return m_fixedTimestep; }
+
+		//Read the next record, returns false at the end of the log or if the log is corrupt
+		bool readRecord(InputRecord& record);
+
+	private:
+		FILE* m_file = nullptr;
+		std::string m_initialScene;
+		double m_fixedTimestep = 0.0;
+		u64 m_lastRecordTick = 0;
+	};
+}
@@ -0,0 +1,114 @@
+//------- Log ---------------
+//Asynchronous Log Pipeline
+//For The Sol Core Engine
+//---------------------------
+
+//Every log message in the Engine goes through the SOL_LOG macros, which format straight into a preallocated per-thread ring buffer
+//A background thread drains every thread's buffer (in timestamp order) to the sink, which the Log Element sets to its log file
+//Logging never blocks and never allocates on the calling thread: a full buffer drops the message (dropped messages are counted and reported)
+//A message longer than one record continues over consecutive records (e.g. a shader's info log), and is written to the sink whole
+//Levels below SOL_LOG_LEVEL compile out entirely, and the _EVERY variants rate limit a call site, e.g. for errors inside the main loop
+//Until a sink is started (or after it is stopped), messages are written straight to the console instead
+//For long runs, startBinary writes a structured binary log instead (see util/BinaryLog.h): messages aren't formatted at all,
+//each format string is written once and every message only stores its arguments, a timestamp, and the ID of the thread that logged it
+
+#pragma once
+
+#include "EngineAPI.h"
+
+//C++ libraries
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include "util/types.h"
+
+//Compile-time level filter, messages of a lower level than this compile out
+#define SOL_LOG_LEVEL_TRACE 0
+#define SOL_LOG_LEVEL_INFO 1
+#define SOL_LOG_LEVEL_WARN 2
+#define SOL_LOG_LEVEL_ERROR 3
+#ifndef SOL_LOG_LEVEL
+#define SOL_LOG_LEVEL SOL_LOG_LEVEL_INFO
+#endif
+
+namespace EngineLog
+{
+	enum class LogLevel : u8
+	{
+		Trace = SOL_LOG_LEVEL_TRACE,
+		Info = SOL_LOG_LEVEL_INFO,
+		Warn = SOL_LOG_LEVEL_WARN,
+		Error = SOL_LOG_LEVEL_ERROR
+	};
+
+	//Size of one record in a thread's ring buffer, longer messages take as many consecutive records as they need
+	const std::size_t LOG_MESSAGE_SIZE = 240;
+	//Longest message, anything longer is cut short and ends with LOG_TRUNCATED_MARKER so the cut is visible in the log
+	const std::size_t LOG_MAX_MESSAGE_SIZE = 4096;
+	const char* const LOG_TRUNCATED_MARKER = " [Truncated]";
+	//Messages each thread's ring buffer holds before messages are dropped
+	const std::size_t LOG_THREAD_BUFFER_MESSAGES = 1024;
+
+	//Writes a message to its destination, called only on the background thread
+	//timestampNs is nanoseconds since the system clock's epoch, taken when the message was logged
+	using LogSink = std::function<void(LogLevel level, u64 timestampNs, const char* message, std::size_t length)>;
+
+	class Logger
+	{
+	public:
+		//Format a printf-style message into the calling thread's ring buffer, use the SOL_LOG macros rather than calling this directly
+		ENGINE_API static void write(LogLevel level, const char* format, ...);
+
+		//Start the background thread draining messages to sink, replacing any sink already started
+		ENGINE_API static void start(LogSink sink);
+		//Start the background thread draining messages to a binary log file, replacing any sink already started
+		//Messages are captured unformatted from now on, returns false if the file can't be opened
+		ENGINE_API static bool startBinary(const std::string& filePath);
+		//Drain every message logged so far, stop the background thread, and return to writing to the console
+		ENGINE_API static void stop();
+		//Block until every message logged so far has been written to the sink
+		ENGINE_API static void flush();
+
+		//Total messages dropped because a thread's ring buffer was full
+		ENGINE_API static u64 getDroppedCount();
+
+		//Rate limiting for a call site, true if at least intervalMs has passed since lastNs (which is then updated)
+		ENGINE_API static bool shouldLog(std::atomic<u64>& lastNs, u32 intervalMs);
+	};
+}
+
+//Log at a level, printf-style
+//e.g. SOL_LOG_ERROR("[Resource] Failed to Load New Image: %s", filePath.c_str());
+#define SOL_LOG_AT(level, ...) EngineLog::Logger::write(level, __VA_ARGS__)
+//Log at a level at most once every intervalMs from this call site
+#define SOL_LOG_AT_EVERY(intervalMs, level, ...) do { static std::atomic<u64> solLogLastNs{ 0 }; \
+	if (EngineLog::Logger::shouldLog(solLogLastNs, intervalMs)) { EngineLog::Logger::write(level, __VA_ARGS__); } } while (0)
+
+#if SOL_LOG_LEVEL <= SOL_LOG_LEVEL_TRACE
+	#define SOL_LOG_TRACE(...) SOL_LOG_AT(EngineLog::LogLevel::Trace, __VA_ARGS__)
+	#define SOL_LOG_TRACE_EVERY(intervalMs, ...) SOL_LOG_AT_EVERY(intervalMs, EngineLog::LogLevel::Trace, __VA_ARGS__)
+#else
+	#define SOL_LOG_TRACE(...) ((void)0)
+	#define SOL_LOG_TRACE_EVERY(intervalMs, ...) ((void)0)
+#endif
+
+#if SOL_LOG_LEVEL <= SOL_LOG_LEVEL_INFO
+	#define SOL_LOG_INFO(...) SOL_LOG_AT(EngineLog::LogLevel::Info, __VA_ARGS__)
+	#define SOL_LOG_INFO_EVERY(intervalMs, ...) SOL_LOG_AT_EVERY(intervalMs, EngineLog::LogLevel::Info, __VA_ARGS__)
+#else
+	#define SOL_LOG_INFO(...) ((void)0)
+	#define SOL_LOG_INFO_EVERY(intervalMs, ...) ((void)0)
+#endif
+
+#if SOL_LOG_LEVEL <= SOL_LOG_LEVEL_WARN
+	#define SOL_LOG_WARN(...) SOL_LOG_AT(EngineLog::LogLevel::Warn, __VA_ARGS__)
+	#define SOL_LOG_WARN_EVERY(intervalMs, ...) SOL_LOG_AT_EVERY(intervalMs, EngineLog::LogLevel::Warn, __VA_ARGS__)
+#else
+	#define SOL_LOG_WARN(...) ((void)0)
+	#define SOL_LOG_WARN_EVERY(intervalMs, ...) ((void)0)
+#endif
+
+#define SOL_LOG_ERROR(...) SOL_LOG_AT(EngineLog::LogLevel::Error, __VA_ARGS__)
+#define SOL_LOG_ERROR_EVERY(intervalMs, ...) SOL_LOG_AT_EVERY(intervalMs, EngineLog::LogLevel::Error, __VA_ARGS__)
@@ -0,0 +1,93 @@
+//------- Memory Tracker ----
+//Heap Allocation Tracking
+//For The Sol Core Engine
+//---------------------------
+
+//The Engine replaces the global operator new/delete so that every heap allocation made by Engine code is counted
+//Counting is a few relaxed atomic operations, cheap enough to leave on permanently
+//Note that on Windows each DLL/EXE has its own operator new, so allocations made by the Editor itself are not counted
+
+//Allocations are also attributed to a tag (an Element or subsystem), so current usage, peak usage, and allocation rate can be budgeted per tag
+//The tag is whichever SOL_MEMORY_TAG scope is innermost on the allocating thread, e.g. the Core tags each Element's initialization and update
+//Dear ImGui's allocator and stb_image's allocator are routed here explicitly, tagged Gui and Resource
+//Box2D allocates through b2Alloc inside the prebuilt box2d.lib, so Box2D's own allocations are not tracked, only the Engine's allocations for physics
+
+#pragma once
+
+#include "EngineAPI.h"
+
+//C++ libraries
+#include <cstddef>
+
+#include "util/types.h"
+
+namespace EngineMemory
+{
+	enum class MemoryTag : u8
+	{
+		Untagged = 0,
+		Core,
+		Log,
+		Render,
+		Gui,
+		Physics,
+		Event,
+		Resource,
+		Shader,
+		Ecs,
+		Scene,
+		Count
+	};
+	const std::size_t MEMORY_TAG_COUNT = static_cast<std::size_t>(MemoryTag::Count);
+
+	struct MemoryTagStats
+	{
+		u64 currentBytes = 0; //Bytes currently allocated
+		u64 peakBytes = 0; //Most bytes allocated at once
+		u64 allocationCount = 0; //Allocations made since startup
+		u64 freeCount = 0; //Frees made since startup
+	};
+
+	//Static interface to the Memory Tracker, in the same manner as ApplicationConfig::Config
+	class MemoryTracker
+	{
+	public:
+		//Total number of allocations/frees made through the Engine's operator new/delete since startup, only counting frees of tracked memory
+		ENGINE_API static u64 getAllocationCount();
+		ENGINE_API static u64 getFreeCount();
+
+		//Usage of a tag
+		//Tracked blocks carry a marker, so freeing memory allocated by another module (e.g. the Editor) through the Engine isn't counted at all
+		//rather than being charged to a tag that never counted it
+		ENGINE_API static MemoryTagStats getTagStats(MemoryTag tag);
+		ENGINE_API static const char* getTagName(MemoryTag tag);
+
+		//The tag allocations on the calling thread are currently attributed to
+		ENGINE_API static MemoryTag getCurrentTag();
+		ENGINE_API static void setCurrentTag(MemoryTag tag);
+
+		//Tracked allocation for libraries with their own allocator hooks (e.g. Dear ImGui and stb_image)
+		//Memory from allocate/reallocate must be freed with free, and may also be freed with operator delete
+		ENGINE_API static void* allocate(std::size_t size, MemoryTag tag);
+		ENGINE_API static void* reallocate(void* ptr, std::size_t size, MemoryTag tag);
+		ENGINE_API static void free(void* ptr);
+	};
+
+	//Attributes allocations on this thread to a tag until the end of the scope
+	class MemoryTagScope
+	{
+	public:
+		explicit MemoryTagScope(MemoryTag tag) : m_previous(MemoryTracker::getCurrentTag()) { MemoryTracker::setCurrentTag(tag); }
+		~MemoryTagScope() { MemoryTracker::setCurrentTag(m_previous); }
+		MemoryTagScope(const MemoryTagScope&) = delete;
+		MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+	private:
+		MemoryTag m_previous;
+	};
+}
+
+#define SOL_MEMORY_TAG_CONCAT_INNER(a, b) a##b
+#define SOL_MEMORY_TAG_CONCAT(a, b) SOL_MEMORY_TAG_CONCAT_INNER(a, b)
+//Attribute allocations on this thread to a tag until the end of the scope, e.g. SOL_MEMORY_TAG(EngineMemory::MemoryTag::Scene);
+#define SOL_MEMORY_TAG(tag) EngineMemory::MemoryTagScope SOL_MEMORY_TAG_CONCAT(solMemoryTagScope, __LINE__)(tag)
@@ -0,0 +1,129 @@
+//------- Metrics -----------
+//Per-Frame Performance Metrics
+//For The Sol Core Engine
+//---------------------------
+
+//Owned by the Core and filled in by the Core, the ECS Element, and the Systems
+//Every history is a fixed-size RingBuffer so that recording and displaying metrics costs almost nothing
+//Displayed by the Editor's Performance viewport
+//Everything the Editor reads is inline, so nothing here needs exporting from the Engine DLL
+
+#pragma once
+
+//C++ libraries
+#include <string>
+#include <vector>
+
+#include "util/types.h"
+#include "util/RingBuffer.h"
+#include "util/MemoryTracker.h"
+
+namespace EngineMetrics
+{
+	//Number of frames (or fixed ticks) of history kept, 4 seconds at 60 frames per second
+	const std::size_t HISTORY_LENGTH = 240;
+
+	using History = RingBuffer<float, HISTORY_LENGTH>;
+
+	//Passes timed on the GPU by the Render Element's GPU timer (see util/GpuTimer.h)
+	//The clear, sprite, and debug line passes render the game view, the GUI is drawn after it
+	//Each pass brackets only its own GPU work, so none of them include the CPU work between them (e.g. the simulation when there is no render thread)
+	enum class GpuPass
+	{
+		Clear,
+		Sprites,
+		DebugLines,
+		Gui
+	};
+	const std::size_t GPU_PASS_COUNT = 4;
+
+	inline const char* getGpuPassName(GpuPass pass)
+	{
+		switch (pass)
+		{
+		case GpuPass::Clear: return "Clear";
+		case GpuPass::Sprites: return "Sprites";
+		case GpuPass::DebugLines: return "Debug Lines";
+		case GpuPass::Gui: return "GUI";
+		}
+		return "Unknown";
+	}
+
+	//Counters accumulated over the current frame, reset by the Core at the start of every frame
+	struct FrameCounters
+	{
+		u32 drawCalls = 0; //Every draw call issued by the Render System
+		u32 instancedDrawCalls = 0; //Draw calls that rendered a batch via instancing
+		u32 singleDrawCalls = 0; //Draw calls that rendered a single sprite
+		u32 spritesSubmitted = 0; //Sprites submitted for rendering
+		u32 spritesCulled = 0; //Sprites not submitted because they were outside the camera's view
+		u32 staticChunksDrawn = 0; //Chunks of retained static sprites inside the camera's view
+		u32 staticChunksRebuilt = 0; //Chunks of retained static sprites rebuilt because one of their sprites changed
+		u32 debugLines = 0; //Lines in the debug draw, all drawn with one draw call
+		u32 glCallsIssued = 0; //OpenGL state changes the Render System's state cache issued to the driver
+		u32 glCallsSkipped = 0; //OpenGL state changes the Render System's state cache skipped as redundant
+		u32 instanceBufferBytes = 0; //Bytes of sprite instances the Render System wrote to its instance buffer
+		u32 instanceBufferPeakBytes = 0; //Most bytes of sprite instances written in any frame so far
+		u32 instanceBufferAllocatedBytes = 0; //Size of the instance buffer, which grows with the peak
+		u32 frameArenaBytes = 0; //Bytes allocated from the Core's frame arena
+		u32 tickArenaBytes = 0; //Most bytes allocated from the Core's tick arena in any one tick
+		float gpuPassMs[GPU_PASS_COUNT] = {}; //GPU time of each pass in the latest frame read back from the GPU, a few frames old, 0 if the pass wasn't drawn
+	};
+
+	//Cost history of one registered System
+	struct SystemMetrics
+	{
+		std::string name;
+		History updateMs;
+		History fixedUpdateMs;
+	};
+
+	class Metrics
+	{
+	public:
+		//Reset the frame counters and take a snapshot of the allocation counts
+		void beginFrame();
+		//Push this frame's counters and timings into the histories
+		void endFrame(double frameTimeMs);
+
+		//Record the time taken by one fixed timestep tick
+		void recordFixedTick(double tickTimeMs);
+		//Record how far a frame capped by the frame limiter was from the target frame time (absolute, in ms)
+		void recordPacingError(double pacingErrorMs);
+
+		//Register a System by name, returns the index to record its costs with
+		std::size_t registerSystem(const std::string& name);
+		void recordSystemUpdate(std::size_t systemIndex, double updateMs);
+		void recordSystemFixedUpdate(std::size_t systemIndex, double fixedUpdateMs);
+
+		//Counters for the frame currently being built, for Systems to increment
+		FrameCounters& currentFrame() { return m_currentFrame; }
+		//Counters of the last completed frame, stable for the whole of the next frame
+		const FrameCounters& lastFrame() const { return m_lastFrame; }
+
+		const History& frameTimeMs() const { return m_frameTimeMs; }
+		const History& fixedTickMs() const { return m_fixedTickMs; }
+		const History& pacingErrorMs() const { return m_pacingErrorMs; }
+		const History& drawCalls() const { return m_drawCalls; }
+		const History& gpuPassMs(GpuPass pass) const { return m_gpuPassMs[static_cast<std::size_t>(pass)]; }
+		const History& allocationsPerFrame() const { return m_allocationsPerFrame; }
+		const History& allocationsPerFrame(EngineMemory::MemoryTag tag) const { return m_tagAllocationsPerFrame[static_cast<std::size_t>(tag)]; }
+		const std::vector<SystemMetrics>& systems() const { return m_systems; }
+
+	private:
+		FrameCounters m_currentFrame;
+		FrameCounters m_lastFrame;
+		u64 m_allocationsAtFrameStart = 0;
+		u64 m_tagAllocationsAtFrameStart[EngineMemory::MEMORY_TAG_COUNT] = {};
+
+		History m_frameTimeMs;
+		History m_fixedTickMs;
+		History m_pacingErrorMs;
+		History m_drawCalls;
+		History m_gpuPassMs[GPU_PASS_COUNT];
+		History m_allocationsPerFrame;
+		History m_tagAllocationsPerFrame[EngineMemory::MEMORY_TAG_COUNT];
+
+		std::vector<SystemMetrics> m_systems;
+	};
+}
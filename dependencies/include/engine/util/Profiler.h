@@ -0,0 +1,91 @@
+//------- Profiler ----------
+//Frame Instrumentation
+//For The Sol Core Engine
+//---------------------------
+
+//Scoped instrumentation zones that record into per-thread lock-free ring buffers with nanosecond timestamps
+//Buffers can be dumped on demand to a Chrome/Perfetto JSON trace file (open with chrome://tracing or ui.perfetto.dev)
+//Zones are compiled out entirely unless SOL_ENABLE_PROFILER is defined, and when compiled in they only record whilst the Profiler is enabled
+
+#pragma once
+
+#include "EngineAPI.h"
+
+//C++ libraries
+#include <string>
+
+#include "util/types.h"
+
+//Zone macros, use these rather than ScopedZone directly so that zones compile out when profiling is not wanted
+//Zone names must be string literals (or otherwise outlive the Profiler) since only the pointer is recorded
+#ifdef SOL_ENABLE_PROFILER
+	#define SOL_PROFILE_CONCAT_INNER(a, b) a##b
+	#define SOL_PROFILE_CONCAT(a, b) SOL_PROFILE_CONCAT_INNER(a, b)
+	#define SOL_PROFILE_ZONE(name) EngineProfiler::ScopedZone SOL_PROFILE_CONCAT(solProfileZone, __LINE__)(name)
+	#define SOL_PROFILE_FUNCTION() SOL_PROFILE_ZONE(__FUNCTION__)
+	//Record a zone timed by hand, e.g. one whose name is only known at runtime (see Profiler::internName)
+	#define SOL_PROFILE_RECORD_ZONE(name, startNs, endNs) EngineProfiler::Profiler::recordZone(name, startNs, endNs)
+#else
+	#define SOL_PROFILE_ZONE(name) ((void)0)
+	#define SOL_PROFILE_FUNCTION() ((void)0)
+	#define SOL_PROFILE_RECORD_ZONE(name, startNs, endNs) ((void)0)
+#endif
+
+namespace EngineProfiler
+{
+	//A single completed zone, stored by value in a thread's ring buffer
+	struct ZoneEvent
+	{
+		const char* name;
+		u64 startNs;
+		u64 endNs;
+	};
+
+	//Static interface to the Profiler, in the same manner as ApplicationConfig::Config
+	class Profiler
+	{
+	public:
+		//Number of zones each thread's ring buffer can hold before the oldest zones are overwritten
+		//At a few dozen zones per frame this holds well over half a minute of history
+		static const u32 THREAD_BUFFER_CAPACITY = 1u << 16;
+
+		//Start or stop recording zones, recording is off by default
+		ENGINE_API static void setEnabled(bool enabled);
+		ENGINE_API static bool isEnabled();
+
+		//Name the calling thread in exported traces, e.g. "Main"
+		ENGINE_API static void setThreadName(const char* threadName);
+
+		//Nanoseconds since an arbitrary fixed point, monotonic
+		ENGINE_API static u64 now();
+
+		//Record a completed zone into the calling thread's ring buffer
+		ENGINE_API static void recordZone(const char* name, u64 startNs, u64 endNs);
+
+		//A copy of name that lives as long as the process, for zone names built at runtime
+		//Each distinct name is copied once, so only use it for names from a small set (e.g. Element names), not per-frame strings
+		ENGINE_API static const char* internName(const std::string& name);
+
+		//Write every buffered zone to a Chrome/Perfetto JSON trace file
+		//If lastSeconds is greater than 0, only zones that ended within that many seconds of now are written
+		ENGINE_API static bool dumpChromeTrace(const std::string& filePath, double lastSeconds = 0.0);
+
+		//Discard all buffered zones on every thread
+		ENGINE_API static void clear();
+	};
+
+	//RAII zone, records the time between construction and destruction under the given name
+	class ScopedZone
+	{
+	public:
+		ENGINE_API explicit ScopedZone(const char* name);
+		ENGINE_API ~ScopedZone();
+
+		ScopedZone(const ScopedZone&) = delete;
+		ScopedZone& operator=(const ScopedZone&) = delete;
+
+	private:
+		const char* m_name; //nullptr if the Profiler was disabled when this zone opened
+		u64 m_startNs;
+	};
+}
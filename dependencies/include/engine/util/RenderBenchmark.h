@@ -0,0 +1,42 @@
+//------- Render Benchmark --
+//Sprite Submission Benchmark
+//For The Sol Core Engine
+//---------------------------
+
+//Measures how fast the Render System culls, sorts, batches, and packs sprites into command lists, without a window or a GPU
+//A headless Core runs only the ECS Element's Render System, replaying every command list with the null render device (see systems/NullRenderDevice.h)
+//so the timings are the CPU side of rendering alone, and any invalid command the Render System records is caught
+//Run through the Editor's --render-benchmark command line argument
+
+#pragma once
+
+#include "EngineAPI.h"
+
+//C++ libraries
+#include <string>
+#include <vector>
+
+#include "util/types.h"
+
+namespace EngineBenchmark
+{
+	//Timings and counters of one sprite count, counters are those of the last frame
+	struct SpriteBenchmarkResult
+	{
+		u32 sprites = 0;
+		u32 frames = 0;
+		double firstFrameMs = 0.0; //Gathering the sprites and building the static chunks, which only happens when the ECS's structure changes
+		double msPerFrame = 0.0; //Mean of every frame after the first
+		double spritesPerSecond = 0.0; //Sprites considered (culled or submitted) per second
+		u32 spritesSubmitted = 0;
+		u32 spritesCulled = 0;
+		u32 drawCalls = 0;
+		u64 invalidCalls = 0; //Calls the null device found invalid, over every frame
+	};
+
+	//Time frames frames at each sprite count (counts in ascending order, sprites are added to reach each)
+	//A quarter of the sprites are static, the rest are dynamic and move every frame, all spread over four times the screen's area
+	//If commandStreamPath isn't empty, every command list is also written to it as text (see systems/RecordingRenderDevice.h), which slows the frames down
+	//Each result is logged, returns false if the headless Core couldn't be initialized
+	ENGINE_API bool runSpriteBenchmark(const std::vector<u32>& spriteCounts, u32 frames, const std::string& commandStreamPath, std::vector<SpriteBenchmarkResult>& results);
+}
@@ -0,0 +1,76 @@
+//------- Ring Buffer -------
+//Fixed-Size History Storage
+//For The Sol Core Engine
+//---------------------------
+
+//A fixed-capacity ring buffer that never allocates after construction
+//Once full, pushing overwrites the oldest value
+//Storage is a plain contiguous array so it can be handed straight to ImGui's PlotLines/PlotHistogram (using offset() as values_offset)
+
+#pragma once
+
+//C++ libraries
+#include <cstddef>
+
+namespace EngineMetrics
+{
+	template<typename T, std::size_t N>
+	class RingBuffer
+	{
+	public:
+		//Add a value, overwriting the oldest value if the buffer is full
+		void push(const T& value)
+		{
+			m_values[m_next] = value;
+			m_next = (m_next + 1) % N;
+			if (m_count < N)
+			{
+				m_count++;
+			}
+		}
+
+		//Remove all values, storage is kept
+		void clear()
+		{
+			m_next = 0;
+			m_count = 0;
+		}
+
+		std::size_t size() const { return m_count; }
+		std::size_t capacity() const { return N; }
+		bool empty() const { return m_count == 0; }
+
+		//Raw storage, valid indices are [0, size())
+		const T* data() const { return m_values; }
+
+		//Index into data() of the oldest value
+		std::size_t offset() const { return m_count < N ? 0 : m_next; }
+
+		//Value by age where 0 is the oldest and size() - 1 is the newest
+		const T& operator[](std::size_t i) const { return m_values[(offset() + i) % N]; }
+
+		//Most recently pushed value, or a default value if empty
+		T latest() const { return m_count ? m_values[(m_next + N - 1) % N] : T(); }
+
+		T average() const
+		{
+			if (!m_count) { return T(); }
+			T sum = T();
+			for (std::size_t i = 0; i < m_count; i++) { sum += m_values[i]; }
+			return sum / static_cast<T>(m_count);
+		}
+
+		T max() const
+		{
+			if (!m_count) { return T(); }
+			T highest = m_values[0];
+			for (std::size_t i = 1; i < m_count; i++) { if (m_values[i] > highest) { highest = m_values[i]; } }
+			return highest;
+		}
+
+	private:
+		T m_values[N] = {};
+		std::size_t m_next = 0; //Index the next push writes to
+		std::size_t m_count = 0;
+	};
+}